@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "CPUProfileTest.h"
+
+#include "APICast.h"
+#include "InitializeThreading.h"
+#include "JSCInlines.h"
+#include "JavaScript.h"
+#include "Options.h"
+#include "SamplingProfiler.h"
+#include <wtf/StringPrintStream.h>
+#include <wtf/text/StringBuilder.h>
+
+using namespace JSC;
+
+#if ENABLE(SAMPLING_PROFILER)
+
+// hot starts on the second line, so its zero-based lineNumber is 1.
+static const char* workloadScript =
+    "function caller() { var result = 0; for (var i = 0; i < 10; ++i) result += hot(10000); return result; }\n"
+    "function hot(n) { var result = 0; for (var i = 0; i < n; ++i) result += i * i % 7; return result; }\n"
+    "var start = Date.now();\n"
+    "while (Date.now() - start < 300)\n"
+    "    caller();\n"
+    "true";
+
+// Checks profileText against the parts of the .cpuprofile format that viewers rely on, and
+// returns the first thing that is wrong, or the empty string.
+static const char* checkScript =
+    "(function () {"
+    "    var profile = JSON.parse(profileText);"
+    "    if (!Array.isArray(profile.nodes) || !Array.isArray(profile.samples) || !Array.isArray(profile.timeDeltas))"
+    "        return 'missing nodes, samples or timeDeltas';"
+    "    if (typeof profile.startTime !== 'number' || typeof profile.endTime !== 'number' || profile.endTime < profile.startTime)"
+    "        return 'bad startTime or endTime';"
+    "    if (!profile.samples.length || profile.samples.length !== profile.timeDeltas.length)"
+    "        return 'samples and timeDeltas do not match';"
+    "    var deltaSum = 0;"
+    "    for (var delta of profile.timeDeltas) {"
+    "        if (delta < 0)"
+    "            return 'negative timeDelta';"
+    "        deltaSum += delta;"
+    "    }"
+    "    if (deltaSum !== profile.endTime - profile.startTime)"
+    "        return 'timeDeltas do not add up to endTime - startTime';"
+    ""
+    "    var nodesById = new Map;"
+    "    var parents = new Map;"
+    "    var tiers = ['LLInt', 'Baseline', 'DFG', 'FTL', 'Host', 'Wasm', 'C', 'Unknown'];"
+    "    for (var node of profile.nodes) {"
+    "        if (typeof node.id !== 'number' || nodesById.has(node.id))"
+    "            return 'missing or duplicate node id';"
+    "        nodesById.set(node.id, node);"
+    "        var frame = node.callFrame;"
+    "        if (!frame || typeof frame.functionName !== 'string' || typeof frame.scriptId !== 'string' || typeof frame.url !== 'string'"
+    "            || typeof frame.lineNumber !== 'number' || typeof frame.columnNumber !== 'number')"
+    "            return 'bad callFrame for node ' + node.id;"
+    "        if (typeof node.hitCount !== 'number' || node.hitCount < 0)"
+    "            return 'bad hitCount for node ' + node.id;"
+    "        if (node !== profile.nodes[0] && tiers.indexOf(node.tier) < 0)"
+    "            return 'bad tier ' + node.tier + ' for node ' + node.id;"
+    "        var lineTicks = 0;"
+    "        for (var tick of node.positionTicks || []) {"
+    "            if (typeof tick.line !== 'number' || !(tick.ticks > 0))"
+    "                return 'bad positionTicks for node ' + node.id;"
+    "            lineTicks += tick.ticks;"
+    "        }"
+    "        if (lineTicks > node.hitCount)"
+    "            return 'more positionTicks than hits for node ' + node.id;"
+    "        for (var child of node.children || []) {"
+    "            if (parents.has(child))"
+    "                return 'node ' + child + ' has two parents';"
+    "            parents.set(child, node);"
+    "        }"
+    "    }"
+    "    var root = profile.nodes[0];"
+    "    if (root.callFrame.functionName !== '(root)' || parents.has(root.id))"
+    "        return 'the first node is not the root';"
+    "    for (var id of parents.keys()) {"
+    "        if (!nodesById.has(id))"
+    "            return 'child ' + id + ' does not exist';"
+    "    }"
+    "    if (parents.size !== profile.nodes.length - 1)"
+    "        return 'a node other than the root has no parent';"
+    ""
+    "    var hitCount = 0;"
+    "    for (var node of profile.nodes)"
+    "        hitCount += node.hitCount;"
+    "    if (hitCount !== profile.samples.length)"
+    "        return 'hitCounts do not add up to the number of samples';"
+    "    for (var sample of profile.samples) {"
+    "        if (!nodesById.has(sample))"
+    "            return 'sample ' + sample + ' does not exist';"
+    "    }"
+    ""
+    "    var hotUnderCaller = profile.nodes.some(function (node) {"
+    "        var parent = parents.get(node.id);"
+    "        return node.callFrame.functionName === 'hot' && node.callFrame.url === 'cpuprofile-test.js'"
+    "            && node.callFrame.lineNumber === 1 && node.hitCount > 0"
+    "            && parent && parent.callFrame.functionName === 'caller' && parent.callFrame.lineNumber === 0;"
+    "    });"
+    "    if (!hotUnderCaller)"
+    "        return 'no samples of hot called from caller';"
+    "    return '';"
+    "})()";
+
+static JSValueRef evaluate(JSGlobalContextRef context, const char* source, const char* url = nullptr)
+{
+    JSStringRef script = JSStringCreateWithUTF8CString(source);
+    JSStringRef sourceURL = url ? JSStringCreateWithUTF8CString(url) : nullptr;
+    JSValueRef exception = nullptr;
+    JSValueRef result = JSEvaluateScript(context, script, nullptr, sourceURL, 1, &exception);
+    if (sourceURL)
+        JSStringRelease(sourceURL);
+    JSStringRelease(script);
+    return exception ? nullptr : result;
+}
+
+#endif // ENABLE(SAMPLING_PROFILER)
+
+int testCPUProfile()
+{
+    bool failed = false;
+
+    JSC::initializeThreading();
+    Options::initialize(); // Ensure options is initialized first.
+
+    StringBuilder savedOptionsBuilder;
+    Options::dumpAllOptionsInALine(savedOptionsBuilder);
+
+    // Record JIT tiers and code locations the way --cpuprofile does.
+    Options::setOptions("--samplingProfilerCPUProfile=true");
+
+#if ENABLE(SAMPLING_PROFILER)
+    JSGlobalContextRef context = JSGlobalContextCreateInGroup(nullptr, nullptr);
+    String profile;
+    {
+        VM& vm = toJS(context)->vm();
+        JSLockHolder locker(vm);
+        SamplingProfiler& samplingProfiler = vm.ensureSamplingProfiler(WTF::Stopwatch::create());
+        samplingProfiler.noticeCurrentThreadAsJSCExecutionThread();
+        samplingProfiler.start();
+
+        if (!evaluate(context, workloadScript, "cpuprofile-test.js")) {
+            printf("FAIL: CPU profile test workload threw.\n");
+            failed = true;
+        }
+
+        StringPrintStream stream;
+        samplingProfiler.reportCPUProfile(stream);
+        profile = stream.toString();
+    }
+
+    if (!failed) {
+        JSStringRef profileName = JSStringCreateWithUTF8CString("profileText");
+        JSStringRef profileText = JSStringCreateWithUTF8CString(profile.utf8().data());
+        JSObjectSetProperty(context, JSContextGetGlobalObject(context), profileName, JSValueMakeString(context, profileText), kJSPropertyAttributeNone, nullptr);
+        JSStringRelease(profileText);
+        JSStringRelease(profileName);
+
+        JSValueRef result = evaluate(context, checkScript);
+        if (!result || !JSValueIsString(context, result)) {
+            printf("FAIL: The CPU profile is not valid JSON.\n");
+            failed = true;
+        } else {
+            JSStringRef problem = JSValueToStringCopy(context, result, nullptr);
+            size_t length = JSStringGetMaximumUTF8CStringSize(problem);
+            Vector<char> buffer(length);
+            JSStringGetUTF8CString(problem, buffer.data(), length);
+            JSStringRelease(problem);
+            if (buffer[0]) {
+                printf("FAIL: The CPU profile is malformed: %s.\n", buffer.data());
+                failed = true;
+            }
+        }
+    }
+
+    if (!failed)
+        printf("PASS: The CPU profile has the .cpuprofile shape.\n");
+
+    JSGlobalContextRelease(context);
+#else
+    printf("PASS: CPU profile test skipped, the sampling profiler is not enabled.\n");
+#endif
+
+    Options::setOptions(savedOptionsBuilder.toString().ascii().data());
+
+    return failed;
+}
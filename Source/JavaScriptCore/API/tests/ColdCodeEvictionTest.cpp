@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ColdCodeEvictionTest.h"
+
+#include "APICast.h"
+#include "FunctionCodeBlock.h"
+#include "InitializeThreading.h"
+#include "JSCInlines.h"
+#include "JavaScript.h"
+#include "Options.h"
+#include <wtf/text/StringBuilder.h>
+
+using namespace JSC;
+
+static const char* compileScript =
+    "function cold(o) { return o.x + 1; }"
+    "function hot(o) { return o.x + 2; }"
+    "for (var i = 0; i < 100000; ++i) {"
+    "    cold({ x: i });"
+    "    hot({ x: i });"
+    "}";
+
+static const char* callHotScript =
+    "for (var i = 0; i < 10; ++i)"
+    "    hot({ x: i });";
+
+static JSC::JITCode::JITType jitTypeOfFunction(JSGlobalContextRef context, const char* name)
+{
+    ExecState* exec = toJS(context);
+    VM& vm = exec->vm();
+    JSLockHolder locker(vm);
+    JSGlobalObject* globalObject = exec->lexicalGlobalObject();
+    JSValue value = globalObject->get(exec, Identifier::fromString(&vm, name));
+    JSFunction* function = jsDynamicCast<JSFunction*>(vm, value);
+    if (!function || function->isHostFunction())
+        return JITCode::None;
+    CodeBlock* codeBlock = function->jsExecutable()->codeBlockForCall();
+    return codeBlock ? codeBlock->jitType() : JITCode::None;
+}
+
+static void collectGarbage(JSGlobalContextRef context)
+{
+    VM& vm = toJS(context)->vm();
+    JSLockHolder locker(vm);
+    vm.heap.collectNow(Sync, CollectionScope::Full);
+}
+
+static bool evaluate(JSGlobalContextRef context, const char* source)
+{
+    JSStringRef script = JSStringCreateWithUTF8CString(source);
+    JSValueRef exception = nullptr;
+    JSEvaluateScript(context, script, nullptr, nullptr, 1, &exception);
+    JSStringRelease(script);
+    return !exception;
+}
+
+int testColdCodeEviction()
+{
+    bool failed = false;
+
+    JSC::initializeThreading();
+    Options::initialize(); // Ensure options is initialized first.
+
+    StringBuilder savedOptionsBuilder;
+    Options::dumpAllOptionsInALine(savedOptionsBuilder);
+
+    // With a zero threshold the pool always counts as short, and with a zero age any optimized code
+    // that did not run since the previous GC counts as cold. Without inlining, the loops enter the
+    // functions' own DFG code rather than copies of it.
+    Options::setOptions("--useConcurrentJIT=false --useJIT=true --useDFGJIT=true --useFTLJIT=false --maximumInliningDepth=1 --useColdCodeEviction=true --coldCodeEvictionThreshold=0 --coldCodeEvictionAge=0");
+
+    if (VM::canUseJIT()) {
+        JSGlobalContextRef context = JSGlobalContextCreateInGroup(nullptr, nullptr);
+
+        if (!evaluate(context, compileScript)) {
+            printf("FAIL: Cold code eviction test script threw.\n");
+            failed = true;
+        } else if (jitTypeOfFunction(context, "cold") != JITCode::DFGJIT || jitTypeOfFunction(context, "hot") != JITCode::DFGJIT)
+            printf("PASS: Cold code eviction test skipped, the functions did not reach the DFG.\n");
+        else {
+            // Both functions ran since the previous GC, so neither is cold yet.
+            collectGarbage(context);
+            if (jitTypeOfFunction(context, "cold") != JITCode::DFGJIT || jitTypeOfFunction(context, "hot") != JITCode::DFGJIT) {
+                printf("FAIL: Code that just ran was evicted as cold.\n");
+                failed = true;
+            }
+
+            // Only hot runs before the next GC.
+            if (!evaluate(context, callHotScript)) {
+                printf("FAIL: Cold code eviction test script threw.\n");
+                failed = true;
+            }
+            collectGarbage(context);
+
+            if (jitTypeOfFunction(context, "cold") == JITCode::DFGJIT) {
+                printf("FAIL: Cold DFG code was not evicted.\n");
+                failed = true;
+            }
+            if (jitTypeOfFunction(context, "hot") != JITCode::DFGJIT) {
+                printf("FAIL: Hot DFG code was evicted.\n");
+                failed = true;
+            }
+
+            if (!failed)
+                printf("PASS: Cold DFG code was evicted and hot DFG code was kept.\n");
+        }
+
+        JSGlobalContextRelease(context);
+    } else
+        printf("PASS: Cold code eviction test skipped, the JIT is disabled.\n");
+
+    Options::setOptions(savedOptionsBuilder.toString().ascii().data());
+
+    return failed;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HeapSnapshotStreamingTest.h"
+
+#include "APICast.h"
+#include "HeapProfiler.h"
+#include "HeapSnapshotBuilder.h"
+#include "JSCInlines.h"
+#include "JavaScript.h"
+#include <wtf/Vector.h>
+
+using namespace JSC;
+
+static const char* populateHeapScript =
+    "var objects = [];"
+    "for (var i = 0; i < 5000; ++i) {"
+    "    var object = { index: i, label: 'object ' + i, nested: { value: i * 2 } };"
+    "    object['property' + (i % 50)] = 'caf\\u00e9 \\u2603 ' + i;"
+    "    objects.push(object);"
+    "}";
+
+int testHeapSnapshotStreaming()
+{
+    bool failed = false;
+
+    JSGlobalContextRef context = JSGlobalContextCreate(nullptr);
+    JSStringRef script = JSStringCreateWithUTF8CString(populateHeapScript);
+    JSValueRef exception = nullptr;
+    JSEvaluateScript(context, script, nullptr, nullptr, 1, &exception);
+    JSStringRelease(script);
+    if (exception) {
+        printf("FAIL: Heap snapshot streaming test script threw.\n");
+        failed = true;
+    }
+
+    {
+        ExecState* exec = toJS(context);
+        VM& vm = exec->vm();
+        JSLockHolder locker(vm);
+
+        HeapSnapshotBuilder builder(vm.ensureHeapProfiler());
+        builder.buildSnapshot();
+
+        CString buffered = builder.json().utf8();
+
+        Vector<char> streamed;
+        unsigned chunkCount = 0;
+        builder.writeJSON([&] (const CString& chunk) {
+            streamed.append(chunk.data(), chunk.length());
+            ++chunkCount;
+        });
+
+        if (chunkCount < 2) {
+            printf("FAIL: Heap snapshot was streamed in %u chunk(s), expected several.\n", chunkCount);
+            failed = true;
+        }
+        if (streamed.size() != buffered.length() || memcmp(streamed.data(), buffered.data(), streamed.size())) {
+            printf("FAIL: Streamed heap snapshot differs from json() (%zu bytes streamed, %zu bytes buffered).\n", streamed.size(), buffered.length());
+            failed = true;
+        }
+
+        // Filtered snapshots go through the same serializer.
+        auto onlyObjects = [] {
+            return [] (const HeapSnapshotNode& node) { return node.cell->isObject(); };
+        };
+        CString bufferedObjects = builder.json(onlyObjects()).utf8();
+        Vector<char> streamedObjects;
+        builder.writeJSON([&] (const CString& chunk) {
+            streamedObjects.append(chunk.data(), chunk.length());
+        }, onlyObjects());
+        if (streamedObjects.size() != bufferedObjects.length() || memcmp(streamedObjects.data(), bufferedObjects.data(), streamedObjects.size())) {
+            printf("FAIL: Streamed filtered heap snapshot differs from json().\n");
+            failed = true;
+        }
+    }
+
+    JSGlobalContextRelease(context);
+
+    if (!failed)
+        printf("PASS: Streamed heap snapshot matches json().\n");
+
+    return failed;
+}
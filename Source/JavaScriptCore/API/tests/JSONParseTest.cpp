@@ -31,9 +31,105 @@
 #include "JSONObject.h"
 #include "VM.h"
 #include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
 
 using namespace JSC;
 
+struct StringScanningCase {
+    Vector<UChar> source;
+    Vector<UChar> expected;
+    bool isValid;
+};
+
+static Vector<StringScanningCase> stringScanningCases(bool is8Bit)
+{
+    Vector<StringScanningCase> cases;
+    auto add = [&] (std::initializer_list<UChar> source, std::initializer_list<UChar> expected, bool isValid = true) {
+        cases.append({ source, expected, isValid });
+    };
+
+    add({ '\\', '"' }, { '"' });
+    add({ '\\', '\\' }, { '\\' });
+    add({ '\\', 'n' }, { '\n' });
+    add({ '\\', 'u', '0', '0', 'e', '9' }, { 0xe9 });
+    add({ '\\', 'u', '2', '6', '0', '3' }, { 0x2603 });
+    add({ 0x01 }, { }, false);
+    add({ 0x1f }, { }, false);
+    add({ '\t' }, { }, false);
+    add({ 0x7f }, { 0x7f });
+    add({ 0xff }, { 0xff });
+    if (!is8Bit) {
+        // Characters whose low byte looks like a quote, a backslash or a control character.
+        add({ 0x0100 }, { 0x0100 });
+        add({ 0x2603 }, { 0x2603 });
+        add({ 0x8022 }, { 0x8022 });
+        add({ 0xa05c }, { 0xa05c });
+        add({ 0xff1f }, { 0xff1f });
+        add({ 0xffff }, { 0xffff });
+    }
+    return cases;
+}
+
+static String makeJSONString(const Vector<UChar>& characters, bool is8Bit)
+{
+    if (!is8Bit)
+        return String(characters.data(), characters.size());
+    Vector<LChar> latin1;
+    for (UChar character : characters)
+        latin1.append(static_cast<LChar>(character));
+    return String(latin1.data(), latin1.size());
+}
+
+// LiteralParser skips ordinary string characters a word at a time, so put every special
+// character at every offset within a word, with runs of ordinary characters on both sides.
+static bool testJSONStringScanning(ExecState* exec, bool is8Bit)
+{
+    bool failed = false;
+    constexpr unsigned maxRunLength = 17;
+    for (auto& testCase : stringScanningCases(is8Bit)) {
+        for (unsigned prefixLength = 0; prefixLength <= maxRunLength; ++prefixLength) {
+            for (unsigned suffixLength = 0; suffixLength <= maxRunLength; ++suffixLength) {
+                for (unsigned repeat = 1; repeat <= 2; ++repeat) {
+                    Vector<UChar> source;
+                    Vector<UChar> expected;
+                    source.append('"');
+                    for (unsigned i = 0; i < repeat; ++i) {
+                        for (unsigned j = 0; j < prefixLength; ++j) {
+                            source.append('a');
+                            expected.append('a');
+                        }
+                        source.appendVector(testCase.source);
+                        expected.appendVector(testCase.expected);
+                        for (unsigned j = 0; j < suffixLength; ++j) {
+                            source.append('b');
+                            expected.append('b');
+                        }
+                    }
+                    source.append('"');
+
+                    String json = makeJSONString(source, is8Bit);
+                    if (json.is8Bit() != is8Bit) {
+                        printf("FAIL: JSONParse string scanning test built a string of the wrong width.\n");
+                        return true;
+                    }
+
+                    JSValue result = JSONParse(exec, json);
+                    bool passed;
+                    if (testCase.isValid)
+                        passed = result.isString() && asString(result)->value(exec) == String(expected.data(), expected.size());
+                    else
+                        passed = !result;
+                    if (!passed) {
+                        printf("FAIL: JSONParse string scanning (%s, %s, prefix %u, suffix %u, repeat %u).\n", is8Bit ? "8-bit" : "16-bit", json.utf8().data(), prefixLength, suffixLength, repeat);
+                        failed = true;
+                    }
+                }
+            }
+        }
+    }
+    return failed;
+}
+
 int testJSONParse()
 {
     bool failed = false;
@@ -58,6 +154,9 @@ int testJSONParse()
     failed = failed || (v3 != v4);
     failed = failed || (v4 == v5);
 
+    failed = testJSONStringScanning(exec, true) || failed;
+    failed = testJSONStringScanning(exec, false) || failed;
+
     vm = nullptr;
 
     if (failed)
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SharedJITStubTest.h"
+
+#include "APICast.h"
+#include "InitializeThreading.h"
+#include "JSCInlines.h"
+#include "JavaScript.h"
+#include "Options.h"
+#include "SharedJITStubSet.h"
+#include <wtf/text/StringBuilder.h>
+
+using namespace JSC;
+
+// f and g are distinct functions whose get_by_id sites see the same structures in the same order,
+// so their polymorphic stubs assemble to the same bytes.
+static const char* setUpScript =
+    "var f = new Function('o', 'return o.a;');"
+    "var g = new Function('o', 'return o.a;');"
+    "var objects = [{ a: 1 }, { b: 0, a: 2 }, { c: 0, a: 3 }];"
+    "function warm(getter, objects) {"
+    "    var sum = 0;"
+    "    for (var i = 0; i < 1000; ++i)"
+    "        sum += getter(objects[i % objects.length]);"
+    "    return sum;"
+    "}"
+    "function C() { }"
+    "var trapCount = 0;"
+    "var proxied = Object.create(new Proxy({ }, { getPrototypeOf() { ++trapCount; return C.prototype; } }));"
+    "var isA = new Function('o', 'C', 'return o instanceof C;');"
+    "var isB = new Function('o', 'C', 'return o instanceof C;');"
+    "true";
+
+static const char* warmFScript = "warm(f, objects) === 1999";
+static const char* warmGScript = "warm(g, objects) === 1999";
+
+// A structure that neither stub has a case for leaves through failAndRepatch.
+static const char* addStructureScript =
+    "objects.push({ d: 0, a: 4 });"
+    "warm(f, objects) === 2500 && warm(g, objects) === 2500";
+
+// The proxy in the prototype chain makes the instanceof stubs generic, and every proxied object
+// leaves them through failAndIgnore to run the trap in the slow path.
+static const char* instanceOfScript =
+    "function testInstanceOf(isInstance) {"
+    "    var before = trapCount;"
+    "    for (var i = 0; i < 1000; ++i) {"
+    "        if (!isInstance(new C, C) || isInstance({ }, C) || !isInstance(proxied, C))"
+    "            return false;"
+    "    }"
+    "    return trapCount - before === 1000;"
+    "}"
+    "true";
+
+static const char* instanceOfAScript = "testInstanceOf(isA)";
+static const char* instanceOfBScript = "testInstanceOf(isB)";
+
+static const char* dropFunctionsScript =
+    "f = g = isA = isB = warm = testInstanceOf = proxied = null; true";
+
+static bool evaluate(JSGlobalContextRef context, const char* source)
+{
+    JSStringRef script = JSStringCreateWithUTF8CString(source);
+    JSValueRef exception = nullptr;
+    JSValueRef result = JSEvaluateScript(context, script, nullptr, nullptr, 1, &exception);
+    JSStringRelease(script);
+    return !exception && JSValueIsBoolean(context, result) && JSValueToBoolean(context, result);
+}
+
+static size_t sharedStubCount(JSGlobalContextRef context)
+{
+    VM& vm = toJS(context)->vm();
+    JSLockHolder locker(vm);
+    return vm.sharedJITStubs->size();
+}
+
+static void collectGarbage(JSGlobalContextRef context)
+{
+    VM& vm = toJS(context)->vm();
+    JSLockHolder locker(vm);
+    vm.heap.collectNow(Sync, CollectionScope::Full);
+}
+
+int testSharedJITStubs()
+{
+    bool failed = false;
+
+    JSC::initializeThreading();
+    Options::initialize(); // Ensure options is initialized first.
+
+    StringBuilder savedOptionsBuilder;
+    Options::dumpAllOptionsInALine(savedOptionsBuilder);
+
+    // Stay in the baseline JIT so that every inline cache we look at is one of ours.
+    Options::setOptions("--useSharedPolymorphicAccessStubs=true --useConcurrentJIT=false --useJIT=true --useDFGJIT=false --thresholdForJITAfterWarmUp=10 --thresholdForJITSoon=10");
+
+    if (VM::canUseJIT() && SharedJITStubSet::isSupported()) {
+        JSGlobalContextRef context = JSGlobalContextCreateInGroup(nullptr, nullptr);
+
+        auto check = [&] (bool condition, const char* failure) {
+            if (!condition) {
+                printf("FAIL: %s\n", failure);
+                failed = true;
+            }
+        };
+
+        check(evaluate(context, setUpScript), "Shared JIT stub test set up threw.");
+        size_t initialCount = sharedStubCount(context);
+
+        check(evaluate(context, warmFScript), "A shared stub returned the wrong property.");
+        size_t countAfterF = sharedStubCount(context);
+        check(countAfterF > initialCount, "A polymorphic get_by_id did not make a shared stub.");
+
+        check(evaluate(context, warmGScript), "A shared stub returned the wrong property.");
+        check(sharedStubCount(context) == countAfterF, "Two inline caches with the same cases did not share one stub.");
+
+        check(evaluate(context, addStructureScript), "A shared stub returned the wrong property after repatching.");
+        check(sharedStubCount(context) == countAfterF, "Repatching both inline caches did not free the old stub or share the new one.");
+
+        check(evaluate(context, instanceOfScript), "Shared JIT stub test instanceof set up threw.");
+        check(evaluate(context, instanceOfAScript), "A shared instanceof stub gave the wrong answer.");
+        size_t countAfterA = sharedStubCount(context);
+        check(evaluate(context, instanceOfBScript), "A shared instanceof stub gave the wrong answer.");
+        check(sharedStubCount(context) == countAfterA, "Two generic instanceof inline caches did not share one stub.");
+
+        check(evaluate(context, dropFunctionsScript), "Shared JIT stub test tear down threw.");
+        collectGarbage(context);
+        check(sharedStubCount(context) <= initialCount, "Shared stubs outlived every inline cache that used them.");
+
+        if (!failed)
+            printf("PASS: Shared polymorphic access stubs are shared, exit correctly, and are freed.\n");
+
+        JSGlobalContextRelease(context);
+    } else
+        printf("PASS: Shared JIT stub test skipped, shared stubs are not supported.\n");
+
+    Options::setOptions(savedOptionsBuilder.toString().ascii().data());
+
+    return failed;
+}
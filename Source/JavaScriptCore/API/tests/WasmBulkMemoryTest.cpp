@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmBulkMemoryTest.h"
+
+#include "InitializeThreading.h"
+#include "JavaScript.h"
+#include "Options.h"
+#include <wtf/text/StringBuilder.h>
+
+using namespace JSC;
+
+#if ENABLE(WEBASSEMBLY)
+
+// The module exports its one page memory and
+//     copy(destination, source, count) { memory.copy(destination, source, count) }
+//     fill(destination, value, count) { memory.fill(destination, value, count) }
+// The script returns the first thing that went wrong, or the empty string.
+static const char* bulkMemoryScript =
+    "(function () {"
+    "    if (typeof WebAssembly !== 'object')"
+    "        return '';"
+    "    var bytes = new Uint8Array(["
+    "        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,"
+    "        0x01, 0x07, 0x01, 0x60, 0x03, 0x7f, 0x7f, 0x7f, 0x00,"
+    "        0x03, 0x03, 0x02, 0x00, 0x00,"
+    "        0x05, 0x03, 0x01, 0x00, 0x01,"
+    "        0x07, 0x18, 0x03,"
+    "        0x04, 0x63, 0x6f, 0x70, 0x79, 0x00, 0x00,"
+    "        0x04, 0x66, 0x69, 0x6c, 0x6c, 0x00, 0x01,"
+    "        0x06, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x02, 0x00,"
+    "        0x0a, 0x1a, 0x02,"
+    "        0x0c, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0xfc, 0x0a, 0x00, 0x00, 0x0b,"
+    "        0x0b, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0xfc, 0x0b, 0x00, 0x0b"
+    "    ]);"
+    "    var exports = new WebAssembly.Instance(new WebAssembly.Module(bytes)).exports;"
+    "    var memory = new Uint8Array(exports.memory.buffer);"
+    "    var size = memory.length;"
+    ""
+    "    function expectBytes(start, expected, what) {"
+    "        for (var i = 0; i < expected.length; ++i) {"
+    "            if (memory[start + i] !== expected[i])"
+    "                throw what + ': byte ' + (start + i) + ' is ' + memory[start + i] + ', expected ' + expected[i];"
+    "        }"
+    "    }"
+    "    function setBytes(start, values) {"
+    "        for (var i = 0; i < values.length; ++i)"
+    "            memory[start + i] = values[i];"
+    "    }"
+    "    function expectTrap(operation, what) {"
+    "        try {"
+    "            operation();"
+    "        } catch (error) {"
+    "            if (!(error instanceof WebAssembly.RuntimeError))"
+    "                throw what + ': threw ' + error;"
+    "            return;"
+    "        }"
+    "        throw what + ': did not trap';"
+    "    }"
+    ""
+    "    try {"
+    "        exports.fill(10, 0xab, 5);"
+    "        expectBytes(9, [0, 0xab, 0xab, 0xab, 0xab, 0xab, 0], 'fill');"
+    "        exports.fill(20, 0x1ff, 2);"
+    "        expectBytes(20, [0xff, 0xff, 0], 'fill with a value wider than a byte');"
+    ""
+    "        setBytes(100, [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]);"
+    "        exports.copy(102, 100, 8);"
+    "        expectBytes(100, [0, 1, 0, 1, 2, 3, 4, 5, 6, 7], 'overlapping copy to a higher address');"
+    "        setBytes(200, [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]);"
+    "        exports.copy(200, 202, 8);"
+    "        expectBytes(200, [2, 3, 4, 5, 6, 7, 8, 9, 8, 9], 'overlapping copy to a lower address');"
+    "        exports.copy(300, 300, 0);"
+    "        exports.copy(200, 200, 10);"
+    "        expectBytes(200, [2, 3, 4, 5, 6, 7, 8, 9, 8, 9], 'copy onto itself');"
+    ""
+    "        setBytes(size - 10, [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]);"
+    "        exports.copy(0, size - 10, 10);"
+    "        expectBytes(0, [1, 2, 3, 4, 5, 6, 7, 8, 9, 10], 'copy from the end of memory');"
+    "        exports.fill(size - 1, 42, 1);"
+    "        expectBytes(size - 1, [42], 'fill of the last byte');"
+    ""
+    "        exports.copy(size, 0, 0);"
+    "        exports.copy(0, size, 0);"
+    "        exports.copy(size, size, 0);"
+    "        exports.fill(size, 0, 0);"
+    "        expectTrap(() => exports.copy(size + 1, 0, 0), 'zero length copy to past the end of memory');"
+    "        expectTrap(() => exports.copy(0, size + 1, 0), 'zero length copy from past the end of memory');"
+    "        expectTrap(() => exports.fill(size + 1, 0, 0), 'zero length fill past the end of memory');"
+    ""
+    "        setBytes(size - 6, [0, 0, 0, 0, 0, 0]);"
+    "        expectTrap(() => exports.fill(size - 6, 7, 10), 'fill across the end of memory');"
+    "        expectBytes(size - 6, [0, 0, 0, 0, 0, 0], 'fill across the end of memory');"
+    "        expectTrap(() => exports.copy(size - 6, 0, 10), 'copy to across the end of memory');"
+    "        expectBytes(size - 6, [0, 0, 0, 0, 0, 0], 'copy to across the end of memory');"
+    "        setBytes(0, [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]);"
+    "        setBytes(32, [0, 0, 0, 0, 0, 0, 0, 0, 0, 0]);"
+    "        expectTrap(() => exports.copy(32, size - 6, 10), 'copy from across the end of memory');"
+    "        expectBytes(32, [0, 0, 0, 0, 0, 0, 0, 0, 0, 0], 'copy from across the end of memory');"
+    "        expectTrap(() => exports.fill(32, 7, -1), 'fill of 4GB');"
+    "        expectBytes(32, [0, 0, 0, 0, 0, 0, 0, 0, 0, 0], 'fill of 4GB');"
+    "        expectTrap(() => exports.copy(33, 0, -1), 'copy of 4GB');"
+    "        expectBytes(32, [0, 0, 0, 0, 0, 0, 0, 0, 0, 0], 'copy of 4GB');"
+    "        expectTrap(() => exports.fill(-1, 7, 2), 'fill at 4GB');"
+    "    } catch (error) {"
+    "        return String(error);"
+    "    }"
+    "    return '';"
+    "})()";
+
+static bool runBulkMemoryScript(const char* configuration)
+{
+    JSGlobalContextRef context = JSGlobalContextCreateInGroup(nullptr, nullptr);
+    JSStringRef script = JSStringCreateWithUTF8CString(bulkMemoryScript);
+    JSValueRef exception = nullptr;
+    JSValueRef result = JSEvaluateScript(context, script, nullptr, nullptr, 1, &exception);
+    JSStringRelease(script);
+
+    bool failed = false;
+    if (exception || !JSValueIsString(context, result)) {
+        printf("FAIL: WebAssembly bulk memory test threw with %s.\n", configuration);
+        failed = true;
+    } else {
+        JSStringRef problem = JSValueToStringCopy(context, result, nullptr);
+        size_t length = JSStringGetMaximumUTF8CStringSize(problem);
+        Vector<char> buffer(length);
+        JSStringGetUTF8CString(problem, buffer.data(), length);
+        JSStringRelease(problem);
+        if (buffer[0]) {
+            printf("FAIL: WebAssembly bulk memory with %s: %s.\n", configuration, buffer.data());
+            failed = true;
+        }
+    }
+
+    JSGlobalContextRelease(context);
+    return failed;
+}
+
+#endif // ENABLE(WEBASSEMBLY)
+
+int testWasmBulkMemory()
+{
+    bool failed = false;
+
+    JSC::initializeThreading();
+    Options::initialize(); // Ensure options is initialized first.
+
+#if ENABLE(WEBASSEMBLY)
+    StringBuilder savedOptionsBuilder;
+    Options::dumpAllOptionsInALine(savedOptionsBuilder);
+
+    // The interpreter, B3 code with signaling memory, and B3 code with explicit bounds checks all
+    // implement the operations separately.
+    const char* configurations[] = {
+        "--useWebAssemblyInterpreter=true",
+        "--useWebAssemblyInterpreter=false",
+        "--useWebAssemblyInterpreter=false --useWebAssemblyFastMemory=false",
+    };
+    for (const char* configuration : configurations) {
+        Options::setOptions(configuration);
+        failed = runBulkMemoryScript(configuration) || failed;
+        Options::setOptions(savedOptionsBuilder.toString().ascii().data());
+    }
+
+    if (!failed)
+        printf("PASS: WebAssembly memory.copy and memory.fill.\n");
+#else
+    printf("PASS: WebAssembly bulk memory test skipped, WebAssembly is not enabled.\n");
+#endif
+
+    return failed;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmModuleCacheTest.h"
+
+#include "APICast.h"
+#include "InitializeThreading.h"
+#include "JSCInlines.h"
+#include "JavaScript.h"
+#include "Options.h"
+#include "WasmModuleCache.h"
+#include <wtf/text/StringBuilder.h>
+
+using namespace JSC;
+
+#if ENABLE(WEBASSEMBLY)
+
+// Each module is 34 bytes and exports f, which returns the module's number.
+static const char* setUpScript =
+    "function moduleBytes(number) {"
+    "    return new Uint8Array(["
+    "        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,"
+    "        0x01, 0x05, 0x01, 0x60, 0x00, 0x01, 0x7f,"
+    "        0x03, 0x02, 0x01, 0x00,"
+    "        0x07, 0x05, 0x01, 0x01, 0x66, 0x00, 0x00,"
+    "        0x0a, 0x06, 0x01, 0x04, 0x00, 0x41, number, 0x0b"
+    "    ]);"
+    "}"
+    "function compile(number) {"
+    "    var module = new WebAssembly.Module(moduleBytes(number));"
+    "    return new WebAssembly.Instance(module).exports.f() === number;"
+    "}"
+    "typeof WebAssembly === 'object'";
+
+static bool evaluate(JSGlobalContextRef context, const char* source)
+{
+    JSStringRef script = JSStringCreateWithUTF8CString(source);
+    JSValueRef exception = nullptr;
+    JSValueRef result = JSEvaluateScript(context, script, nullptr, nullptr, 1, &exception);
+    JSStringRelease(script);
+    return !exception && JSValueIsBoolean(context, result) && JSValueToBoolean(context, result);
+}
+
+#endif // ENABLE(WEBASSEMBLY)
+
+int testWasmModuleCache()
+{
+    bool failed = false;
+
+    JSC::initializeThreading();
+    Options::initialize(); // Ensure options is initialized first.
+
+    StringBuilder savedOptionsBuilder;
+    Options::dumpAllOptionsInALine(savedOptionsBuilder);
+
+    // Room for two of our modules but not three.
+    Options::setOptions("--useWebAssemblyModuleCache=true --webAssemblyModuleCacheSize=100");
+
+#if ENABLE(WEBASSEMBLY)
+    JSGlobalContextRef context = JSGlobalContextCreateInGroup(nullptr, nullptr);
+
+    if (evaluate(context, setUpScript)) {
+        Wasm::ModuleCache& cache = Wasm::ModuleCache::singleton();
+
+        // Compiles the module numbered number and checks whether that was a cache hit.
+        auto compile = [&] (unsigned number, bool expectHit) {
+            unsigned hits = cache.hits();
+            unsigned misses = cache.misses();
+            StringBuilder source;
+            source.appendLiteral("compile(");
+            source.appendNumber(number);
+            source.append(')');
+            if (!evaluate(context, source.toString().utf8().data())) {
+                printf("FAIL: Compiling WebAssembly module %u gave the wrong result.\n", number);
+                failed = true;
+                return;
+            }
+            if (expectHit && (cache.hits() != hits + 1 || cache.misses() != misses)) {
+                printf("FAIL: Compiling WebAssembly module %u again was not a cache hit.\n", number);
+                failed = true;
+            }
+            if (!expectHit && (cache.hits() != hits || cache.misses() != misses + 1)) {
+                printf("FAIL: Compiling WebAssembly module %u was an unexpected cache hit.\n", number);
+                failed = true;
+            }
+        };
+
+        compile(1, false);
+        compile(1, true);
+        compile(2, false);
+        // Adding the third module evicts the least recently used one.
+        compile(3, false);
+        compile(3, true);
+        compile(2, true);
+        compile(1, false);
+        // Module 1 came back by evicting module 3.
+        compile(2, true);
+        compile(3, false);
+
+        if (!failed)
+            printf("PASS: WebAssembly module cache hits and evictions.\n");
+    } else
+        printf("PASS: WebAssembly module cache test skipped, WebAssembly is disabled.\n");
+
+    JSGlobalContextRelease(context);
+#else
+    printf("PASS: WebAssembly module cache test skipped, WebAssembly is not enabled.\n");
+#endif
+
+    Options::setOptions(savedOptionsBuilder.toString().ascii().data());
+
+    return failed;
+}
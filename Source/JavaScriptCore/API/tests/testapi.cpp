@@ -135,6 +135,8 @@ public:
     void symbolsDeletePropertyForKey();
     void promiseResolveTrue();
     void promiseRejectTrue();
+    void intlBuiltinsUseReifiedConstructors();
+    void mapAndSetConstructorsFromArrays();
 
     int failed() const { return m_failed; }
 
@@ -467,6 +469,51 @@ void TestAPI::promiseRejectTrue()
     check(passedTrueCalled, "then response function should have been called.");
 }
 
+void TestAPI::intlBuiltinsUseReifiedConstructors()
+{
+#if ENABLE(INTL)
+    // The locale builtins reach the Intl constructors through private names, so these must work even
+    // though nothing has touched Intl.Collator, Intl.DateTimeFormat or Intl.NumberFormat yet.
+    const char* scripts[] = {
+        "typeof 'a'.localeCompare('b') === 'number'",
+        "typeof (1).toLocaleString() === 'string'",
+        "typeof new Date(0).toLocaleString() === 'string'",
+    };
+    for (const char* script : scripts) {
+        ScriptResult result = evaluateScript(script);
+        check(result && JSValueIsStrictEqual(context, result.value(), JSValueMakeBoolean(context, true)), script);
+    }
+#endif
+}
+
+void TestAPI::mapAndSetConstructorsFromArrays()
+{
+    const char* scripts[] = {
+        // Packed arrays of primitives and entry pairs take the direct fill.
+        "(function() { var set = new Set([1, 2, 2, 3, 'a', 'a']); return set.size === 4 && Array.from(set).join() === '1,2,3,a'; })()",
+        "(function() { var map = new Map([[1, 'a'], [2, 'b'], [1, 'c']]); return map.size === 2 && map.get(1) === 'c' && Array.from(map.keys()).join() === '1,2'; })()",
+        "(function() { var values = []; for (var i = 0; i < 10000; ++i) values.push(i % 5000); return new Set(values).size === 5000; })()",
+        // Holey and sparse arrays have a length far larger than what they store.
+        "(function() { var array = []; array[1 << 16] = 1; var set = new Set(array); return set.size === 2 && set.has(undefined) && set.has(1); })()",
+        "(function() { var set = new Set(new Array(1 << 16)); return set.size === 1 && set.has(undefined); })()",
+        "(function() { var array = [[1, 'a']]; array[1 << 16] = [2, 'b']; try { new Map(array); } catch (e) { return e instanceof TypeError; } return false; })()",
+        // Holes are read through the prototype chain, in order, and may grow the array.
+        "(function() { var log = []; var array = [0, , 2]; Object.defineProperty(Array.prototype, 1, { get: function() { log.push('get'); array.push(3); return 'proto'; }, configurable: true }); try { var set = new Set(array); return Array.from(set).join() === '0,proto,2,3' && log.join() === 'get'; } finally { delete Array.prototype[1]; } })()",
+        // Entries whose key or value are accessors are read in order, and may grow the array.
+        "(function() { var log = []; var array = [[1, 'a']]; var entry = [, 'b']; Object.defineProperty(entry, 0, { get: function() { log.push('key'); array.push([3, 'c']); return 2; } }); array.push(entry); var map = new Map(array); return map.size === 3 && map.get(2) === 'b' && map.get(3) === 'c' && log.join() === 'key'; })()",
+        "(function() { var entry = { 0: 'key', 1: 'value' }; var map = new Map([[1, 2], entry]); return map.size === 2 && map.get('key') === 'value'; })()",
+        // A non-object entry throws and closes the iterator.
+        "(function() { var closed = 0; Object.prototype.return = function() { ++closed; return {}; }; try { new Map([[1, 2], 3]); } catch (e) { return e instanceof TypeError && closed === 1; } finally { delete Object.prototype.return; } return false; })()",
+        "(function() { var closed = 0; Object.prototype.return = function() { ++closed; return {}; }; try { var map = new Map([[1, 2]]); return map.size === 1 && !closed; } finally { delete Object.prototype.return; } })()",
+        // A replaced adder is still called for each element.
+        "(function() { var added = []; class LoggingSet extends Set { add(value) { added.push(value); return super.add(value); } } var set = new LoggingSet([1, 2, 1]); return set.size === 2 && added.join() === '1,2,1'; })()",
+    };
+    for (const char* script : scripts) {
+        ScriptResult result = evaluateScript(script);
+        check(result && JSValueIsStrictEqual(context, result.value(), JSValueMakeBoolean(context, true)), script);
+    }
+}
+
 #define RUN(test) do {                                 \
         if (!shouldRun(#test))                         \
             break;                                     \
@@ -500,6 +547,8 @@ int testCAPIViaCpp(const char* filter)
     RUN(symbolsDeletePropertyForKey());
     RUN(promiseResolveTrue());
     RUN(promiseRejectTrue());
+    RUN(intlBuiltinsUseReifiedConstructors());
+    RUN(mapAndSetConstructorsFromArrays());
 
     if (tasks.isEmpty()) {
         dataLogLn("Filtered all tests: ERROR");
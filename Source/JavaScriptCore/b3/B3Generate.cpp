@@ -43,6 +43,7 @@
 #include "B3LowerMacrosAfterOptimizations.h"
 #include "B3LowerToAir.h"
 #include "B3MoveConstants.h"
+#include "B3PackAdjacentStores.h"
 #include "B3Procedure.h"
 #include "B3PureCSE.h"
 #include "B3ReduceDoubleToFloat.h"
@@ -92,6 +93,8 @@ void generateToAir(Procedure& procedure)
             duplicateTails(procedure);
         fixSSA(procedure);
         foldPathConstants(procedure);
+        if (Options::useB3StorePacking())
+            packAdjacentStores(procedure);
         
         // FIXME: Add more optimizations here.
         // https://bugs.webkit.org/show_bug.cgi?id=150507
@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "B3PackAdjacentStores.h"
+
+#if ENABLE(B3_JIT)
+
+#include "B3BasicBlockInlines.h"
+#include "B3InsertionSetInlines.h"
+#include "B3MemoryValueInlines.h"
+#include "B3PhaseScope.h"
+#include "B3ProcedureInlines.h"
+#include "B3ValueInlines.h"
+#include <wtf/StdLibExtras.h>
+
+namespace JSC { namespace B3 {
+
+namespace {
+
+namespace B3PackAdjacentStoresInternal {
+static const bool verbose = false;
+}
+
+// The widest store we can pack into is a 64-bit one.
+static const unsigned maxPackedByteSize = 8;
+
+// How many values we look at past the first store of a run. This keeps the phase linear.
+static const unsigned maxScanDistance = 32;
+
+struct PackedStore {
+    MemoryValue* store;
+    unsigned index;
+};
+
+static MemoryValue* packableStore(Value* value)
+{
+    MemoryValue* store = value->as<MemoryValue>();
+    if (!store || !store->isStore() || store->isExotic() || store->traps())
+        return nullptr;
+    switch (store->opcode()) {
+    case Store8:
+    case Store16:
+        return store;
+    case Store:
+        if (store->child(0)->type() == Int32 || store->child(0)->type() == Float)
+            return store;
+        return nullptr;
+    default:
+        return nullptr;
+    }
+}
+
+class PackAdjacentStores {
+public:
+    PackAdjacentStores(Procedure& proc)
+        : m_proc(proc)
+        , m_insertionSet(proc)
+    {
+    }
+
+    bool run()
+    {
+        bool changed = false;
+        for (BasicBlock* block : m_proc) {
+            m_block = block;
+            for (unsigned index = 0; index < block->size(); ++index) {
+                if (Optional<unsigned> lastPackedIndex = packStoresStartingAt(index)) {
+                    // Anything up to here may be moving past a store that is only pending in the insertion set,
+                    // so we don't start another run before it.
+                    index = *lastPackedIndex;
+                    changed = true;
+                }
+            }
+            m_insertionSet.execute(block);
+        }
+        return changed;
+    }
+
+private:
+    Optional<unsigned> packStoresStartingAt(unsigned seedIndex)
+    {
+        MemoryValue* seed = packableStore(m_block->at(seedIndex));
+        if (!seed)
+            return WTF::nullopt;
+
+        int64_t elementSize = seed->accessByteSize();
+        int64_t low = seed->offset();
+        int64_t high = low + elementSize;
+        HeapRange range = seed->range();
+
+        // Every store in the run sinks to the last store of its packed chunk, so whatever lies between them
+        // must not touch the memory they write or be able to observe that they have not happened yet.
+        Vector<PackedStore, maxPackedByteSize> run;
+        run.append({ seed, seedIndex });
+        unsigned end = std::min<unsigned>(m_block->size(), seedIndex + maxScanDistance);
+        for (unsigned index = seedIndex + 1; index < end && high - low < maxPackedByteSize; ++index) {
+            Value* value = m_block->at(index);
+            if (MemoryValue* store = packableStore(value)) {
+                if (store->lastChild() == seed->lastChild() && static_cast<int64_t>(store->accessByteSize()) == elementSize) {
+                    bool extendsUp = store->offset() == high;
+                    bool extendsDown = store->offset() + elementSize == low;
+                    if (extendsUp || extendsDown) {
+                        if (extendsUp)
+                            high += elementSize;
+                        else
+                            low -= elementSize;
+                        range |= store->range();
+                        run.append({ store, index });
+                        continue;
+                    }
+                }
+            }
+
+            Effects effects = value->effects();
+            if (effects.terminal || effects.exitsSideways || effects.fence || effects.writes.overlaps(range) || effects.reads.overlaps(range))
+                break;
+        }
+
+        if (run.size() < 2)
+            return WTF::nullopt;
+
+        std::sort(run.begin(), run.end(), [] (const PackedStore& a, const PackedStore& b) {
+            return a.store->offset() < b.store->offset();
+        });
+
+        // Plan every chunk before changing anything, so that the checks below see the block as it was.
+        struct Chunk {
+            unsigned begin;
+            unsigned size;
+            unsigned insertionIndex;
+        };
+        Vector<Chunk, maxPackedByteSize> chunks;
+        for (unsigned begin = 0; begin < run.size();) {
+            unsigned size = 1;
+            while (begin + size * 2 <= run.size() && size * 2 * elementSize <= maxPackedByteSize)
+                size *= 2;
+            if (size > 1) {
+                unsigned insertionIndex = 0;
+                for (unsigned i = begin; i < begin + size; ++i)
+                    insertionIndex = std::max(insertionIndex, run[i].index);
+                Chunk chunk { begin, size, insertionIndex };
+                if (canPackAsConstant(run, chunk.begin, chunk.size) || canPackAsCopy(run, chunk.begin, chunk.size, chunk.insertionIndex))
+                    chunks.append(chunk);
+            }
+            begin += size;
+        }
+
+        if (chunks.isEmpty())
+            return WTF::nullopt;
+
+        unsigned lastPackedIndex = 0;
+        for (const Chunk& chunk : chunks) {
+            pack(run, chunk.begin, chunk.size, chunk.insertionIndex);
+            lastPackedIndex = std::max(lastPackedIndex, chunk.insertionIndex);
+        }
+        return lastPackedIndex;
+    }
+
+    static bool canPackAsConstant(const Vector<PackedStore, maxPackedByteSize>& run, unsigned begin, unsigned size)
+    {
+        for (unsigned i = begin; i < begin + size; ++i) {
+            Value* value = run[i].store->child(0);
+            if (!value->hasInt32() && !value->hasFloat())
+                return false;
+        }
+        return true;
+    }
+
+    static uint64_t constantBits(Value* value, size_t byteSize)
+    {
+        uint64_t bits = value->hasInt32() ? static_cast<uint32_t>(value->asInt32()) : bitwise_cast<uint32_t>(value->asFloat());
+        if (byteSize < sizeof(uint64_t))
+            bits &= (1ull << (byteSize * 8)) - 1;
+        return bits;
+    }
+
+    static bool mayAlias(MemoryValue* store, MemoryValue* load)
+    {
+        if (store->lastChild() == load->lastChild()) {
+            int64_t storeBegin = store->offset();
+            int64_t loadBegin = load->offset();
+            return storeBegin < loadBegin + static_cast<int64_t>(load->accessByteSize())
+                && loadBegin < storeBegin + static_cast<int64_t>(store->accessByteSize());
+        }
+        return store->range().overlaps(load->range());
+    }
+
+    // A chunk is a copy if each store's value is loaded from the same place relative to the store. The loads
+    // then get replaced by one wide load right before the wide store, which is only valid if nothing in
+    // between could have changed the memory they read.
+    bool canPackAsCopy(const Vector<PackedStore, maxPackedByteSize>& run, unsigned begin, unsigned size, unsigned insertionIndex)
+    {
+        MemoryValue* firstLoad = run[begin].store->child(0)->as<MemoryValue>();
+        if (!firstLoad)
+            return false;
+        int64_t delta = static_cast<int64_t>(firstLoad->offset()) - run[begin].store->offset();
+
+        Vector<MemoryValue*, maxPackedByteSize> loads;
+        for (unsigned i = begin; i < begin + size; ++i) {
+            MemoryValue* store = run[i].store;
+            MemoryValue* load = store->child(0)->as<MemoryValue>();
+            if (!load || !load->isLoad() || load->isExotic() || load->traps() || load->owner != m_block)
+                return false;
+            if (load->lastChild() != firstLoad->lastChild() || load->accessByteSize() != store->accessByteSize())
+                return false;
+            if (static_cast<int64_t>(load->offset()) - store->offset() != delta)
+                return false;
+            // Every store of the run moves, so none of them may write what we load.
+            for (const PackedStore& other : run) {
+                if (mayAlias(other.store, load))
+                    return false;
+            }
+            loads.append(load);
+        }
+
+        unsigned remainingLoads = loads.size();
+        for (unsigned index = insertionIndex; index-- && insertionIndex - index <= 2 * maxScanDistance;) {
+            Value* value = m_block->at(index);
+            if (loads.contains(value)) {
+                if (!--remainingLoads)
+                    return true;
+                continue;
+            }
+            if (run.findMatching([&] (const PackedStore& packed) { return packed.store == value; }) != notFound)
+                continue;
+
+            Effects effects = value->effects();
+            if (effects.fence)
+                return false;
+            for (MemoryValue* load : loads) {
+                if (effects.writes.overlaps(load->range()))
+                    return false;
+            }
+        }
+        return false;
+    }
+
+    void pack(const Vector<PackedStore, maxPackedByteSize>& run, unsigned begin, unsigned size, unsigned insertionIndex)
+    {
+        MemoryValue* firstStore = run[begin].store;
+        MemoryValue* lastStore = m_block->at(insertionIndex)->as<MemoryValue>();
+        size_t elementSize = firstStore->accessByteSize();
+        size_t packedSize = elementSize * size;
+        Origin origin = lastStore->origin();
+
+        HeapRange storeRange = firstStore->range();
+        for (unsigned i = begin; i < begin + size; ++i)
+            storeRange |= run[i].store->range();
+
+        Type packedType = packedSize == sizeof(uint64_t) ? Int64 : Int32;
+        Value* packedValue;
+        if (canPackAsConstant(run, begin, size)) {
+            // B3 only targets little endian CPUs.
+            uint64_t bits = 0;
+            for (unsigned i = begin; i < begin + size; ++i)
+                bits |= constantBits(run[i].store->child(0), elementSize) << ((run[i].store->offset() - firstStore->offset()) * 8);
+            if (packedType == Int64)
+                packedValue = m_insertionSet.insert<Const64Value>(insertionIndex, origin, bits);
+            else
+                packedValue = m_insertionSet.insert<Const32Value>(insertionIndex, origin, static_cast<int32_t>(bits));
+        } else {
+            MemoryValue* firstLoad = firstStore->child(0)->as<MemoryValue>();
+            HeapRange loadRange = firstLoad->range();
+            for (unsigned i = begin; i < begin + size; ++i)
+                loadRange |= run[i].store->child(0)->as<MemoryValue>()->range();
+            if (packedSize == sizeof(uint16_t))
+                packedValue = m_insertionSet.insert<MemoryValue>(insertionIndex, Load16Z, origin, firstLoad->lastChild(), firstLoad->offset(), loadRange);
+            else
+                packedValue = m_insertionSet.insert<MemoryValue>(insertionIndex, Load, packedType, origin, firstLoad->lastChild(), firstLoad->offset(), loadRange);
+        }
+
+        Opcode storeOpcode = packedSize == sizeof(uint16_t) ? Store16 : Store;
+        m_insertionSet.insert<MemoryValue>(insertionIndex, storeOpcode, origin, packedValue, firstStore->lastChild(), firstStore->offset(), storeRange);
+
+        if (B3PackAdjacentStoresInternal::verbose)
+            dataLogLn("Packing ", size, " stores starting at ", *firstStore, " into a ", packedSize, " byte store of ", *packedValue);
+
+        for (unsigned i = begin; i < begin + size; ++i)
+            run[i].store->replaceWithNop();
+    }
+
+    Procedure& m_proc;
+    InsertionSet m_insertionSet;
+    BasicBlock* m_block { nullptr };
+};
+
+} // anonymous namespace
+
+bool packAdjacentStores(Procedure& proc)
+{
+    PhaseScope phaseScope(proc, "packAdjacentStores");
+    PackAdjacentStores packAdjacentStores(proc);
+    return packAdjacentStores.run();
+}
+
+} } // namespace JSC::B3
+
+#endif // ENABLE(B3_JIT)
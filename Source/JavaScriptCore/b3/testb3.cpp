@@ -12525,6 +12525,193 @@ void testStore16Load16Z(int32_t value)
     CHECK(compileAndRun<int32_t>(proc, value) == static_cast<uint16_t>(value));
 }
 
+static unsigned countStores(Procedure& proc)
+{
+    unsigned storeCount = 0;
+    for (Value* value : proc.values()) {
+        if (isStore(value->opcode()))
+            storeCount++;
+    }
+    return storeCount;
+}
+
+static bool shouldPackStores(Procedure& proc)
+{
+    return proc.optLevel() >= 2 && Options::useB3StorePacking();
+}
+
+void testPackAdjacentConstantStore8()
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    Value* address = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    for (int32_t i = 0; i < 8; ++i)
+        root->appendNew<MemoryValue>(proc, Store8, Origin(), root->appendNew<Const32Value>(proc, Origin(), 0xf0 + i), address, i);
+    root->appendNewControlValue(proc, Return, Origin());
+
+    uint8_t storage[9] = { };
+    compileAndRun<void>(proc, storage);
+    for (unsigned i = 0; i < 8; ++i)
+        CHECK_EQ(storage[i], static_cast<uint8_t>(0xf0 + i));
+    CHECK_EQ(storage[8], 0);
+    if (shouldPackStores(proc))
+        CHECK_EQ(countStores(proc), 1u);
+}
+
+void testPackAdjacentConstantStoreFloat(float a, float b)
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    Value* address = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    // Stored highest address first, which packs just the same.
+    root->appendNew<MemoryValue>(proc, Store, Origin(), root->appendNew<ConstFloatValue>(proc, Origin(), b), address, static_cast<int32_t>(sizeof(float)));
+    root->appendNew<MemoryValue>(proc, Store, Origin(), root->appendNew<ConstFloatValue>(proc, Origin(), a), address);
+    root->appendNewControlValue(proc, Return, Origin());
+
+    float storage[2] = { };
+    compileAndRun<void>(proc, storage);
+    CHECK(isIdentical(storage[0], a));
+    CHECK(isIdentical(storage[1], b));
+    if (shouldPackStores(proc))
+        CHECK_EQ(countStores(proc), 1u);
+}
+
+void testPackAdjacentCopyStore16()
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    Value* source = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    Value* destination = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1);
+    for (int32_t i = 0; i < 4; ++i) {
+        int32_t offset = i * static_cast<int32_t>(sizeof(uint16_t));
+        Value* value = root->appendNew<MemoryValue>(proc, Load16Z, Origin(), source, offset, HeapRange(1));
+        root->appendNew<MemoryValue>(proc, Store16, Origin(), value, destination, offset, HeapRange(2));
+    }
+    root->appendNewControlValue(proc, Return, Origin());
+
+    uint16_t sourceStorage[4] = { 0x1234, 0xffff, 0, 0x8001 };
+    uint16_t destinationStorage[5] = { };
+    compileAndRun<void>(proc, sourceStorage, destinationStorage);
+    for (unsigned i = 0; i < 4; ++i)
+        CHECK_EQ(destinationStorage[i], sourceStorage[i]);
+    CHECK_EQ(destinationStorage[4], 0);
+    if (shouldPackStores(proc))
+        CHECK_EQ(countStores(proc), 1u);
+}
+
+void testDontPackOverlappingCopyStore16()
+{
+    // This shifts memory like memmove, so the second load has to see what the first store wrote.
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    Value* address = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    for (int32_t i = 0; i < 2; ++i) {
+        int32_t offset = i * static_cast<int32_t>(sizeof(uint16_t));
+        Value* value = root->appendNew<MemoryValue>(proc, Load16Z, Origin(), address, offset);
+        root->appendNew<MemoryValue>(proc, Store16, Origin(), value, address, offset + static_cast<int32_t>(sizeof(uint16_t)));
+    }
+    root->appendNewControlValue(proc, Return, Origin());
+
+    uint16_t storage[4] = { 1, 2, 3, 4 };
+    compileAndRun<void>(proc, storage);
+    CHECK_EQ(storage[0], 1);
+    CHECK_EQ(storage[1], 1);
+    CHECK_EQ(storage[2], 1);
+    CHECK_EQ(storage[3], 4);
+    CHECK_EQ(countStores(proc), 2u);
+}
+
+void testDontPackStoresAroundAliasingLoad(HeapRange firstRange, HeapRange loadRange, HeapRange secondRange)
+{
+    // The load may read what the first store wrote, so that store can't sink past it.
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    Value* address = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    Value* otherAddress = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1);
+    root->appendNew<MemoryValue>(proc, Store8, Origin(), root->appendNew<Const32Value>(proc, Origin(), 1), address, 0, firstRange);
+    Value* loaded = root->appendNew<MemoryValue>(proc, Load8Z, Origin(), otherAddress, 0, loadRange);
+    root->appendNew<MemoryValue>(proc, Store8, Origin(), root->appendNew<Const32Value>(proc, Origin(), 2), address, 1, secondRange);
+    root->appendNewControlValue(proc, Return, Origin(), loaded);
+
+    uint8_t storage[2] = { };
+    CHECK_EQ(compileAndRun<int32_t>(proc, storage, storage), 1);
+    CHECK_EQ(storage[0], 1);
+    CHECK_EQ(storage[1], 2);
+    CHECK_EQ(countStores(proc), 2u);
+}
+
+void testDontPackFencedStores()
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    Value* address = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    root->appendNew<MemoryValue>(proc, Store8, Origin(), root->appendNew<Const32Value>(proc, Origin(), 1), address, 0);
+    root->appendNew<MemoryValue>(proc, Store8, Origin(), root->appendNew<Const32Value>(proc, Origin(), 2), address, 1, HeapRange::top(), HeapRange::top());
+    root->appendNewControlValue(proc, Return, Origin());
+
+    uint8_t storage[2] = { };
+    compileAndRun<void>(proc, storage);
+    CHECK_EQ(storage[0], 1);
+    CHECK_EQ(storage[1], 2);
+    CHECK_EQ(countStores(proc), 2u);
+}
+
+void testDontPackStoresAcrossFence()
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    Value* address = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    root->appendNew<MemoryValue>(proc, Store8, Origin(), root->appendNew<Const32Value>(proc, Origin(), 1), address, 0, HeapRange(1));
+    root->appendNew<FenceValue>(proc, Origin());
+    root->appendNew<MemoryValue>(proc, Store8, Origin(), root->appendNew<Const32Value>(proc, Origin(), 2), address, 1, HeapRange(2));
+    root->appendNewControlValue(proc, Return, Origin());
+
+    uint8_t storage[2] = { };
+    compileAndRun<void>(proc, storage);
+    CHECK_EQ(storage[0], 1);
+    CHECK_EQ(storage[1], 2);
+    CHECK_EQ(countStores(proc), 2u);
+}
+
+void testDontPackOverlappingStore16()
+{
+    // The second store overwrites the upper byte of the first, so they are not adjacent.
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    Value* address = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    root->appendNew<MemoryValue>(proc, Store16, Origin(), root->appendNew<Const32Value>(proc, Origin(), 0x2211), address, 0);
+    root->appendNew<MemoryValue>(proc, Store16, Origin(), root->appendNew<Const32Value>(proc, Origin(), 0x4433), address, 1);
+    root->appendNewControlValue(proc, Return, Origin());
+
+    uint8_t storage[4] = { };
+    compileAndRun<void>(proc, storage);
+    CHECK_EQ(storage[0], 0x11);
+    CHECK_EQ(storage[1], 0x33);
+    CHECK_EQ(storage[2], 0x44);
+    CHECK_EQ(storage[3], 0);
+    CHECK_EQ(countStores(proc), 2u);
+}
+
+void testDontPackMixedWidthStores()
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    Value* address = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    root->appendNew<MemoryValue>(proc, Store8, Origin(), root->appendNew<Const32Value>(proc, Origin(), 0x11), address, 0);
+    root->appendNew<MemoryValue>(proc, Store16, Origin(), root->appendNew<Const32Value>(proc, Origin(), 0x3322), address, 1);
+    root->appendNew<MemoryValue>(proc, Store8, Origin(), root->appendNew<Const32Value>(proc, Origin(), 0x44), address, 3);
+    root->appendNewControlValue(proc, Return, Origin());
+
+    uint8_t storage[5] = { };
+    compileAndRun<void>(proc, storage);
+    CHECK_EQ(storage[0], 0x11);
+    CHECK_EQ(storage[1], 0x22);
+    CHECK_EQ(storage[2], 0x33);
+    CHECK_EQ(storage[3], 0x44);
+    CHECK_EQ(storage[4], 0);
+    CHECK_EQ(countStores(proc), 3u);
+}
+
 void testSShrShl32(int32_t value, int32_t sshrAmount, int32_t shlAmount)
 {
     Procedure proc;
@@ -17619,6 +17806,18 @@ void run(const char* filter)
     RUN(testStore16Load16Z(12345678));
     RUN(testStore16Load16Z(-123));
 
+    RUN(testPackAdjacentConstantStore8());
+    RUN(testPackAdjacentConstantStoreFloat(1.5f, -0.0f));
+    RUN(testPackAdjacentConstantStoreFloat(static_cast<float>(PNaN), 42.0f));
+    RUN(testPackAdjacentCopyStore16());
+    RUN(testDontPackOverlappingCopyStore16());
+    RUN(testDontPackStoresAroundAliasingLoad(HeapRange::top(), HeapRange::top(), HeapRange::top()));
+    RUN(testDontPackStoresAroundAliasingLoad(HeapRange(1), HeapRange(1), HeapRange(2)));
+    RUN(testDontPackFencedStores());
+    RUN(testDontPackStoresAcrossFence());
+    RUN(testDontPackOverlappingStore16());
+    RUN(testDontPackMixedWidthStores());
+
     RUN(testSShrShl32(42, 24, 24));
     RUN(testSShrShl32(-42, 24, 24));
     RUN(testSShrShl32(4200, 24, 24));
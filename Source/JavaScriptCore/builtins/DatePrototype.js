@@ -25,6 +25,40 @@
 
 // @conditional=ENABLE(INTL)
 
+@globalPrivate
+function getDefaultDateTimeFormat(kind)
+{
+    "use strict";
+
+    // Caches the formats that toLocaleString, toLocaleDateString, and toLocaleTimeString use when
+    // they are called without locales or options. These are the options their ToDateTimeOptions
+    // step would fill in.
+    var cache = @getDefaultDateTimeFormat.cache;
+    if (!cache)
+        cache = @getDefaultDateTimeFormat.cache = @Object.@create(null);
+
+    var dateFormat = cache[kind];
+    if (dateFormat)
+        return dateFormat;
+
+    // Like the descendants ToDateTimeOptions creates, these must not see Object.prototype.
+    var options = @Object.@create(null);
+    if (kind !== "time") {
+        options.year = "numeric";
+        options.month = "numeric";
+        options.day = "numeric";
+    }
+    if (kind !== "date") {
+        options.hour = "numeric";
+        options.minute = "numeric";
+        options.second = "numeric";
+    }
+
+    dateFormat = new @DateTimeFormat(@undefined, options);
+    cache[kind] = dateFormat;
+    return dateFormat;
+}
+
 function toLocaleString(/* locales, options */)
 {
     "use strict";
@@ -75,8 +109,12 @@ function toLocaleString(/* locales, options */)
     if (@isNaN(value))
         return "Invalid Date";
 
-    var options = toDateTimeOptionsAnyAll(@argument(1));
     var locales = @argument(0);
+    var opts = @argument(1);
+    if (locales === @undefined && opts === @undefined)
+        return @getDefaultDateTimeFormat("any").format(value);
+
+    var options = toDateTimeOptionsAnyAll(opts);
 
     var dateFormat = new @DateTimeFormat(locales, options);
     return dateFormat.format(value);
@@ -125,8 +163,12 @@ function toLocaleDateString(/* locales, options */)
     if (@isNaN(value))
         return "Invalid Date";
 
-    var options = toDateTimeOptionsDateDate(@argument(1));
     var locales = @argument(0);
+    var opts = @argument(1);
+    if (locales === @undefined && opts === @undefined)
+        return @getDefaultDateTimeFormat("date").format(value);
+
+    var options = toDateTimeOptionsDateDate(opts);
 
     var dateFormat = new @DateTimeFormat(locales, options);
     return dateFormat.format(value);
@@ -174,8 +216,12 @@ function toLocaleTimeString(/* locales, options */)
     if (@isNaN(value))
         return "Invalid Date";
 
-    var options = toDateTimeOptionsTimeTime(@argument(1));
     var locales = @argument(0);
+    var opts = @argument(1);
+    if (locales === @undefined && opts === @undefined)
+        return @getDefaultDateTimeFormat("time").format(value);
+
+    var options = toDateTimeOptionsTimeTime(opts);
 
     var dateFormat = new @DateTimeFormat(locales, options);
     return dateFormat.format(value);
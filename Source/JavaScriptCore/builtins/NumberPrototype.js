@@ -25,6 +25,14 @@
 
 // @conditional=ENABLE(INTL)
 
+@globalPrivate
+function getDefaultNumberFormat()
+{
+    "use strict";
+
+    return @getDefaultNumberFormat.numberFormat || (@getDefaultNumberFormat.numberFormat = new @NumberFormat());
+}
+
 function toLocaleString(/* locales, options */)
 {
     "use strict";
@@ -36,9 +44,15 @@ function toLocaleString(/* locales, options */)
     // 2. ReturnIfAbrupt(x).
     var number = @thisNumberValue.@call(this);
 
+    // Avoid creating a new number format every time for defaults.
+    var locales = @argument(0);
+    var options = @argument(1);
+    if (locales === @undefined && options === @undefined)
+        return @getDefaultNumberFormat().format(number);
+
     // 3. Let numberFormat be Construct(%NumberFormat%, «locales, options»).
     // 4. ReturnIfAbrupt(numberFormat).
-    var numberFormat = new @NumberFormat(@argument(0), @argument(1));
+    var numberFormat = new @NumberFormat(locales, options);
 
     // 5. Return FormatNumber(numberFormat, x).
     return numberFormat.format(number);
@@ -286,6 +286,10 @@ public:
 
     constexpr uint32_t bits() const { return m_bits; }
 
+    // The result type bits only depend on the bytecode, so merging the bits of a profile
+    // taken for the same bytecode only adds observations.
+    void mergeBits(uint32_t bits) { m_bits |= bits; }
+
 private:
     constexpr explicit ArithProfile(ConstantTag, uint32_t bits)
         : m_bits(bits)
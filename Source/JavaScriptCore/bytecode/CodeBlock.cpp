@@ -87,6 +87,7 @@
 #include "TypeLocationCache.h"
 #include "TypeProfiler.h"
 #include "VMInlines.h"
+#include "WarmStartProfile.h"
 #include <wtf/BagToHashMap.h>
 #include <wtf/CommaPrinter.h>
 #include <wtf/Forward.h>
@@ -324,6 +325,7 @@ CodeBlock::CodeBlock(VM* vm, Structure* structure, CopyParsedBlockTag, CodeBlock
     , m_reoptimizationRetryCounter(0)
     , m_metadata(other.m_metadata)
     , m_creationTime(MonotonicTime::now())
+    , m_lastExecutionTime(m_creationTime)
 {
     ASSERT(heap()->isDeferred());
     ASSERT(m_scopeRegister.isLocal());
@@ -384,6 +386,7 @@ CodeBlock::CodeBlock(VM* vm, Structure* structure, ScriptExecutable* ownerExecut
     , m_reoptimizationRetryCounter(0)
     , m_metadata(unlinkedCodeBlock->metadata().link())
     , m_creationTime(MonotonicTime::now())
+    , m_lastExecutionTime(m_creationTime)
 {
     ASSERT(heap()->isDeferred());
     ASSERT(m_scopeRegister.isLocal());
@@ -813,6 +816,10 @@ bool CodeBlock::finishCreation(VM& vm, ScriptExecutable* ownerExecutable, Unlink
     optimizeAfterWarmUp();
     jitAfterWarmUp();
 
+    // A previous run may already have told us what this code does and how hot it gets.
+    if (UNLIKELY(WarmStartProfile::isEnabled()))
+        WarmStartProfile::singleton().seed(this);
+
     // If the concurrent thread will want the code block's hash, then compute it here
     // synchronously.
     if (Options::alwaysComputeHash())
@@ -1004,6 +1011,9 @@ bool CodeBlock::shouldVisitStrongly(const ConcurrentJSLocker& locker)
     if (Options::forceCodeBlockLiveness())
         return true;
 
+    if (UNLIKELY(Options::useColdCodeEviction()))
+        updateLastExecutionTime(locker);
+
     if (shouldJettisonDueToOldAge(locker))
         return false;
 
@@ -1063,6 +1073,9 @@ bool CodeBlock::shouldJettisonDueToOldAge(const ConcurrentJSLocker&)
 
     if (UNLIKELY(Options::forceCodeBlockToJettisonDueToOldAge()))
         return true;
+
+    if (JITCode::isOptimizingJIT(jitType()) && shouldEvictDueToColdness())
+        return true;
     
     if (timeSinceCreation() < timeToLive(jitType()))
         return false;
@@ -1070,6 +1083,46 @@ bool CodeBlock::shouldJettisonDueToOldAge(const ConcurrentJSLocker&)
     return true;
 }
 
+bool CodeBlock::shouldEvictDueToColdness()
+{
+    if (!m_poisonedVM->heap.shouldEvictColdCode())
+        return false;
+
+    // Code that ran since the previous GC is in use, however short the eviction age is.
+    if (m_didExecuteBeforeThisGC)
+        return false;
+
+    return timeSinceLastExecution() >= Seconds(Options::coldCodeEvictionAge());
+}
+
+void CodeBlock::updateLastExecutionTime(const ConcurrentJSLocker&)
+{
+    // Optimized code tells us that it ran through m_didExecuteSinceLastGC. Baseline code
+    // already counts its executions towards tiering up, so we just watch that count move.
+    // Either way we only notice at GC time, which is precise enough to tell code that runs
+    // from code that has not run for many seconds. A CodeBlock may be visited more than once
+    // per GC, so only the first visit of each full GC consumes the flag.
+    HeapVersion markingVersion = m_poisonedVM->heap.objectSpace().markingVersion();
+    if (m_lastExecutionUpdateVersion == markingVersion)
+        return;
+    m_lastExecutionUpdateVersion = markingVersion;
+
+    bool didExecute = m_didExecuteSinceLastGC;
+    m_didExecuteSinceLastGC = 0;
+
+    if (jitType() == JITCode::BaselineJIT) {
+        double count = m_jitExecuteCounter.count();
+        if (count != m_lastObservedExecuteCount) {
+            m_lastObservedExecuteCount = count;
+            didExecute = true;
+        }
+    }
+
+    m_didExecuteBeforeThisGC = didExecute;
+    if (didExecute)
+        m_lastExecutionTime = MonotonicTime::now();
+}
+
 #if ENABLE(DFG_JIT)
 static bool shouldMarkTransition(DFG::WeakReferenceTransition& transition)
 {
@@ -1167,6 +1220,10 @@ void CodeBlock::determineLiveness(const ConcurrentJSLocker&, SlotVisitor& visito
     // isMarked check doesn't protect us.
     if (!JITCode::isOptimizingJIT(jitType()))
         return;
+
+    // Cold code is evicted even though everything it weakly depends on is still alive.
+    if (UNLIKELY(Options::useColdCodeEviction()) && shouldEvictDueToColdness())
+        return;
     
     DFG::CommonData* dfgCommon = m_jitCode->dfgCommon();
     // Now check all of our weak references. If all of them are live, then we
@@ -1356,16 +1413,28 @@ void CodeBlock::finalizeBaselineJITInlineCaches()
     for (auto iter = callLinkInfosBegin(); !!iter; ++iter)
         (*iter)->visitWeak(*vm());
 
+    // Stubs of code that has gone cold hold on to executable memory that we need back. If the
+    // code does run again, it will just build new ones.
+    bool shouldEvictStubs = jitType() == JITCode::BaselineJIT && shouldEvictDueToColdness();
+
     for (auto iter = m_stubInfos.begin(); !!iter; ++iter) {
         StructureStubInfo& stubInfo = **iter;
+        if (shouldEvictStubs && stubInfo.cacheType == CacheType::Stub) {
+            stubInfo.reset(this);
+            continue;
+        }
         stubInfo.visitWeakReferences(this);
     }
 #endif
 }
 
-void CodeBlock::finalizeUnconditionally(VM&)
+void CodeBlock::finalizeUnconditionally(VM& vm)
 {
     updateAllPredictions();
+
+    forEachObjectAllocationProfile([&](ObjectAllocationProfile& profile) {
+        profile.updateSurvivalStatistics(vm);
+    });
     
     if (JITCode::couldBeInterpreted(jitType()))
         finalizeLLIntInlineCaches();
@@ -440,6 +440,7 @@ public:
     template<typename Functor> void forEachArrayProfile(const Functor&);
     template<typename Functor> void forEachArrayAllocationProfile(const Functor&);
     template<typename Functor> void forEachObjectAllocationProfile(const Functor&);
+    template<typename Functor> void forEachArithProfile(const Functor&);
     template<typename Functor> void forEachLLIntCallLinkInfo(const Functor&);
 
     RareCaseProfile* addRareCaseProfile(int bytecodeOffset);
@@ -736,6 +737,10 @@ public:
 
     static ptrdiff_t offsetOfOSRExitCounter() { return OBJECT_OFFSETOF(CodeBlock, m_osrExitCounter); }
 
+    // Optimized code stores to this on entry when cold code eviction is enabled, so that GC
+    // can tell which optimized CodeBlocks are still in use.
+    uint8_t* addressOfDidExecuteSinceLastGC() { return &m_didExecuteSinceLastGC; }
+
     uint32_t adjustedExitCountThreshold(uint32_t desiredThreshold);
     uint32_t exitCountThresholdForReoptimization();
     uint32_t exitCountThresholdForReoptimizationFromLoop();
@@ -903,6 +908,8 @@ private:
     bool shouldVisitStrongly(const ConcurrentJSLocker&);
     bool shouldJettisonDueToWeakReference();
     bool shouldJettisonDueToOldAge(const ConcurrentJSLocker&);
+    bool shouldEvictDueToColdness();
+    void updateLastExecutionTime(const ConcurrentJSLocker&);
     
     void propagateTransitions(const ConcurrentJSLocker&, SlotVisitor&);
     void determineLiveness(const ConcurrentJSLocker&, SlotVisitor&);
@@ -920,6 +927,12 @@ private:
         return MonotonicTime::now() - m_creationTime;
     }
 
+    // Only as precise as the GCs that notice the execution: see updateLastExecutionTime().
+    Seconds timeSinceLastExecution()
+    {
+        return MonotonicTime::now() - m_lastExecutionTime;
+    }
+
     void createRareDataIfNecessary()
     {
         if (!m_rareData)
@@ -1007,6 +1020,11 @@ private:
     RefPtr<MetadataTable> m_metadata;
 
     MonotonicTime m_creationTime;
+    MonotonicTime m_lastExecutionTime;
+    double m_lastObservedExecuteCount { 0 };
+    uint8_t m_didExecuteSinceLastGC { 0 };
+    bool m_didExecuteBeforeThisGC { false };
+    HeapVersion m_lastExecutionUpdateVersion { MarkedSpace::nullVersion };
 
     std::unique_ptr<RareData> m_rareData;
 };
@@ -92,6 +92,19 @@ void CodeBlock::forEachObjectAllocationProfile(const Functor& func)
     }
 }
 
+template<typename Functor>
+void CodeBlock::forEachArithProfile(const Functor& func)
+{
+    if (m_metadata) {
+#define VISIT(__op) \
+    m_metadata->forEach<__op>([&] (auto& metadata) { func(metadata.arithProfile); });
+
+        FOR_EACH_OPCODE_WITH_ARITH_PROFILE(VISIT)
+
+#undef VISIT
+    }
+}
+
 template<typename Functor>
 void CodeBlock::forEachLLIntCallLinkInfo(const Functor& func)
 {
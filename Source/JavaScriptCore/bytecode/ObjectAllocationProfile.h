@@ -66,6 +66,14 @@ public:
     }
     unsigned inlineCapacity() { return m_inlineCapacity; }
 
+    bool shouldPretenure() const { return m_shouldPretenure; }
+
+    // Called by the slow paths with each object they allocate for this profile. The owner is the
+    // cell that holds this profile.
+    JSObject* didAllocate(VM&, JSCell* owner, JSObject*);
+
+    // Called when our owner is finalized at the end of a collection.
+    void updateSurvivalStatistics(VM&);
 
     void clear()
     {
@@ -73,6 +81,10 @@ public:
         m_structure.clear();
         m_prototype.clear();
         m_inlineCapacity = 0;
+        m_lastAllocation = nullptr;
+        m_numberOfSamples = 0;
+        m_numberOfSurvivors = 0;
+        m_shouldPretenure = false;
         ASSERT(isNull());
     }
 
@@ -89,6 +101,13 @@ private:
     WriteBarrier<Structure> m_structure;
     WriteBarrier<JSObject> m_prototype;
     unsigned m_inlineCapacity;
+
+    // We sample the last object allocated between collections to find out whether objects from
+    // this site tend to survive.
+    JSObject* m_lastAllocation { nullptr };
+    uint16_t m_numberOfSamples { 0 };
+    uint16_t m_numberOfSurvivors { 0 };
+    bool m_shouldPretenure { false };
 };
 
 } // namespace JSC
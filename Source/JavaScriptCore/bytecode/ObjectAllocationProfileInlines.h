@@ -142,6 +142,48 @@ ALWAYS_INLINE void ObjectAllocationProfile::initializeProfile(VM& vm, JSGlobalOb
     m_inlineCapacity = inlineCapacity;
 }
 
+ALWAYS_INLINE JSObject* ObjectAllocationProfile::didAllocate(VM& vm, JSCell* owner, JSObject* object)
+{
+    if (!Options::usePretenuring())
+        return object;
+
+    if (m_shouldPretenure)
+        vm.heap.tryPretenure(object);
+
+    // The sample is only safe to look at before the collection after it was taken has swept, so
+    // make sure that collection finalizes our owner.
+    if (!m_lastAllocation)
+        vm.heap.writeBarrier(owner);
+    m_lastAllocation = object;
+    return object;
+}
+
+inline void ObjectAllocationProfile::updateSurvivalStatistics(VM& vm)
+{
+    JSObject* lastAllocation = m_lastAllocation;
+    if (!lastAllocation)
+        return;
+    m_lastAllocation = nullptr;
+
+    // Pretenured objects are born marked, so only a full collection can tell us if they would
+    // have survived by themselves.
+    if (m_shouldPretenure && vm.heap.collectionScope() != CollectionScope::Full)
+        return;
+
+    // Decay old samples so that a site that changes behavior gets reclassified.
+    if (m_numberOfSamples == std::numeric_limits<uint16_t>::max()) {
+        m_numberOfSamples /= 2;
+        m_numberOfSurvivors /= 2;
+    }
+    m_numberOfSamples++;
+    if (Heap::isMarked(lastAllocation))
+        m_numberOfSurvivors++;
+
+    if (m_numberOfSamples < Options::pretenuringMinimumSampleCount())
+        return;
+    m_shouldPretenure = m_numberOfSurvivors >= Options::pretenuringSurvivalRateThreshold() * m_numberOfSamples;
+}
+
 ALWAYS_INLINE unsigned ObjectAllocationProfile::possibleDefaultPropertyCount(VM& vm, JSObject* prototype)
 {
     if (prototype == prototype->globalObject(vm)->objectPrototype())
@@ -135,6 +135,13 @@ IGNORE_WARNINGS_END
 #define FOR_EACH_OPCODE_WITH_OBJECT_ALLOCATION_PROFILE(macro) \
     macro(OpNewObject) \
 
+#define FOR_EACH_OPCODE_WITH_ARITH_PROFILE(macro) \
+    macro(OpNegate) \
+    macro(OpAdd) \
+    macro(OpMul) \
+    macro(OpSub) \
+    macro(OpDiv) \
+
 #define FOR_EACH_OPCODE_WITH_LLINT_CALL_LINK_INFO(macro) \
     macro(OpCall) \
     macro(OpTailCall) \
@@ -36,6 +36,7 @@
 #include "JITOperations.h"
 #include "JSCInlines.h"
 #include "LinkBuffer.h"
+#include "SharedJITStubSet.h"
 #include "StructureStubClearingWatchpoint.h"
 #include "StructureStubInfo.h"
 #include "SuperSampler.h"
@@ -478,6 +479,15 @@ AccessGenerationResult PolymorphicAccess::regenerate(
             hasJSGetterSetterCall = true;
     }
 
+    bool doesCalls = false;
+    Vector<JSCell*> cellsToMark;
+    for (auto& entry : cases)
+        doesCalls |= entry->doesCalls(&cellsToMark);
+
+    // A stub that makes calls depends on its call site for exception handling and for the layout
+    // of the stack, so only stubs that make no calls are shared.
+    bool shouldShareStub = Options::useSharedPolymorphicAccessStubs() && SharedJITStubSet::isSupported() && !doesCalls;
+
     if (cases.isEmpty()) {
         // This is super unlikely, but we make it legal anyway.
         state.failAndRepatch.append(jit.jump());
@@ -509,6 +519,16 @@ AccessGenerationResult PolymorphicAccess::regenerate(
         state.failAndRepatch.append(binarySwitch.fallThrough());
     }
 
+    if (shouldShareStub) {
+        RefPtr<JITStubRoutine> sharedStubRoutine;
+        MacroAssemblerCodeRef<JITStubRoutinePtrTag> code = linkSharedStub(state, codeBlock, cases, sharedStubRoutine);
+        if (!code)
+            return AccessGenerationResult::GaveUp;
+        return finishRegeneration(
+            state, WTFMove(cases), createJITStubRoutine(code, vm, codeBlock, false, cellsToMark, nullptr, CallSiteIndex()),
+            WTFMove(sharedStubRoutine), generatedFinalCode);
+    }
+
     if (!state.failAndIgnore.empty()) {
         state.failAndIgnore.link(&jit);
         
@@ -596,17 +616,112 @@ AccessGenerationResult PolymorphicAccess::regenerate(
         codeBlock, linkBuffer, JITStubRoutinePtrTag,
         "%s", toCString("Access stub for ", *codeBlock, " ", stubInfo.codeOrigin, " with return point ", successLabel, ": ", listDump(cases)).data());
 
-    bool doesCalls = false;
-    Vector<JSCell*> cellsToMark;
-    for (auto& entry : cases)
-        doesCalls |= entry->doesCalls(&cellsToMark);
-    
-    m_stubRoutine = createJITStubRoutine(code, vm, codeBlock, doesCalls, cellsToMark, codeBlockThatOwnsExceptionHandlers, callSiteIndexForExceptionHandling);
+    return finishRegeneration(
+        state, WTFMove(cases), createJITStubRoutine(code, vm, codeBlock, doesCalls, cellsToMark, codeBlockThatOwnsExceptionHandlers, callSiteIndexForExceptionHandling),
+        nullptr, generatedFinalCode);
+}
+
+MacroAssemblerCodeRef<JITStubRoutinePtrTag> PolymorphicAccess::linkSharedStub(
+    AccessGenerationState& state, CodeBlock* codeBlock, const ListType& cases, RefPtr<JITStubRoutine>& sharedStubRoutine)
+{
+    VM& vm = state.m_vm;
+    CCallHelpers& jit = *state.jit;
+    StructureStubInfo& stubInfo = *state.stubInfo;
+
+    // The shared body cannot know which inline cache it serves, so this inline cache enters it
+    // through a thunk that near calls it. The body returns to the thunk's jump to the done location
+    // on success, one jump further to the jump to the slow path on failAndRepatch, and one jump
+    // further still on failAndIgnore, where the thunk bumps this inline cache's countdown.
+    CCallHelpers thunkJit(codeBlock);
+    CCallHelpers::Call callToSharedStub = thunkJit.nearCall();
+    CCallHelpers::Label returnLabel = thunkJit.label();
+    CCallHelpers::Jump done = thunkJit.jump();
+    CCallHelpers::Label failAndRepatchLabel = thunkJit.label();
+    CCallHelpers::JumpList slowPath;
+    slowPath.append(thunkJit.jump());
+    CCallHelpers::Label failAndIgnoreLabel = thunkJit.label();
+    thunkJit.pushToSave(state.scratchGPR);
+#if CPU(X86_64)
+    thunkJit.move(CCallHelpers::TrustedImmPtr(&stubInfo.countdown), state.scratchGPR);
+    thunkJit.add8(CCallHelpers::TrustedImm32(1), CCallHelpers::Address(state.scratchGPR));
+#else
+    thunkJit.load8(&stubInfo.countdown, state.scratchGPR);
+    thunkJit.add32(CCallHelpers::TrustedImm32(1), state.scratchGPR);
+    thunkJit.store8(state.scratchGPR, &stubInfo.countdown);
+#endif
+    thunkJit.popToRestore(state.scratchGPR);
+    slowPath.append(thunkJit.jump());
+
+    unsigned failAndRepatchOffset = thunkJit.differenceBetween(returnLabel, failAndRepatchLabel);
+    unsigned failAndIgnoreOffset = thunkJit.differenceBetween(returnLabel, failAndIgnoreLabel);
+
+    state.success.link(&jit);
+    jit.ret();
+
+    if (!state.failAndIgnore.empty()) {
+        state.failAndIgnore.link(&jit);
+        if (state.allocator->didReuseRegisters())
+            state.restoreScratch();
+        SharedJITStubSet::emitReturnWithOffset(jit, failAndIgnoreOffset);
+    }
+
+    state.failAndRepatch.link(&jit);
+    if (state.allocator->didReuseRegisters())
+        state.restoreScratch();
+    SharedJITStubSet::emitReturnWithOffset(jit, failAndRepatchOffset);
+
+    CString key = SharedJITStubSet::keyFor(jit);
+    RefPtr<JITStubRoutine> sharedStub = vm.sharedJITStubs->find(key);
+    if (!sharedStub) {
+        LinkBuffer linkBuffer(jit, codeBlock, JITCompilationCanFail);
+        if (linkBuffer.didFailToAllocate()) {
+            if (PolymorphicAccessInternal::verbose)
+                dataLog("Did fail to allocate.\n");
+            return { };
+        }
+
+        MacroAssemblerCodeRef<JITStubRoutinePtrTag> sharedCode = FINALIZE_CODE_FOR(
+            codeBlock, linkBuffer, JITStubRoutinePtrTag,
+            "%s", toCString("Shared access stub ", key, ": ", listDump(cases)).data());
+        Ref<SharedJITStubRoutine> routine = adoptRef(*new SharedJITStubRoutine(sharedCode, vm, *vm.sharedJITStubs, key));
+        vm.sharedJITStubs->add(routine.get());
+        sharedStub = WTFMove(routine);
+    }
+
+    LinkBuffer linkBuffer(thunkJit, codeBlock, JITCompilationCanFail);
+    if (linkBuffer.didFailToAllocate()) {
+        if (PolymorphicAccessInternal::verbose)
+            dataLog("Did fail to allocate.\n");
+        return { };
+    }
+
+    ASSERT(linkBuffer.offsetOf(failAndRepatchLabel) - linkBuffer.offsetOf(returnLabel) == failAndRepatchOffset);
+    ASSERT(linkBuffer.offsetOf(failAndIgnoreLabel) - linkBuffer.offsetOf(returnLabel) == failAndIgnoreOffset);
+
+    CodeLocationLabel<JSInternalPtrTag> successLabel = stubInfo.doneLocation();
+    linkBuffer.link(callToSharedStub, FunctionPtr<JITStubRoutinePtrTag>(sharedStub->code().code()));
+    linkBuffer.link(done, successLabel);
+    linkBuffer.link(slowPath, stubInfo.slowPathStartLocation());
+
+    if (PolymorphicAccessInternal::verbose)
+        dataLog(FullCodeOrigin(codeBlock, stubInfo.codeOrigin), ": Sharing polymorphic access stub ", key, " for ", listDump(cases), "\n");
+
+    sharedStubRoutine = WTFMove(sharedStub);
+    return FINALIZE_CODE_FOR(
+        codeBlock, linkBuffer, JITStubRoutinePtrTag,
+        "%s", toCString("Access stub for ", *codeBlock, " ", stubInfo.codeOrigin, " with return point ", successLabel, " sharing ", key, ": ", listDump(cases)).data());
+}
+
+AccessGenerationResult PolymorphicAccess::finishRegeneration(
+    AccessGenerationState& state, ListType&& cases, Ref<JITStubRoutine>&& stubRoutine, RefPtr<JITStubRoutine>&& sharedStubRoutine, bool generatedFinalCode)
+{
+    m_stubRoutine = WTFMove(stubRoutine);
+    m_sharedStubRoutine = WTFMove(sharedStubRoutine);
     m_watchpoints = WTFMove(state.watchpoints);
     if (!state.weakReferences.isEmpty())
         m_weakReferences = std::make_unique<Vector<WriteBarrier<JSCell>>>(WTFMove(state.weakReferences));
     if (PolymorphicAccessInternal::verbose)
-        dataLog("Returning: ", code.code(), "\n");
+        dataLog("Returning: ", m_stubRoutine->code().code(), "\n");
     
     m_list = WTFMove(cases);
     
@@ -616,7 +731,7 @@ AccessGenerationResult PolymorphicAccess::regenerate(
     else
         resultKind = AccessGenerationResult::GeneratedNewCode;
     
-    return AccessGenerationResult(resultKind, code.code());
+    return AccessGenerationResult(resultKind, m_stubRoutine->code().code());
 }
 
 void PolymorphicAccess::aboutToDie()
@@ -179,8 +179,13 @@ private:
         const GCSafeConcurrentJSLocker&, VM&, std::unique_ptr<WatchpointsOnStructureStubInfo>&, CodeBlock*, StructureStubInfo&,
         const Identifier&, AccessCase&);
 
+    MacroAssemblerCodeRef<JITStubRoutinePtrTag> linkSharedStub(AccessGenerationState&, CodeBlock*, const ListType&, RefPtr<JITStubRoutine>& sharedStubRoutine);
+    AccessGenerationResult finishRegeneration(AccessGenerationState&, ListType&&, Ref<JITStubRoutine>&&, RefPtr<JITStubRoutine>&& sharedStubRoutine, bool generatedFinalCode);
+
     ListType m_list;
     RefPtr<JITStubRoutine> m_stubRoutine;
+    // When sharing is enabled, m_stubRoutine is only a thunk that calls into this shared stub.
+    RefPtr<JITStubRoutine> m_sharedStubRoutine;
     std::unique_ptr<WatchpointsOnStructureStubInfo> m_watchpoints;
     std::unique_ptr<Vector<WriteBarrier<JSCell>>> m_weakReferences;
 };
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WarmStartProfile.h"
+
+#include "CodeBlock.h"
+#include "CodeBlockInlines.h"
+#include "Options.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace JSC {
+
+static const char* const fileHeader = "// JSC warm start profile, version 1\n";
+
+// Anything bigger than this cannot have come from a real CodeBlock, so the file is corrupt.
+static constexpr unsigned maxProfilesPerEntry = 1 << 24;
+
+bool WarmStartProfile::isEnabled()
+{
+    return Options::warmStartProfileInputFile() || Options::warmStartProfileOutputFile();
+}
+
+WarmStartProfile& WarmStartProfile::singleton()
+{
+    static WarmStartProfile* profile;
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] {
+        profile = new WarmStartProfile;
+    });
+    return *profile;
+}
+
+WarmStartProfile::WarmStartProfile()
+{
+    if (const char* filename = Options::warmStartProfileInputFile())
+        load(filename);
+
+    if (Options::warmStartProfileOutputFile()) {
+        atexit([] {
+            WarmStartProfile::singleton().save();
+        });
+    }
+}
+
+auto WarmStartProfile::keyFor(CodeBlock* codeBlock) -> Key
+{
+    return (static_cast<Key>(codeBlock->hash().hash()) << 32)
+        | (static_cast<Key>(codeBlock->instructionCount() & 0x7fffffff) << 1)
+        | static_cast<Key>(codeBlock->specializationKind() == CodeForConstruct);
+}
+
+void WarmStartProfile::seed(CodeBlock* codeBlock)
+{
+    Key key = keyFor(codeBlock);
+
+    Tier tier;
+    {
+        auto locker = holdLock(m_lock);
+        auto iter = m_entries.find(key);
+        if (iter == m_entries.end())
+            return;
+        const Entry& entry = iter->value;
+        tier = entry.tier;
+
+        // The profiles are only ever visited in the same order for the same bytecode, so a
+        // count mismatch means the entry is for something else that happened to collide.
+        unsigned valueProfileCount = 0;
+        codeBlock->forEachValueProfile([&] (ValueProfile&) { valueProfileCount++; });
+        if (valueProfileCount == entry.valueProfiles.size()) {
+            unsigned index = 0;
+            codeBlock->forEachValueProfile([&] (ValueProfile& profile) {
+                mergeSpeculation(profile.m_prediction, entry.valueProfiles[index++]);
+            });
+        }
+
+        if (!entry.arrayProfiles.isEmpty()) {
+            HashMap<unsigned, ArrayModes, WTF::IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned>> arrayModes;
+            for (auto& pair : entry.arrayProfiles)
+                arrayModes.add(pair.first, pair.second);
+            codeBlock->forEachArrayProfile([&] (ArrayProfile& profile) {
+                auto iter = arrayModes.find(profile.bytecodeOffset());
+                if (iter != arrayModes.end())
+                    profile.observeArrayMode(iter->value);
+            });
+        }
+
+        unsigned arithProfileCount = 0;
+        codeBlock->forEachArithProfile([&] (ArithProfile&) { arithProfileCount++; });
+        if (arithProfileCount == entry.arithProfiles.size()) {
+            unsigned index = 0;
+            codeBlock->forEachArithProfile([&] (ArithProfile& profile) {
+                profile.mergeBits(entry.arithProfiles[index++]);
+            });
+        }
+    }
+
+    if (Options::verboseOSR())
+        dataLog(*codeBlock, ": Seeding from warm start profile, previously reached tier ", static_cast<unsigned>(tier), ".\n");
+
+    if (tier >= Tier::Baseline)
+        codeBlock->jitSoon();
+    if (tier >= Tier::DFG)
+        codeBlock->optimizeSoon();
+}
+
+void WarmStartProfile::record(CodeBlock* codeBlock, Tier tier)
+{
+    Entry entry;
+    entry.tier = tier;
+    {
+        ConcurrentJSLocker locker(codeBlock->m_lock);
+        codeBlock->forEachValueProfile([&] (ValueProfile& profile) {
+            entry.valueProfiles.append(profile.m_prediction);
+        });
+        codeBlock->forEachArrayProfile([&] (ArrayProfile& profile) {
+            if (ArrayModes modes = profile.observedArrayModes(locker))
+                entry.arrayProfiles.append({ profile.bytecodeOffset(), modes });
+        });
+        codeBlock->forEachArithProfile([&] (ArithProfile& profile) {
+            entry.arithProfiles.append(profile.bits());
+        });
+    }
+
+    Key key = keyFor(codeBlock);
+
+    auto locker = holdLock(m_lock);
+    auto result = m_entries.add(key, Entry());
+    if (!result.isNewEntry)
+        entry.tier = std::max(entry.tier, result.iterator->value.tier);
+    result.iterator->value = WTFMove(entry);
+}
+
+auto WarmStartProfile::recordedTier(CodeBlock* codeBlock) -> Tier
+{
+    Key key = keyFor(codeBlock);
+
+    auto locker = holdLock(m_lock);
+    auto iter = m_entries.find(key);
+    if (iter == m_entries.end())
+        return Tier::LLInt;
+    return iter->value.tier;
+}
+
+void WarmStartProfile::load(const char* filename)
+{
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        dataLogF("Failed to open warm start profile %s.\n", filename);
+        return;
+    }
+
+    char buffer[BUFSIZ];
+    if (!fgets(buffer, sizeof(buffer), file) || strcmp(buffer, fileHeader)) {
+        dataLogF("Ignoring warm start profile %s: unrecognized header.\n", filename);
+        fclose(file);
+        return;
+    }
+
+    auto readCount = [&] (unsigned& count) {
+        return fscanf(file, "%u", &count) == 1 && count <= maxProfilesPerEntry;
+    };
+
+    auto locker = holdLock(m_lock);
+    Key key;
+    unsigned tier;
+    while (fscanf(file, "%" SCNx64 " %u", &key, &tier) == 2) {
+        Entry entry;
+        bool ok = tier <= static_cast<unsigned>(Tier::FTL);
+        entry.tier = static_cast<Tier>(tier);
+
+        unsigned count = 0;
+        ok = ok && readCount(count);
+        for (unsigned i = 0; ok && i < count; ++i) {
+            SpeculatedType prediction;
+            ok = fscanf(file, "%" SCNx64, &prediction) == 1;
+            entry.valueProfiles.append(prediction);
+        }
+
+        ok = ok && readCount(count);
+        for (unsigned i = 0; ok && i < count; ++i) {
+            unsigned bytecodeOffset;
+            ArrayModes modes;
+            ok = fscanf(file, "%u:%x", &bytecodeOffset, &modes) == 2;
+            entry.arrayProfiles.append({ bytecodeOffset, modes });
+        }
+
+        ok = ok && readCount(count);
+        for (unsigned i = 0; ok && i < count; ++i) {
+            uint32_t bits;
+            ok = fscanf(file, "%" SCNx32, &bits) == 1;
+            entry.arithProfiles.append(bits);
+        }
+
+        if (!ok) {
+            dataLogF("Ignoring the rest of warm start profile %s: malformed entry.\n", filename);
+            break;
+        }
+        m_entries.set(key, WTFMove(entry));
+    }
+
+    if (Options::verboseOSR())
+        dataLogF("Loaded %u entries from warm start profile %s.\n", m_entries.size(), filename);
+
+    fclose(file);
+}
+
+void WarmStartProfile::save()
+{
+    const char* filename = Options::warmStartProfileOutputFile();
+    if (!filename)
+        return;
+
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        dataLogF("Failed to open warm start profile %s for writing.\n", filename);
+        return;
+    }
+
+    auto locker = holdLock(m_lock);
+    fputs(fileHeader, file);
+    for (auto& pair : m_entries) {
+        const Entry& entry = pair.value;
+        fprintf(file, "%" PRIx64 " %u", pair.key, static_cast<unsigned>(entry.tier));
+        fprintf(file, " %zu", entry.valueProfiles.size());
+        for (SpeculatedType prediction : entry.valueProfiles)
+            fprintf(file, " %" PRIx64, prediction);
+        fprintf(file, " %zu", entry.arrayProfiles.size());
+        for (auto& arrayProfile : entry.arrayProfiles)
+            fprintf(file, " %u:%x", arrayProfile.first, arrayProfile.second);
+        fprintf(file, " %zu", entry.arithProfiles.size());
+        for (uint32_t bits : entry.arithProfiles)
+            fprintf(file, " %" PRIx32, bits);
+        fputc('\n', file);
+    }
+
+    if (fclose(file))
+        dataLogF("Failed to close warm start profile %s: %s\n", filename, strerror(errno));
+}
+
+} // namespace JSC
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "ArrayProfile.h"
+#include "SpeculatedType.h"
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class CodeBlock;
+
+// Remembers, across runs, what each function's profiles looked like and how far it tiered
+// up. Entries are keyed by the CodeBlockHash of the source, the specialization kind and the
+// instruction count, so an edited function simply misses. On the next run the recorded
+// observations are merged into the new CodeBlock's profiles and its tier-up counters are
+// set as if it had already warmed up. Merging only ever adds observations, so a stale
+// entry can make us speculate less but never wrongly.
+class WarmStartProfile {
+    WTF_MAKE_NONCOPYABLE(WarmStartProfile);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    enum class Tier : uint8_t {
+        LLInt,
+        Baseline,
+        DFG,
+        FTL
+    };
+
+    static bool isEnabled();
+    static WarmStartProfile& singleton();
+
+    // These must be called on the main thread, since they need the CodeBlock's hash.
+    void seed(CodeBlock*);
+    void record(CodeBlock*, Tier);
+    Tier recordedTier(CodeBlock*);
+
+    // Called at exit when warmStartProfileOutputFile is set. Clients may also call it
+    // whenever they want a snapshot on disk.
+    JS_EXPORT_PRIVATE void save();
+
+private:
+    WarmStartProfile();
+
+    struct Entry {
+        Tier tier { Tier::LLInt };
+        Vector<SpeculatedType> valueProfiles;
+        Vector<std::pair<unsigned, ArrayModes>> arrayProfiles;
+        Vector<uint32_t> arithProfiles;
+    };
+
+    using Key = uint64_t;
+    static Key keyFor(CodeBlock*);
+
+    void load(const char* filename);
+
+    Lock m_lock;
+    HashMap<Key, Entry, IntHash<Key>, WTF::UnsignedWithZeroKeyHashTraits<Key>> m_entries;
+};
+
+} // namespace JSC
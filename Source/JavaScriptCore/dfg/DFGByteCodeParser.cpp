@@ -4828,9 +4828,11 @@ void ByteCodeParser::parseBlock(unsigned limit)
 
         case op_new_object: {
             auto bytecode = currentInstruction->as<OpNewObject>();
+            ObjectAllocationProfile& profile = bytecode.metadata(codeBlock).objectAllocationProfile;
             set(bytecode.dst,
                 addToGraph(NewObject,
-                    OpInfo(m_graph.registerStructure(bytecode.metadata(codeBlock).objectAllocationProfile.structure()))));
+                    OpInfo(m_graph.registerStructure(profile.structure())),
+                    OpInfo(profile.shouldPretenure() ? &profile : nullptr)));
             NEXT_OPCODE(op_new_object);
         }
             
@@ -40,6 +40,7 @@
 #include "Options.h"
 #include "ThunkGenerators.h"
 #include "TypeProfilerLog.h"
+#include "WarmStartProfile.h"
 #include <wtf/Atomics.h>
 #include <wtf/NeverDestroyed.h>
 
@@ -86,6 +87,9 @@ static CompilationResult compileImpl(
     
     if (logCompilationChanges(mode))
         dataLog("DFG(Driver) compiling ", *codeBlock, " with ", mode, ", number of instructions = ", codeBlock->instructionCount(), "\n");
+
+    if (UNLIKELY(WarmStartProfile::isEnabled()))
+        WarmStartProfile::singleton().record(codeBlock->alternative(), isFTL(mode) ? WarmStartProfile::Tier::FTL : WarmStartProfile::Tier::DFG);
     
     // Make sure that any stubs that the DFG is going to use are initialized. We want to
     // make sure that all JIT code generation does finalization on the main thread.
@@ -131,6 +131,8 @@ void JITCompiler::compileEntryExecutionFlag()
     if (m_graph.m_plan.canTierUpAndOSREnter())
         store8(TrustedImm32(0), &m_jitCode->neverExecutedEntry);
 #endif // ENABLE(FTL_JIT)
+    if (Options::useColdCodeEviction())
+        store8(TrustedImm32(1), m_codeBlock->addressOfDidExecuteSinceLastGC());
 }
 
 void JITCompiler::compileBody()
@@ -34,6 +34,7 @@
 #include "DFGPlan.h"
 #include "JSCInlines.h"
 #include "ProfilerDatabase.h"
+#include "WarmStartProfile.h"
 
 namespace JSC { namespace DFG {
 
@@ -87,6 +88,9 @@ void JITFinalizer::finalizeCommon()
 
 #if ENABLE(FTL_JIT)
     m_jitCode->optimizeAfterWarmUp(m_plan.codeBlock());
+    if (UNLIKELY(WarmStartProfile::isEnabled())
+        && WarmStartProfile::singleton().recordedTier(m_plan.codeBlock()->baselineVersion()) == WarmStartProfile::Tier::FTL)
+        m_jitCode->optimizeSoon(m_plan.codeBlock());
 #endif // ENABLE(FTL_JIT)
 
     if (UNLIKELY(m_plan.compilation()))
@@ -1885,6 +1885,14 @@ public:
         ASSERT(hasStructure());
         return m_opInfo.asRegisteredStructure();
     }
+
+    // Non-null if this NewObject should allocate an object that looks like it already survived a
+    // collection.
+    ObjectAllocationProfile* pretenuringProfile()
+    {
+        ASSERT(op() == NewObject);
+        return m_opInfo2.as<ObjectAllocationProfile*>();
+    }
     
     bool hasStorageAccessData()
     {
@@ -12600,6 +12600,16 @@ void SpeculativeJIT::compileCreateThis(Node* node)
 
 void SpeculativeJIT::compileNewObject(Node* node)
 {
+    if (ObjectAllocationProfile* profile = node->pretenuringProfile()) {
+        flushRegisters();
+        GPRFlushedCallResult result(this);
+        GPRReg resultGPR = result.gpr();
+        callOperation(operationNewObjectWithProfile, resultGPR, node->structure(), profile, TrustedImmPtr::weakPointer(m_jit.graph(), m_jit.graph().baselineCodeBlockFor(node->origin.semantic)));
+        m_jit.exceptionCheck();
+        cellResult(resultGPR, node);
+        return;
+    }
+
     GPRTemporary result(this);
     GPRTemporary allocator(this);
     GPRTemporary scratch(this);
@@ -320,6 +320,14 @@ private:
             
             switch (m_node->op()) {
             case NewObject:
+                // A pretenured object is born black, so stores into it always need a barrier.
+                if (m_node->pretenuringProfile()) {
+                    m_node->setEpoch(Epoch());
+                    break;
+                }
+                m_node->setEpoch(m_currentEpoch);
+                break;
+
             case NewArray:
             case NewArrayWithSize:
             case NewArrayBuffer:
@@ -245,6 +245,9 @@ public:
         // that would cause it to always get collected.
         m_out.storePtr(m_out.constIntPtr(bitwise_cast<intptr_t>(codeBlock())), addressFor(CallFrameSlot::codeBlock));
 
+        if (Options::useColdCodeEviction())
+            m_out.store32As8(m_out.int32One, m_out.absolute(codeBlock()->addressOfDidExecuteSinceLastGC()));
+
         VM* vm = &this->vm();
 
         // Stack Overflow Check.
@@ -5589,6 +5592,14 @@ private:
     
     void compileNewObject()
     {
+        if (ObjectAllocationProfile* profile = m_node->pretenuringProfile()) {
+            CodeBlock* baselineCodeBlock = m_ftlState.graph.baselineCodeBlockFor(m_node->origin.semantic);
+            setJSValue(vmCall(
+                pointerType(), m_out.operation(operationNewObjectWithProfile), m_callFrame,
+                weakStructure(m_node->structure()), m_out.constIntPtr(profile), weakPointer(baselineCodeBlock)));
+            return;
+        }
+
         setJSValue(allocateObject(m_node->structure()));
         mutatorFence();
     }
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "GCTelemetry.h"
+
+#include "Options.h"
+#include <wtf/CPUTime.h>
+#include <wtf/CommaPrinter.h>
+#include <wtf/StringPrintStream.h>
+#include <wtf/Threading.h>
+
+namespace JSC {
+
+void GCTelemetryRecord::dumpJSON(PrintStream& out) const
+{
+    out.print("{\"scope\":\"", scope, "\"");
+    out.print(",\"startTime\":", startTime.secondsSinceEpoch().milliseconds());
+    out.print(",\"totalTime\":", totalTime.milliseconds());
+    out.print(",\"mutatorStoppedTime\":", mutatorStoppedTime.milliseconds());
+    out.print(",\"maxPauseTime\":", maxPauseTime.milliseconds());
+    out.print(",\"bytesVisited\":", bytesVisited);
+    out.print(",\"constraintSolverIterations\":", constraintSolverIterations);
+    out.print(",\"heapSizeBefore\":", heapSizeBefore);
+    out.print(",\"heapSizeAfter\":", heapSizeAfter);
+    out.print(",\"phases\":{");
+    CommaPrinter comma;
+    for (unsigned i = 0; i < numberOfCollectorPhases; ++i) {
+        CollectorPhase phase = static_cast<CollectorPhase>(i);
+        if (phase == CollectorPhase::NotRunning)
+            continue;
+        out.print(comma, "\"", phase, "\":{\"time\":", phaseTime[i].milliseconds(), ",\"cpuTime\":", phaseCPUTime[i].milliseconds(), "}");
+    }
+    out.print("}}");
+}
+
+GCTelemetry::GCTelemetry()
+{
+    m_records.reserveInitialCapacity(Options::gcTelemetryRecordCount());
+}
+
+void GCTelemetry::didChangePhase(CollectorPhase oldPhase, CollectorPhase newPhase)
+{
+    if (!Options::gcTelemetryRecordCount())
+        return;
+    
+    MonotonicTime now = MonotonicTime::now();
+    Seconds cpuTime = CPUTime::forCurrentThread();
+    WTF::Thread* thread = &WTF::Thread::current();
+    
+    if (oldPhase == CollectorPhase::NotRunning) {
+        m_current = GCTelemetryRecord();
+        m_current.startTime = now;
+    } else {
+        unsigned index = static_cast<unsigned>(oldPhase);
+        m_current.phaseTime[index] += now - m_phaseStartTime;
+        if (thread == m_phaseThread)
+            m_current.phaseCPUTime[index] += cpuTime - m_phaseStartCPUTime;
+    }
+    
+    m_phaseStartTime = now;
+    m_phaseStartCPUTime = cpuTime;
+    m_phaseThread = thread;
+    
+    if (newPhase == CollectorPhase::NotRunning) {
+        m_current.totalTime = now - m_current.startTime;
+        appendRecord(m_current);
+    }
+}
+
+void GCTelemetry::willStartCollection(CollectionScope scope, size_t heapSizeBefore)
+{
+    m_current.scope = scope;
+    m_current.heapSizeBefore = heapSizeBefore;
+}
+
+void GCTelemetry::didStopTheMutator(MonotonicTime time)
+{
+    m_mutatorStopTime = time;
+}
+
+void GCTelemetry::didResumeTheMutator(MonotonicTime time)
+{
+    Seconds pause = time - m_mutatorStopTime;
+    m_current.mutatorStoppedTime += pause;
+    m_current.maxPauseTime = std::max(m_current.maxPauseTime, pause);
+}
+
+void GCTelemetry::didFinishCollection(size_t bytesVisited, size_t heapSizeAfter)
+{
+    m_current.bytesVisited = bytesVisited;
+    m_current.heapSizeAfter = heapSizeAfter;
+}
+
+void GCTelemetry::appendRecord(const GCTelemetryRecord& record)
+{
+    unsigned capacity = Options::gcTelemetryRecordCount();
+    if (!capacity)
+        return;
+    auto locker = holdLock(m_lock);
+    // Once we have wrapped around we keep the buffer at its current size.
+    if (m_records.size() < capacity && !m_nextRecordIndex) {
+        m_records.append(record);
+        return;
+    }
+    m_records[m_nextRecordIndex] = record;
+    m_nextRecordIndex = (m_nextRecordIndex + 1) % m_records.size();
+}
+
+Vector<GCTelemetryRecord> GCTelemetry::records() const
+{
+    auto locker = holdLock(m_lock);
+    Vector<GCTelemetryRecord> result;
+    result.reserveInitialCapacity(m_records.size());
+    for (unsigned i = 0; i < m_records.size(); ++i)
+        result.uncheckedAppend(m_records[(m_nextRecordIndex + i) % m_records.size()]);
+    return result;
+}
+
+void GCTelemetry::dumpJSON(PrintStream& out) const
+{
+    out.print("[");
+    CommaPrinter comma;
+    for (const GCTelemetryRecord& record : records()) {
+        out.print(comma);
+        record.dumpJSON(out);
+    }
+    out.print("]");
+}
+
+String GCTelemetry::json() const
+{
+    StringPrintStream out;
+    dumpJSON(out);
+    return out.toString();
+}
+
+} // namespace JSC
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "CollectionScope.h"
+#include "CollectorPhase.h"
+#include <array>
+#include <wtf/Forward.h>
+#include <wtf/Lock.h>
+#include <wtf/MonotonicTime.h>
+#include <wtf/Seconds.h>
+#include <wtf/Vector.h>
+
+namespace WTF {
+class Thread;
+}
+
+namespace JSC {
+
+static const unsigned numberOfCollectorPhases = static_cast<unsigned>(CollectorPhase::End) + 1;
+
+struct GCTelemetryRecord {
+    CollectionScope scope { CollectionScope::Eden };
+    MonotonicTime startTime;
+    Seconds totalTime;
+    
+    // Wall clock time spent in each phase, indexed by CollectorPhase.
+    std::array<Seconds, numberOfCollectorPhases> phaseTime { };
+    
+    // CPU time used by the thread that had the conn during each phase. This does not include
+    // the parallel marking helpers, and is only counted when a phase begins and ends on the same
+    // thread.
+    std::array<Seconds, numberOfCollectorPhases> phaseCPUTime { };
+    
+    Seconds mutatorStoppedTime;
+    Seconds maxPauseTime;
+    size_t bytesVisited { 0 };
+    unsigned constraintSolverIterations { 0 };
+    size_t heapSizeBefore { 0 };
+    size_t heapSizeAfter { 0 };
+
+    void dumpJSON(PrintStream&) const;
+};
+
+// Keeps a ring buffer of records describing the most recent collections. The Heap feeds this from
+// whichever thread has the conn; embedders may query it from any thread.
+class GCTelemetry {
+    WTF_MAKE_NONCOPYABLE(GCTelemetry);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    GCTelemetry();
+    
+    void didChangePhase(CollectorPhase oldPhase, CollectorPhase newPhase);
+    void willStartCollection(CollectionScope, size_t heapSizeBefore);
+    void didExecuteConstraints() { m_current.constraintSolverIterations++; }
+    void didStopTheMutator(MonotonicTime);
+    void didResumeTheMutator(MonotonicTime);
+    void didFinishCollection(size_t bytesVisited, size_t heapSizeAfter);
+    
+    // Returns the recorded collections, oldest first.
+    JS_EXPORT_PRIVATE Vector<GCTelemetryRecord> records() const;
+    
+    JS_EXPORT_PRIVATE void dumpJSON(PrintStream&) const;
+    JS_EXPORT_PRIVATE String json() const;
+    
+private:
+    void appendRecord(const GCTelemetryRecord&);
+    
+    mutable Lock m_lock;
+    Vector<GCTelemetryRecord> m_records;
+    unsigned m_nextRecordIndex { 0 };
+    
+    // Only touched by whoever has the conn.
+    GCTelemetryRecord m_current;
+    MonotonicTime m_phaseStartTime;
+    Seconds m_phaseStartCPUTime;
+    WTF::Thread* m_phaseThread { nullptr };
+    MonotonicTime m_mutatorStopTime;
+};
+
+} // namespace JSC
@@ -29,6 +29,7 @@
 #include "DFGWorklistInlines.h"
 #include "EdenGCActivityCallback.h"
 #include "Exception.h"
+#include "ExecutableAllocator.h"
 #include "FullGCActivityCallback.h"
 #include "GCActivityCallback.h"
 #include "GCIncomingRefCountedSetInlines.h"
@@ -655,7 +656,7 @@ void Heap::assertMarkStacksEmpty()
     
     forEachSlotVisitor(
         [&] (SlotVisitor& visitor) {
-            if (visitor.isEmpty())
+            if (visitor.isEmpty() && !visitor.hasStealableWork())
                 return;
             
             dataLog("FATAL: Visitor ", RawPointer(&visitor), " is not empty!\n");
@@ -694,6 +695,10 @@ void Heap::beginMarking()
     m_jitStubRoutines->clearMarks();
     m_objectSpace.beginMarking();
     setMutatorShouldBeFenced(true);
+
+    m_shouldEvictColdCode = Options::useColdCodeEviction() && ExecutableAllocator::shouldEvictColdCode();
+    if (m_shouldEvictColdCode && Options::logExecutableAllocation())
+        dataLog("Executable memory is running short, so this GC will evict cold code.\n");
 }
 
 void Heap::removeDeadCompilerWorklistEntries()
@@ -950,6 +955,31 @@ void Heap::deleteUnmarkedCompiledCode()
     m_jitStubRoutines->deleteUnmarkedJettisonedStubRoutines();
 }
 
+bool Heap::tryPretenure(JSObject* object)
+{
+    // Eden collections treat mark bits as sticky, so marking the object now makes it old. Making it
+    // black means that stores into it will take the barrier and put it in the remembered set.
+    ASSERT(object->cellState() == CellState::DefinitelyWhite);
+    
+    if (m_objectSpace.isMarking() || object->isLargeAllocation())
+        return false;
+    
+    // Only the collector can bring stale mark bits up to date.
+    MarkedBlock& block = object->markedBlock();
+    if (block.areMarksStale())
+        return false;
+    
+    // A black object must not point at anything that an eden collection could free, and nobody is
+    // going to visit this object before the next full collection unless it gets stored to.
+    if (object->butterfly() || !isMarked(object->structure(*m_vm)))
+        return false;
+    
+    if (!block.testAndSetMarked(object, Dependency()))
+        block.noteMarked();
+    object->setCellState(CellState::PossiblyBlack);
+    return true;
+}
+
 void Heap::addToRememberedSet(const JSCell* constCell)
 {
     JSCell* cell = const_cast<JSCell*>(constCell);
@@ -1341,6 +1371,7 @@ NEVER_INLINE bool Heap::runFixpointPhase(GCConductor conn)
         // Wondering what this does? Look at Heap::addCoreConstraints(). The DOM and others can also
         // add their own using Heap::addMarkingConstraint().
         bool converged = m_constraintSet->executeConvergence(slotVisitor);
+        m_telemetry.didExecuteConstraints();
         
         // FIXME: The slotVisitor.isEmpty() check is most likely not needed.
         // https://bugs.webkit.org/show_bug.cgi?id=180310
@@ -1574,6 +1605,7 @@ NEVER_INLINE bool Heap::finishChangingPhase(GCConductor conn)
         }
     }
     
+    m_telemetry.didChangePhase(m_currentPhase, m_nextPhase);
     m_currentPhase = m_nextPhase;
     return true;
 }
@@ -1614,6 +1646,7 @@ void Heap::stopThePeriphery(GCConductor conn)
     m_objectSpace.stopAllocating();
     
     m_stopTime = MonotonicTime::now();
+    m_telemetry.didStopTheMutator(m_stopTime);
 }
 
 NEVER_INLINE void Heap::resumeThePeriphery()
@@ -1632,6 +1665,7 @@ NEVER_INLINE void Heap::resumeThePeriphery()
         RELEASE_ASSERT_NOT_REACHED();
     }
     m_worldIsStopped = false;
+    m_telemetry.didResumeTheMutator(MonotonicTime::now());
     
     // FIXME: This could be vastly improved: we want to grab the locks in the order in which they
     // become available. We basically want a lockAny() method that will lock whatever lock is available
@@ -2144,6 +2178,8 @@ void Heap::willStartCollection()
         m_sizeBeforeLastEdenCollect = m_sizeAfterLastCollect + m_bytesAllocatedThisCycle;
     }
 
+    m_telemetry.willStartCollection(*m_collectionScope, m_sizeAfterLastCollect + m_bytesAllocatedThisCycle);
+
     if (m_edenActivityCallback)
         m_edenActivityCallback->willCollect();
 
@@ -2311,6 +2347,8 @@ void Heap::didFinishCollection()
     if (UNLIKELY(m_verifier))
         m_verifier->endGC();
 
+    m_telemetry.didFinishCollection(bytesVisited(), m_sizeAfterLastCollect);
+
     RELEASE_ASSERT(m_collectionScope);
     m_lastCollectionScope = m_collectionScope;
     m_collectionScope = WTF::nullopt;
@@ -29,6 +29,7 @@
 #include "GCConductor.h"
 #include "GCIncomingRefCountedSet.h"
 #include "GCRequest.h"
+#include "GCTelemetry.h"
 #include "HandleSet.h"
 #include "HeapFinalizerCallback.h"
 #include "HeapObserver.h"
@@ -66,6 +67,7 @@ class JITStubRoutine;
 class JITStubRoutineSet;
 class JSCell;
 class JSImmutableButterfly;
+class JSObject;
 class JSValue;
 class LLIntOffsetsExtractor;
 class MachineThreads;
@@ -131,6 +133,10 @@ public:
     // Take this if you know that from->cellState() < barrierThreshold.
     JS_EXPORT_PRIVATE void writeBarrierSlowPath(const JSCell* from);
 
+    // Makes a freshly allocated object look like it survived the last collection. Returns false if
+    // that cannot be done right now, in which case the object stays in eden.
+    bool tryPretenure(JSObject*);
+
     Heap(VM*, HeapType);
     ~Heap();
     void lastChanceToFinalize();
@@ -170,6 +176,9 @@ public:
     
     bool isShuttingDown() const { return m_isShuttingDown; }
 
+    // Decided once per collection, when marking begins, from how much executable memory is left.
+    bool shouldEvictColdCode() const { return m_shouldEvictColdCode; }
+
     JS_EXPORT_PRIVATE bool isHeapSnapshotting() const;
 
     JS_EXPORT_PRIVATE void sweepSynchronously();
@@ -378,6 +387,9 @@ public:
     
     Seconds totalGCTime() const { return m_totalGCTime; }
 
+    // Statistics about the most recent collections.
+    const GCTelemetry& telemetry() const { return m_telemetry; }
+
     HashMap<JSImmutableButterfly*, JSString*> immutableButterflyToStringCache;
 
 private:
@@ -616,6 +628,7 @@ private:
     
     bool m_isSafeToCollect;
     bool m_isShuttingDown { false };
+    bool m_shouldEvictColdCode { false };
 
     bool m_mutatorShouldBeFenced { Options::forceFencedBarrier() };
     unsigned m_barrierThreshold { Options::forceFencedBarrier() ? tautologicalThreshold : blackThreshold };
@@ -718,6 +731,7 @@ private:
     MonotonicTime m_lastGCEndTime;
     MonotonicTime m_currentGCStartTime;
     Seconds m_totalGCTime;
+    GCTelemetry m_telemetry;
     
     uintptr_t m_barriersExecuted { 0 };
     
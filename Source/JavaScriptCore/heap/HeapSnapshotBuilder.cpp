@@ -327,6 +327,24 @@ String HeapSnapshotBuilder::json()
     return json([] (const HeapSnapshotNode&) { return true; });
 }
 
+String HeapSnapshotBuilder::json(Function<bool (const HeapSnapshotNode&)> allowNodeCallback)
+{
+    StringBuilder json;
+    serializeJSON(json, nullptr, allowNodeCallback);
+    return json.toString();
+}
+
+void HeapSnapshotBuilder::writeJSON(const JSONChunkSink& sink)
+{
+    writeJSON(sink, [] (const HeapSnapshotNode&) { return true; });
+}
+
+void HeapSnapshotBuilder::writeJSON(const JSONChunkSink& sink, Function<bool (const HeapSnapshotNode&)> allowNodeCallback)
+{
+    StringBuilder json;
+    serializeJSON(json, &sink, allowNodeCallback);
+}
+
 void HeapSnapshotBuilder::setLabelForCell(JSCell* cell, const String& label)
 {
     m_cellLabels.set(cell, label);
@@ -348,7 +366,7 @@ String HeapSnapshotBuilder::descriptionForCell(JSCell *cell) const
     return emptyString();
 }
 
-String HeapSnapshotBuilder::json(Function<bool (const HeapSnapshotNode&)> allowNodeCallback)
+void HeapSnapshotBuilder::serializeJSON(StringBuilder& json, const JSONChunkSink* sink, Function<bool (const HeapSnapshotNode&)>& allowNodeCallback)
 {
     VM& vm = m_profiler.vm();
     DeferGCForAWhile deferGC(vm.heap);
@@ -370,7 +388,16 @@ String HeapSnapshotBuilder::json(Function<bool (const HeapSnapshotNode&)> allowN
     HashMap<UniquedStringImpl*, unsigned> edgeNameIndexes;
     unsigned nextEdgeNameIndex = 0;
 
-    StringBuilder json;
+    // When streaming, hand off what we have so far once it gets this big.
+    static const unsigned chunkSize = 64 * KB;
+    auto flushIfNecessary = [&] (bool force) {
+        if (!sink)
+            return;
+        if (!force && json.length() < chunkSize)
+            return;
+        (*sink)(json.toString().utf8());
+        json.clear();
+    };
 
     auto appendNodeJSON = [&] (const HeapSnapshotNode& node) {
         // Let the client decide if they want to allow or disallow certain nodes.
@@ -439,18 +466,29 @@ String HeapSnapshotBuilder::json(Function<bool (const HeapSnapshotNode&)> allowN
             json.append(',');
             json.append(String::format("\"%p\"", wrappedAddress));
         }
+
+        flushIfNecessary(false);
+    };
+
+    // An edge of m_edges between two allowed nodes, with the nodes' identifiers.
+    struct SerializedEdge {
+        NodeIdentifier from;
+        NodeIdentifier to;
+        const HeapSnapshotEdge* edge;
     };
 
     bool firstEdge = true;
-    auto appendEdgeJSON = [&] (const HeapSnapshotEdge& edge) {
+    auto appendEdgeJSON = [&] (const SerializedEdge& serializedEdge) {
         if (!firstEdge)
             json.append(',');
         firstEdge = false;
 
+        const HeapSnapshotEdge& edge = *serializedEdge.edge;
+
         // <fromNodeId>, <toNodeId>, <edgeTypeIndex>, <edgeExtraData>
-        json.appendNumber(edge.from.identifier);
+        json.appendNumber(serializedEdge.from);
         json.append(',');
-        json.appendNumber(edge.to.identifier);
+        json.appendNumber(serializedEdge.to);
         json.append(',');
         json.appendNumber(edgeTypeToNumber(edge.type));
         json.append(',');
@@ -472,6 +510,8 @@ String HeapSnapshotBuilder::json(Function<bool (const HeapSnapshotNode&)> allowN
             json.append('0');
             break;
         }
+
+        flushIfNecessary(false);
     };
 
     json.append('{');
@@ -521,49 +561,50 @@ String HeapSnapshotBuilder::json(Function<bool (const HeapSnapshotNode&)> allowN
     // Process edges.
     // Replace pointers with identifiers.
     // Remove any edges that we won't need.
-    m_edges.removeAllMatching([&] (HeapSnapshotEdge& edge) {
+    // m_edges itself is left alone, so that the snapshot can be serialized again.
+    Vector<SerializedEdge> serializedEdges;
+    serializedEdges.reserveInitialCapacity(m_edges.size());
+    for (auto& edge : m_edges) {
+        SerializedEdge serializedEdge { 0, 0, &edge };
+
         // If the from cell is null, this means a <root> edge.
-        if (!edge.from.cell)
-            edge.from.identifier = 0;
-        else {
+        if (edge.from.cell) {
             auto fromLookup = allowedNodeIdentifiers.find(edge.from.cell);
             if (fromLookup == allowedNodeIdentifiers.end()) {
                 if (m_snapshotType == SnapshotType::GCDebuggingSnapshot)
                     WTFLogAlways("Failed to find node for from-edge cell %p", edge.from.cell);
-                return true;
+                continue;
             }
-            edge.from.identifier = fromLookup->value;
+            serializedEdge.from = fromLookup->value;
         }
 
-        if (!edge.to.cell)
-            edge.to.identifier = 0;
-        else {
+        if (edge.to.cell) {
             auto toLookup = allowedNodeIdentifiers.find(edge.to.cell);
             if (toLookup == allowedNodeIdentifiers.end()) {
                 if (m_snapshotType == SnapshotType::GCDebuggingSnapshot)
                     WTFLogAlways("Failed to find node for to-edge cell %p", edge.to.cell);
-                return true;
+                continue;
             }
-            edge.to.identifier = toLookup->value;
+            serializedEdge.to = toLookup->value;
         }
 
-        return false;
-    });
+        serializedEdges.uncheckedAppend(serializedEdge);
+    }
 
     allowedNodeIdentifiers.clear();
-    m_edges.shrinkToFit();
 
     // Sort edges based on from identifier.
-    std::sort(m_edges.begin(), m_edges.end(), [&] (const HeapSnapshotEdge& a, const HeapSnapshotEdge& b) {
-        return a.from.identifier < b.from.identifier;
+    std::sort(serializedEdges.begin(), serializedEdges.end(), [&] (const SerializedEdge& a, const SerializedEdge& b) {
+        return a.from < b.from;
     });
 
     // edges
     json.append(',');
     json.appendLiteral("\"edges\":");
     json.append('[');
-    for (auto& edge : m_edges)
-        appendEdgeJSON(edge);
+    for (auto& serializedEdge : serializedEdges)
+        appendEdgeJSON(serializedEdge);
+    serializedEdges.clear();
     json.append(']');
 
     // edge types
@@ -665,7 +706,7 @@ String HeapSnapshotBuilder::json(Function<bool (const HeapSnapshotNode&)> allowN
     }
 
     json.append('}');
-    return json.toString();
+    flushIfNecessary(true);
 }
 
 } // namespace JSC
@@ -29,6 +29,7 @@
 #include <functional>
 #include <wtf/Lock.h>
 #include <wtf/Vector.h>
+#include <wtf/text/CString.h>
 #include <wtf/text/UniquedStringImpl.h>
 #include <wtf/text/WTFString.h>
 
@@ -131,7 +132,15 @@ public:
     String json();
     String json(Function<bool (const HeapSnapshotNode&)> allowNodeCallback);
 
+    // Produces the same JSON as json(), but hands it to the sink in UTF-8 chunks as it is
+    // generated so that the whole document never has to be held in memory at once.
+    typedef Function<void (const CString&)> JSONChunkSink;
+    void writeJSON(const JSONChunkSink&);
+    void writeJSON(const JSONChunkSink&, Function<bool (const HeapSnapshotNode&)> allowNodeCallback);
+
 private:
+    void serializeJSON(StringBuilder&, const JSONChunkSink*, Function<bool (const HeapSnapshotNode&)>& allowNodeCallback);
+
     static NodeIdentifier nextAvailableObjectIdentifier;
     static NodeIdentifier getNextObjectIdentifier();
 
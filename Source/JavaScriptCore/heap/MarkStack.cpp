@@ -156,4 +156,78 @@ void MarkStackArray::stealSomeCellsFrom(MarkStackArray& other, size_t idleThread
         append(other.removeLast());
 }
 
+GCArraySegment<const JSCell*>* MarkStackArray::takeFullSegment()
+{
+    if (m_numberOfSegments < 2)
+        return nullptr;
+
+    validatePrevious();
+
+    // The tail is the segment we filled up first, so it is the one most likely to lead to a
+    // large, independent part of the object graph.
+    GCArraySegment<const JSCell*>* segment = m_segments.tail();
+    ASSERT(segment != m_segments.head());
+    ASSERT(segment->m_top == s_segmentCapacity);
+    m_segments.remove(segment);
+    m_numberOfSegments--;
+
+    validatePrevious();
+    return segment;
+}
+
+void MarkStackArray::adoptFullSegment(GCArraySegment<const JSCell*>* segment)
+{
+    ASSERT(segment->m_top == s_segmentCapacity);
+
+    validatePrevious();
+
+    GCArraySegment<const JSCell*>* myHead = m_segments.removeHead();
+    m_segments.push(segment);
+    m_segments.push(myHead);
+    m_numberOfSegments++;
+
+    validatePrevious();
+}
+
+MarkStackStealQueue::~MarkStackStealQueue()
+{
+    clear();
+}
+
+bool MarkStackStealQueue::publishFrom(MarkStackArray& stack)
+{
+    unsigned tail = m_tail.loadRelaxed();
+    if (tail - m_head.load() == capacity)
+        return false;
+
+    GCArraySegment<const JSCell*>* segment = stack.takeFullSegment();
+    if (!segment)
+        return false;
+
+    m_segments[tail % capacity] = segment;
+    m_tail.store(tail + 1);
+    return true;
+}
+
+bool MarkStackStealQueue::stealInto(MarkStackArray& stack)
+{
+    unsigned head = m_head.loadRelaxed();
+    if (head == m_tail.load())
+        return false;
+
+    GCArraySegment<const JSCell*>* segment = m_segments[head % capacity];
+    m_head.store(head + 1);
+    stack.adoptFullSegment(segment);
+    return true;
+}
+
+void MarkStackStealQueue::clear()
+{
+    unsigned head = m_head.loadRelaxed();
+    unsigned tail = m_tail.loadRelaxed();
+    for (; head != tail; ++head)
+        GCArraySegment<const JSCell*>::destroy(m_segments[head % capacity]);
+    m_head.store(head);
+}
+
 } // namespace JSC
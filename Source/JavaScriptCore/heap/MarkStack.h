@@ -26,6 +26,8 @@
 #pragma once
 
 #include "GCSegmentedArray.h"
+#include <array>
+#include <wtf/Atomics.h>
 
 namespace JSC {
 
@@ -39,6 +41,39 @@ public:
     size_t transferTo(MarkStackArray&, size_t limit); // Optimized for when `limit` is small.
     void donateSomeCellsTo(MarkStackArray&);
     void stealSomeCellsFrom(MarkStackArray&, size_t idleThreadCount);
+
+    // Detaches the oldest full segment, if we have one besides our head.
+    GCArraySegment<const JSCell*>* takeFullSegment();
+    void adoptFullSegment(GCArraySegment<const JSCell*>*);
+};
+
+// A bounded queue of full mark stack segments that a SlotVisitor offers up to other markers.
+// Only the owning SlotVisitor publishes, and it does so without taking any locks. Thieves take
+// segments from the other end while holding Heap::m_markingMutex, which they already hold when
+// they go looking for work, so there is only ever one producer and one consumer at a time.
+class MarkStackStealQueue {
+    WTF_MAKE_NONCOPYABLE(MarkStackStealQueue);
+public:
+    MarkStackStealQueue() = default;
+    ~MarkStackStealQueue();
+
+    // This is safe to call concurrently.
+    bool isEmpty() const { return m_head.load() == m_tail.load(); }
+
+    // Must only be called by the owner.
+    bool publishFrom(MarkStackArray&);
+
+    // Must only be called while holding Heap::m_markingMutex, or while no markers are running.
+    bool stealInto(MarkStackArray&);
+
+    void clear();
+
+private:
+    static const unsigned capacity = 16;
+
+    std::array<GCArraySegment<const JSCell*>*, capacity> m_segments;
+    Atomic<unsigned> m_head { 0 }; // Only written by thieves.
+    Atomic<unsigned> m_tail { 0 }; // Only written by the owner.
 };
 
 } // namespace JSC
@@ -132,6 +132,7 @@ void SlotVisitor::clearMarkStacks()
             stack.clear();
             return IterationStatus::Continue;
         });
+    m_stealQueue.clear();
 }
 
 void SlotVisitor::append(ConservativeRoots& conservativeRoots)
@@ -445,6 +446,19 @@ void SlotVisitor::donateKnownParallel(MarkStackArray& from, MarkStackArray& to)
 
 void SlotVisitor::donateKnownParallel()
 {
+    // Full segments of the collector stack are offered up through our steal queue, which does not
+    // need the marking lock. Idle markers pick them up when they look for work in drainFromShared().
+    if (Options::useWorkStealingMarkStacks() && m_stealQueue.isEmpty()) {
+        if (m_stealQueue.publishFrom(m_collectorStack)) {
+            // If this races with a marker that is about to wait, that marker just sleeps until the
+            // next time someone publishes. We will take the segment back ourselves if nobody else
+            // does, so the work cannot get lost.
+            m_heap.m_markingConditionVariable.notifyAll();
+            donateKnownParallel(m_mutatorStack, *m_heap.m_sharedMutatorMarkStack);
+            return;
+        }
+    }
+
     forEachMarkStack(
         [&] (MarkStackArray& stack) -> IterationStatus {
             donateKnownParallel(stack, correspondingGlobalStack(stack));
@@ -587,9 +601,29 @@ bool SlotVisitor::didReachTermination(const AbstractLocker& locker)
 
 bool SlotVisitor::hasWork(const AbstractLocker&)
 {
-    return !isEmpty()
+    if (!isEmpty()
         || !m_heap.m_sharedCollectorMarkStack->isEmpty()
-        || !m_heap.m_sharedMutatorMarkStack->isEmpty();
+        || !m_heap.m_sharedMutatorMarkStack->isEmpty())
+        return true;
+
+    bool result = false;
+    m_heap.forEachSlotVisitor(
+        [&] (SlotVisitor& visitor) {
+            result |= visitor.hasStealableWork();
+        });
+    return result;
+}
+
+bool SlotVisitor::stealFromOtherVisitors(const AbstractLocker&)
+{
+    // We may end up stealing back our own segments, which is fine.
+    bool result = false;
+    m_heap.forEachSlotVisitor(
+        [&] (SlotVisitor& visitor) {
+            if (!result)
+                result = visitor.m_stealQueue.stealInto(m_collectorStack);
+        });
+    return result;
 }
 
 NEVER_INLINE SlotVisitor::SharedDrainResult SlotVisitor::drainFromShared(SharedDrainMode sharedDrainMode, MonotonicTime timeout)
@@ -670,6 +704,8 @@ NEVER_INLINE SlotVisitor::SharedDrainResult SlotVisitor::drainFromShared(SharedD
                             m_heap.m_numberOfWaitingParallelMarkers);
                         return IterationStatus::Continue;
                     });
+                if (isEmpty())
+                    stealFromOtherVisitors(locker);
             }
 
             m_heap.m_numberOfActiveParallelMarkers++;
@@ -740,7 +776,7 @@ SlotVisitor::SharedDrainResult SlotVisitor::waitForTermination(MonotonicTime tim
 
 void SlotVisitor::donateAll()
 {
-    if (isEmpty())
+    if (isEmpty() && m_stealQueue.isEmpty())
         return;
     
     donateAll(holdLock(m_heap.m_markingMutex));
@@ -748,6 +784,8 @@ void SlotVisitor::donateAll()
 
 void SlotVisitor::donateAll(const AbstractLocker&)
 {
+    while (m_stealQueue.stealInto(*m_heap.m_sharedCollectorMarkStack)) { }
+
     forEachMarkStack(
         [&] (MarkStackArray& stack) -> IterationStatus {
             stack.transferTo(correspondingGlobalStack(stack));
@@ -118,6 +118,7 @@ public:
     bool containsOpaqueRoot(void*) const;
 
     bool isEmpty() { return m_collectorStack.isEmpty() && m_mutatorStack.isEmpty(); }
+    bool hasStealableWork() const { return !m_stealQueue.isEmpty(); }
 
     void didStartMarking();
     void reset();
@@ -224,6 +225,8 @@ private:
 
     void donateAll(const AbstractLocker&);
 
+    bool stealFromOtherVisitors(const AbstractLocker&);
+
     bool hasWork(const AbstractLocker&);
     bool didReachTermination(const AbstractLocker&);
 
@@ -234,6 +237,7 @@ private:
 
     MarkStackArray m_collectorStack;
     MarkStackArray m_mutatorStack;
+    MarkStackStealQueue m_stealQueue;
     bool m_ignoreNewOpaqueRoots { false }; // Useful as a debugging mode.
     
     size_t m_bytesVisited;
@@ -28,17 +28,15 @@
 
 #include <wtf/PrintStream.h>
 
-using namespace JSC;
-
 namespace WTF {
 
-void printInternal(PrintStream& out, Synchronousness synchronousness)
+void printInternal(PrintStream& out, JSC::Synchronousness synchronousness)
 {
     switch (synchronousness) {
-    case Async:
+    case JSC::Async:
         out.print("Async");
         return;
-    case Sync:
+    case JSC::Sync:
         out.print("Sync");
         return;
     }
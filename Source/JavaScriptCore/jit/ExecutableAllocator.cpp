@@ -463,11 +463,22 @@ double ExecutableAllocator::memoryPressureMultiplier(size_t addedMemoryUsage)
     return result;
 }
 
+bool ExecutableAllocator::shouldEvictColdCode()
+{
+    // What matters is whether the next big compile will find room, so we look at the largest
+    // free chunk rather than at the total. This way a pool that is fragmented but not full
+    // also gets relief, since evicting cold code lets free chunks coalesce.
+    MetaAllocator::Statistics statistics = allocator->currentStatistics();
+    size_t bytesUsable = static_cast<size_t>(
+        statistics.bytesReserved * (1 - Options::coldCodeEvictionThreshold()));
+    return statistics.largestFreeChunkSize < bytesUsable;
+}
+
 RefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(size_t sizeInBytes, void* ownerUID, JITCompilationEffort effort)
 {
     if (Options::logExecutableAllocation()) {
         MetaAllocator::Statistics stats = allocator->currentStatistics();
-        dataLog("Allocating ", sizeInBytes, " bytes of executable memory with ", stats.bytesAllocated, " bytes allocated, ", stats.bytesReserved, " bytes reserved, and ", stats.bytesCommitted, " committed.\n");
+        dataLog("Allocating ", sizeInBytes, " bytes of executable memory with ", stats.bytesAllocated, " bytes allocated, ", stats.bytesReserved, " bytes reserved, and ", stats.bytesCommitted, " committed. The free space is in ", stats.numberOfFreeChunks, " chunks, the largest of which is ", stats.largestFreeChunkSize, " bytes.\n");
     }
 
     if (effort != JITCompilationCanFail && Options::reportMustSucceedExecutableAllocations()) {
@@ -134,6 +134,8 @@ public:
     static bool underMemoryPressure();
     
     static double memoryPressureMultiplier(size_t addedMemoryUsage);
+
+    static bool shouldEvictColdCode();
     
 #if ENABLE(META_ALLOCATOR_PROFILE)
     static void dumpProfile();
@@ -171,6 +173,8 @@ public:
 
     static double memoryPressureMultiplier(size_t) { return 1.0; }
 
+    static bool shouldEvictColdCode() { return false; }
+
     static void dumpProfile() { }
 
     RefPtr<ExecutableMemoryHandle> allocate(size_t, void*, JITCompilationEffort) { return nullptr; }
@@ -102,7 +102,7 @@ void JIT::emit_op_new_object(const Instruction* currentInstruction)
     RegisterID allocatorReg = regT1;
     RegisterID scratchReg = regT2;
 
-    if (!allocator)
+    if (!allocator || metadata.objectAllocationProfile.shouldPretenure())
         addSlowCase(jump());
     else {
         JumpList slowCases;
@@ -122,7 +122,7 @@ void JIT::emitSlow_op_new_object(const Instruction* currentInstruction, Vector<S
     auto& metadata = bytecode.metadata(m_codeBlock);
     int dst = bytecode.dst.offset();
     Structure* structure = metadata.objectAllocationProfile.structure();
-    callOperation(operationNewObject, structure);
+    callOperation(operationNewObjectWithProfile, structure, &metadata.objectAllocationProfile, m_codeBlock);
     emitStoreCell(dst, returnValueGPR);
 }
 
@@ -61,6 +61,7 @@
 #include "JSLexicalEnvironment.h"
 #include "JSWithScope.h"
 #include "ModuleProgramCodeBlock.h"
+#include "ObjectAllocationProfileInlines.h"
 #include "ObjectConstructor.h"
 #include "PolymorphicAccess.h"
 #include "ProgramCodeBlock.h"
@@ -1333,6 +1334,14 @@ JSCell* JIT_OPERATION operationNewObject(ExecState* exec, Structure* structure)
     return constructEmptyObject(exec, structure);
 }
 
+JSCell* JIT_OPERATION operationNewObjectWithProfile(ExecState* exec, Structure* structure, ObjectAllocationProfile* profile, CodeBlock* owner)
+{
+    VM& vm = exec->vm();
+    NativeCallFrameTracer tracer(&vm, exec);
+
+    return profile->didAllocate(vm, owner, constructEmptyObject(exec, structure));
+}
+
 JSCell* JIT_OPERATION operationNewRegexp(ExecState* exec, JSCell* regexpPtr)
 {
     SuperSamplerScope superSamplerScope(false);
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SharedJITStubSet.h"
+
+#if ENABLE(JIT)
+
+#include "CCallHelpers.h"
+#include "JSCInlines.h"
+#include <wtf/DataLog.h>
+#include <wtf/SHA1.h>
+
+namespace JSC {
+
+namespace SharedJITStubSetInternal {
+static const bool verbose = false;
+}
+
+SharedJITStubRoutine::SharedJITStubRoutine(
+    const MacroAssemblerCodeRef<JITStubRoutinePtrTag>& code, VM& vm, SharedJITStubSet& set, const CString& key)
+    : GCAwareJITStubRoutine(code, vm)
+    , m_set(&set)
+    , m_key(key)
+{
+}
+
+SharedJITStubRoutine::~SharedJITStubRoutine() { }
+
+void SharedJITStubRoutine::observeZeroRefCount()
+{
+    // Stop handing this routine out before the GC gets to decide when it can be deleted.
+    if (m_set) {
+        m_set->remove(*this);
+        m_set = nullptr;
+    }
+    GCAwareJITStubRoutine::observeZeroRefCount();
+}
+
+SharedJITStubSet::~SharedJITStubSet()
+{
+    for (SharedJITStubRoutine* routine : m_routines.values())
+        routine->m_set = nullptr;
+}
+
+void SharedJITStubSet::emitReturnWithOffset(CCallHelpers& jit, unsigned offset)
+{
+#if CPU(X86_64)
+    jit.add64(CCallHelpers::TrustedImm32(offset), CCallHelpers::Address(CCallHelpers::stackPointerRegister));
+#elif CPU(ARM64)
+    jit.add64(CCallHelpers::TrustedImm32(offset), CCallHelpers::linkRegister);
+#else
+    UNUSED_PARAM(offset);
+    RELEASE_ASSERT_NOT_REACHED();
+#endif
+    jit.ret();
+}
+
+CString SharedJITStubSet::keyFor(CCallHelpers& jit)
+{
+    AssemblerBuffer& buffer = jit.m_assembler.buffer();
+    SHA1 hasher;
+    hasher.addBytes(static_cast<const uint8_t*>(buffer.data()), buffer.codeSize());
+#if CPU(ARM64)
+    // ARM64 only resolves branches within the buffer at link time, so the bytes alone do not say
+    // where they go.
+    for (auto& record : jit.m_assembler.jumpsToLink()) {
+        intptr_t fromAndTo[] = { record.from(), record.to() };
+        hasher.addBytes(reinterpret_cast<const uint8_t*>(fromAndTo), sizeof(fromAndTo));
+    }
+#endif
+    return hasher.computeHexDigest();
+}
+
+RefPtr<JITStubRoutine> SharedJITStubSet::find(const CString& key)
+{
+    auto locker = holdLock(m_lock);
+    auto iter = m_routines.find(key);
+    if (iter == m_routines.end()) {
+        ++m_misses;
+        if (SharedJITStubSetInternal::verbose)
+            dataLogLn("Shared access stub miss for ", key, " (", m_hits, " hits, ", m_misses, " misses).");
+        return nullptr;
+    }
+
+    ++m_hits;
+    if (SharedJITStubSetInternal::verbose)
+        dataLogLn("Shared access stub hit for ", key, " (", m_hits, " hits, ", m_misses, " misses).");
+    return iter->value;
+}
+
+void SharedJITStubSet::add(SharedJITStubRoutine& routine)
+{
+    auto locker = holdLock(m_lock);
+    m_routines.add(routine.m_key, &routine);
+}
+
+void SharedJITStubSet::remove(SharedJITStubRoutine& routine)
+{
+    auto locker = holdLock(m_lock);
+    auto iter = m_routines.find(routine.m_key);
+    if (iter != m_routines.end() && iter->value == &routine)
+        m_routines.remove(iter);
+}
+
+} // namespace JSC
+
+#endif // ENABLE(JIT)
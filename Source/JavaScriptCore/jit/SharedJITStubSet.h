@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(JIT)
+
+#include "GCAwareJITStubRoutine.h"
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/text/CString.h>
+
+namespace JSC {
+
+class CCallHelpers;
+class SharedJITStubSet;
+
+// The body of a polymorphic access stub that is shared by every inline cache whose stub assembled
+// to the same bytes. It removes itself from its set once the last user drops it; the GC then
+// deletes it once it can prove that it is no longer running.
+class SharedJITStubRoutine : public GCAwareJITStubRoutine {
+public:
+    SharedJITStubRoutine(const MacroAssemblerCodeRef<JITStubRoutinePtrTag>&, VM&, SharedJITStubSet&, const CString& key);
+    virtual ~SharedJITStubRoutine();
+
+protected:
+    void observeZeroRefCount() override;
+
+private:
+    friend class SharedJITStubSet;
+
+    SharedJITStubSet* m_set;
+    CString m_key;
+};
+
+// Per-VM set of shared polymorphic access stub bodies, keyed by a hash of the assembled code. A
+// shared body knows nothing about the inline cache it serves: it is entered with a near call from
+// a small per-site thunk, and each of its exits returns to a fixed offset past that call where the
+// thunk jumps on to the site's done or slow path location. Identical bytes mean identical checks,
+// so each user still keeps its own watchpoints and weak references alive.
+class SharedJITStubSet {
+    WTF_MAKE_NONCOPYABLE(SharedJITStubSet);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    SharedJITStubSet() = default;
+    ~SharedJITStubSet();
+
+    static bool isSupported()
+    {
+#if (CPU(X86_64) || CPU(ARM64)) && !CPU(ARM64E)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Leaves the shared body by returning to the thunk, offset bytes past its return point.
+    static void emitReturnWithOffset(CCallHelpers&, unsigned offset);
+
+    static CString keyFor(CCallHelpers&);
+
+    RefPtr<JITStubRoutine> find(const CString& key);
+    void add(SharedJITStubRoutine&);
+
+    // The number of bodies that have at least one user.
+    size_t size()
+    {
+        auto locker = holdLock(m_lock);
+        return m_routines.size();
+    }
+
+private:
+    friend class SharedJITStubRoutine;
+
+    void remove(SharedJITStubRoutine&);
+
+    Lock m_lock;
+    HashMap<CString, SharedJITStubRoutine*> m_routines;
+    unsigned m_hits { 0 };
+    unsigned m_misses { 0 };
+};
+
+} // namespace JSC
+
+#endif // ENABLE(JIT)
@@ -82,6 +82,7 @@
 #include <type_traits>
 #include <wtf/Box.h>
 #include <wtf/CommaPrinter.h>
+#include <wtf/FilePrintStream.h>
 #include <wtf/MainThread.h>
 #include <wtf/MemoryPressureHandler.h>
 #include <wtf/MonotonicTime.h>
@@ -421,6 +422,7 @@ public:
     bool m_treatWatchdogExceptionAsSuccess { false };
     bool m_alwaysDumpUncaughtException { false };
     bool m_dumpSamplingProfilerData { false };
+    String m_cpuProfileOutput;
     bool m_enableRemoteDebugging { false };
 
     void parseArguments(int, char**);
@@ -2566,6 +2568,7 @@ static NO_RETURN void printUsageStatement(bool help = false)
     fprintf(stderr, "  -x         Output exit code before terminating\n");
     fprintf(stderr, "\n");
     fprintf(stderr, "  --sample                   Collects and outputs sampling profiler data\n");
+    fprintf(stderr, "  --cpuprofile=<file>        Collects sampling profiler data and writes it to the file as a Chrome DevTools .cpuprofile\n");
     fprintf(stderr, "  --test262-async            Check that some script calls the print function with the string 'Test262:AsyncTestComplete'\n");
     fprintf(stderr, "  --strict-file=<file>       Parse the given file as if it were in strict mode (this option may be passed more than once)\n");
     fprintf(stderr, "  --module-file=<file>       Parse and evaluate the given file as module (this option may be passed more than once)\n");
@@ -2684,6 +2687,14 @@ void CommandLine::parseArguments(int argc, char** argv)
             continue;
         }
 
+        static const unsigned cpuProfileStrLength = strlen("--cpuprofile=");
+        if (!strncmp(arg, "--cpuprofile=", cpuProfileStrLength)) {
+            JSC::Options::useSamplingProfiler() = true;
+            JSC::Options::samplingProfilerCPUProfile() = true;
+            m_cpuProfileOutput = String(arg + cpuProfileStrLength);
+            continue;
+        }
+
         static const char* timeoutMultiplierOptStr = "--timeoutMultiplier=";
         static const unsigned timeoutMultiplierOptStrLength = strlen(timeoutMultiplierOptStr);
         if (!strncmp(arg, timeoutMultiplierOptStr, timeoutMultiplierOptStrLength)) {
@@ -2849,6 +2860,19 @@ int runJSC(const CommandLine& options, bool isWorker, const Func& func)
 #endif
     }
 
+    if (!options.m_cpuProfileOutput.isNull() && !isWorker) {
+#if ENABLE(SAMPLING_PROFILER)
+        JSLockHolder locker(&vm);
+        auto out = FilePrintStream::open(options.m_cpuProfileOutput.utf8().data(), "w");
+        if (out)
+            vm.samplingProfiler()->reportCPUProfile(*out);
+        else
+            fprintf(stderr, "could not save CPU profile to %s.\n", options.m_cpuProfileOutput.utf8().data());
+#else
+        dataLog("Sampling profiler is not enabled on this platform\n");
+#endif
+    }
+
     if (isWorker) {
         JSLockHolder locker(vm);
         // This is needed because we don't want the worker's main
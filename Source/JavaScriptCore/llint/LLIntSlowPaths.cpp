@@ -59,6 +59,7 @@
 #include "LLIntPrototypeLoadAdaptiveStructureWatchpoint.h"
 #include "LowLevelInterpreter.h"
 #include "ModuleProgramCodeBlock.h"
+#include "ObjectAllocationProfileInlines.h"
 #include "ObjectConstructor.h"
 #include "ObjectPropertyConditionSet.h"
 #include "OpcodeInlines.h"
@@ -69,6 +70,7 @@
 #include "StructureRareDataInlines.h"
 #include "SuperSampler.h"
 #include "VMInlines.h"
+#include "WarmStartProfile.h"
 #include <wtf/NeverDestroyed.h>
 #include <wtf/StringPrintStream.h>
 
@@ -388,6 +390,8 @@ inline bool jitCompileAndSetHeuristics(CodeBlock* codeBlock, ExecState* exec, un
         return true;
     }
     case JITCode::InterpreterThunk: {
+        if (UNLIKELY(WarmStartProfile::isEnabled()))
+            WarmStartProfile::singleton().record(codeBlock, WarmStartProfile::Tier::Baseline);
         JITWorklist::instance()->compileLater(codeBlock, loopOSREntryBytecodeOffset);
         return codeBlock->jitType() == JITCode::BaselineJIT;
     }
@@ -571,7 +575,8 @@ LLINT_SLOW_PATH_DECL(slow_path_new_object)
     LLINT_BEGIN();
     auto bytecode = pc->as<OpNewObject>();
     auto& metadata = bytecode.metadata(exec);
-    LLINT_RETURN(constructEmptyObject(exec, metadata.objectAllocationProfile.structure()));
+    ObjectAllocationProfile& profile = metadata.objectAllocationProfile;
+    LLINT_RETURN(profile.didAllocate(vm, exec->codeBlock(), constructEmptyObject(exec, profile.structure())));
 }
 
 LLINT_SLOW_PATH_DECL(slow_path_new_array)
@@ -250,10 +250,14 @@ JSBigInt* JSBigInt::multiply(ExecState* exec, JSBigInt* x, JSBigInt* y)
     unsigned resultLength = x->length() + y->length();
     JSBigInt* result = JSBigInt::tryCreateWithLength(exec, resultLength);
     RETURN_IF_EXCEPTION(scope, nullptr);
-    result->initialize(InitializationType::WithZero);
 
-    for (unsigned i = 0; i < x->length(); i++)
-        multiplyAccumulate(y, x->digit(i), result, i);
+    if (std::min(x->length(), y->length()) >= karatsubaThreshold)
+        multiplyDigits(result->dataStorage(), x->dataStorage(), x->length(), y->dataStorage(), y->length());
+    else {
+        result->initialize(InitializationType::WithZero);
+        for (unsigned i = 0; i < x->length(); i++)
+            multiplyAccumulate(y, x->digit(i), result, i);
+    }
 
     result->setSign(x->sign() != y->sign());
     return result->rightTrim(vm);
@@ -735,42 +739,471 @@ void JSBigInt::internalMultiplyAdd(JSBigInt* source, Digit factor, Digit summand
 void JSBigInt::multiplyAccumulate(JSBigInt* multiplicand, Digit multiplier, JSBigInt* accumulator, unsigned accumulatorIndex)
 {
     ASSERT(accumulator->length() > multiplicand->length() + accumulatorIndex);
+    multiplyAccumulateDigits(multiplicand->dataStorage(), multiplicand->length(), multiplier, accumulator->dataStorage() + accumulatorIndex);
+}
+
+// Adds {y} to {x} in place and returns the carry out of {x}'s most significant
+// digit. Requires xLength >= yLength.
+JSBigInt::Digit JSBigInt::inplaceAddDigits(Digit* x, unsigned xLength, const Digit* y, unsigned yLength)
+{
+    ASSERT(xLength >= yLength);
+    Digit carry = 0;
+    unsigned i = 0;
+    for (; i < yLength; i++) {
+        Digit newCarry = 0;
+        Digit sum = digitAdd(x[i], y[i], newCarry);
+        sum = digitAdd(sum, carry, newCarry);
+        x[i] = sum;
+        carry = newCarry;
+    }
+    for (; carry && i < xLength; i++) {
+        Digit newCarry = 0;
+        x[i] = digitAdd(x[i], carry, newCarry);
+        carry = newCarry;
+    }
+    return carry;
+}
+
+// Subtracts {y} from {x} in place and returns the borrow out of {x}'s most
+// significant digit. Requires xLength >= yLength.
+JSBigInt::Digit JSBigInt::inplaceSubDigits(Digit* x, unsigned xLength, const Digit* y, unsigned yLength)
+{
+    ASSERT(xLength >= yLength);
+    Digit borrow = 0;
+    unsigned i = 0;
+    for (; i < yLength; i++) {
+        Digit newBorrow = 0;
+        Digit difference = digitSub(x[i], y[i], newBorrow);
+        difference = digitSub(difference, borrow, newBorrow);
+        x[i] = difference;
+        borrow = newBorrow;
+    }
+    for (; borrow && i < xLength; i++) {
+        Digit newBorrow = 0;
+        x[i] = digitSub(x[i], borrow, newBorrow);
+        borrow = newBorrow;
+    }
+    return borrow;
+}
+
+int JSBigInt::compareDigits(const Digit* x, const Digit* y, unsigned length)
+{
+    for (unsigned i = length; i--;) {
+        if (x[i] != y[i])
+            return x[i] > y[i] ? 1 : -1;
+    }
+    return 0;
+}
+
+// Multiplies {multiplicand} with {multiplier} and adds the result to
+// {accumulator}, which must be big enough to hold the result.
+void JSBigInt::multiplyAccumulateDigits(const Digit* multiplicand, unsigned multiplicandLength, Digit multiplier, Digit* accumulator)
+{
     if (!multiplier)
         return;
-    
+
     Digit carry = 0;
     Digit high = 0;
-    for (unsigned i = 0; i < multiplicand->length(); i++, accumulatorIndex++) {
-        Digit acc = accumulator->digit(accumulatorIndex);
+    unsigned accumulatorIndex = 0;
+    for (unsigned i = 0; i < multiplicandLength; i++, accumulatorIndex++) {
+        Digit acc = accumulator[accumulatorIndex];
         Digit newCarry = 0;
-        
+
         // Add last round's carryovers.
         acc = digitAdd(acc, high, newCarry);
         acc = digitAdd(acc, carry, newCarry);
-        
+
         // Compute this round's multiplication.
-        Digit multiplicandDigit = multiplicand->digit(i);
+        Digit multiplicandDigit = multiplicand[i];
         Digit low = digitMul(multiplier, multiplicandDigit, high);
         acc = digitAdd(acc, low, newCarry);
-        
+
         // Store result and prepare for next round.
-        accumulator->setDigit(accumulatorIndex, acc);
+        accumulator[accumulatorIndex] = acc;
         carry = newCarry;
     }
-    
+
     while (carry || high) {
-        ASSERT(accumulatorIndex < accumulator->length());
-        Digit acc = accumulator->digit(accumulatorIndex);
+        Digit acc = accumulator[accumulatorIndex];
         Digit newCarry = 0;
         acc = digitAdd(acc, high, newCarry);
         high = 0;
         acc = digitAdd(acc, carry, newCarry);
-        accumulator->setDigit(accumulatorIndex, acc);
+        accumulator[accumulatorIndex] = acc;
         carry = newCarry;
         accumulatorIndex++;
     }
 }
 
+// Stores {x} * {y} into {result}, which has xLength + yLength digits.
+void JSBigInt::multiplyDigits(Digit* result, const Digit* x, unsigned xLength, const Digit* y, unsigned yLength)
+{
+    if (xLength < yLength) {
+        std::swap(x, y);
+        std::swap(xLength, yLength);
+    }
+
+    if (yLength < karatsubaThreshold) {
+        std::fill(result, result + xLength + yLength, 0);
+        for (unsigned i = 0; i < yLength; i++)
+            multiplyAccumulateDigits(x, xLength, y[i], result + i);
+        return;
+    }
+
+    if (xLength == yLength) {
+        Vector<Digit> scratch(karatsubaScratchLength(xLength));
+        multiplyDigitsKaratsuba(result, x, y, xLength, scratch.data());
+        return;
+    }
+
+    // Multiply {y} with {x} one yLength-digit chunk at a time, so that each
+    // product is balanced.
+    std::fill(result, result + xLength + yLength, 0);
+    Vector<Digit> chunkProduct(2 * yLength);
+    for (unsigned offset = 0; offset < xLength; offset += yLength) {
+        unsigned chunkLength = std::min(yLength, xLength - offset);
+        multiplyDigits(chunkProduct.data(), x + offset, chunkLength, y, yLength);
+        Digit carry = inplaceAddDigits(result + offset, xLength + yLength - offset, chunkProduct.data(), chunkLength + yLength);
+        ASSERT_UNUSED(carry, !carry);
+    }
+}
+
+// Karatsuba multiplication of two {length}-digit numbers: with x = x1 * B + x0
+// and y = y1 * B + y0, the product is
+//     x1 * y1 * B^2 + ((x0 + x1) * (y0 + y1) - x0 * y0 - x1 * y1) * B + x0 * y0
+// which takes three half-size multiplications instead of four.
+void JSBigInt::multiplyDigitsKaratsuba(Digit* result, const Digit* x, const Digit* y, unsigned length, Digit* scratch)
+{
+    if (length < karatsubaThreshold) {
+        std::fill(result, result + 2 * length, 0);
+        for (unsigned i = 0; i < length; i++)
+            multiplyAccumulateDigits(x, length, y[i], result + i);
+        return;
+    }
+
+    unsigned lowLength = length / 2;
+    unsigned highLength = length - lowLength;
+    unsigned sumLength = highLength + 1;
+    unsigned resultLength = 2 * length;
+
+    multiplyDigitsKaratsuba(result, x, y, lowLength, scratch);
+    multiplyDigitsKaratsuba(result + 2 * lowLength, x + lowLength, y + lowLength, highLength, scratch);
+
+    Digit* xSum = scratch;
+    Digit* ySum = xSum + sumLength;
+    Digit* middle = ySum + sumLength;
+    Digit* nextScratch = middle + 2 * sumLength;
+
+    std::copy(x + lowLength, x + length, xSum);
+    xSum[highLength] = inplaceAddDigits(xSum, highLength, x, lowLength);
+    std::copy(y + lowLength, y + length, ySum);
+    ySum[highLength] = inplaceAddDigits(ySum, highLength, y, lowLength);
+
+    multiplyDigitsKaratsuba(middle, xSum, ySum, sumLength, nextScratch);
+    Digit borrow = inplaceSubDigits(middle, 2 * sumLength, result, 2 * lowLength);
+    borrow += inplaceSubDigits(middle, 2 * sumLength, result + 2 * lowLength, 2 * highLength);
+    ASSERT_UNUSED(borrow, !borrow);
+
+    // The middle term fits in the result, so any digits of it past the end are zero.
+    unsigned middleLength = std::min(2 * sumLength, resultLength - lowLength);
+    ASSERT(std::all_of(middle + middleLength, middle + 2 * sumLength, [] (Digit digit) { return !digit; }));
+    Digit carry = inplaceAddDigits(result + lowLength, resultLength - lowLength, middle, middleLength);
+    ASSERT_UNUSED(carry, !carry);
+}
+
+unsigned JSBigInt::karatsubaScratchLength(unsigned length)
+{
+    if (length < karatsubaThreshold)
+        return 0;
+    unsigned lowLength = length / 2;
+    unsigned sumLength = length - lowLength + 1;
+    unsigned scratchLength = 4 * sumLength + karatsubaScratchLength(sumLength);
+    return std::max({ scratchLength, karatsubaScratchLength(lowLength), karatsubaScratchLength(length - lowLength) });
+}
+
+// Divides {x} by {divisor} in place and returns the remainder.
+JSBigInt::Digit JSBigInt::inplaceDivideDigitsByDigit(Digit* x, unsigned length, Digit divisor)
+{
+    Digit remainder = 0;
+    for (unsigned i = length; i--;)
+        x[i] = digitDiv(remainder, x[i], divisor, remainder);
+    return remainder;
+}
+
+// Divides {dividend} by {divisor}, whose most significant digit must not be
+// zero. {quotient} receives dividendLength - divisorLength + 1 digits and
+// {remainder} divisorLength digits; either may be null.
+void JSBigInt::divideDigits(Digit* quotient, Digit* remainder, const Digit* dividend, unsigned dividendLength, const Digit* divisor, unsigned divisorLength)
+{
+    ASSERT(divisorLength && divisor[divisorLength - 1]);
+    ASSERT(dividendLength >= divisorLength);
+    unsigned quotientLength = dividendLength - divisorLength + 1;
+
+    if (divisorLength == 1) {
+        Vector<Digit> q(dividendLength);
+        std::copy(dividend, dividend + dividendLength, q.data());
+        Digit r = inplaceDivideDigitsByDigit(q.data(), dividendLength, divisor[0]);
+        if (quotient)
+            std::copy(q.begin(), q.end(), quotient);
+        if (remainder)
+            remainder[0] = r;
+        return;
+    }
+
+    // Burnikel-Ziegler division splits the dividend into blocks of {blockLength}
+    // digits, where the block length is the divisor length rounded up so that
+    // it can be halved repeatedly until it is below the threshold. Schoolbook
+    // division uses a single block of the divisor's length.
+    bool useBurnikelZiegler = divisorLength >= burnikelZieglerThreshold && quotientLength >= burnikelZieglerThreshold;
+    unsigned blockLength = divisorLength;
+    if (useBurnikelZiegler) {
+        unsigned blockCount = 1;
+        while (blockCount * burnikelZieglerThreshold <= divisorLength)
+            blockCount <<= 1;
+        blockLength = (divisorLength + blockCount - 1) / blockCount * blockCount;
+    }
+
+    // Normalize both inputs by shifting them left until the divisor fills
+    // {blockLength} digits and its most significant bit is set. This leaves the
+    // quotient unchanged and scales the remainder by the same amount.
+    unsigned digitShift = blockLength - divisorLength;
+    unsigned bitShift = sizeof(Digit) == 8 ? clz64(divisor[divisorLength - 1]) : clz32(divisor[divisorLength - 1]);
+    auto shiftLeftInto = [&] (Digit* result, const Digit* x, unsigned length) {
+        std::fill(result, result + digitShift, 0);
+        Digit carry = 0;
+        for (unsigned i = 0; i < length; i++) {
+            Digit digit = x[i];
+            result[digitShift + i] = bitShift ? (digit << bitShift) | carry : digit;
+            carry = bitShift ? digit >> (digitBits - bitShift) : 0;
+        }
+        return carry;
+    };
+
+    Vector<Digit> v(blockLength);
+    Digit carry = shiftLeftInto(v.data(), divisor, divisorLength);
+    ASSERT_UNUSED(carry, !carry);
+
+    unsigned uLength = dividendLength + digitShift + 1;
+    unsigned blocks = 0;
+    if (useBurnikelZiegler) {
+        // The dividend needs enough blocks that its most significant one is below
+        // half of the digit base raised to the block length.
+        blocks = std::max(2u, uLength / blockLength + 1);
+        uLength = blocks * blockLength;
+    }
+    Vector<Digit> u(uLength);
+    std::fill(u.begin(), u.end(), 0);
+    u[dividendLength + digitShift] = shiftLeftInto(u.data(), dividend, dividendLength);
+
+    Vector<Digit> r(blockLength);
+    Vector<Digit> q(uLength - blockLength);
+    if (!useBurnikelZiegler) {
+        divideDigitsSchoolbook(q.data(), u.data(), uLength, v.data(), blockLength);
+        std::copy(u.data(), u.data() + blockLength, r.data());
+    } else {
+        // Divide two blocks at a time, carrying the remainder into the next step.
+        Vector<Digit> z(2 * blockLength);
+        std::copy(u.data() + (blocks - 2) * blockLength, u.data() + blocks * blockLength, z.data());
+        for (unsigned i = blocks - 1; i--;) {
+            divideDigits2n1n(q.data() + i * blockLength, r.data(), z.data(), v.data(), blockLength);
+            if (i) {
+                std::copy(r.begin(), r.end(), z.data() + blockLength);
+                std::copy(u.data() + (i - 1) * blockLength, u.data() + i * blockLength, z.data());
+            }
+        }
+    }
+
+    if (quotient) {
+        ASSERT(q.size() >= quotientLength);
+        ASSERT(std::all_of(q.begin() + quotientLength, q.end(), [] (Digit digit) { return !digit; }));
+        std::copy(q.data(), q.data() + quotientLength, quotient);
+    }
+
+    if (remainder) {
+        ASSERT(std::all_of(r.begin(), r.begin() + digitShift, [] (Digit digit) { return !digit; }));
+        for (unsigned i = 0; i < divisorLength; i++) {
+            Digit digit = r[digitShift + i];
+            if (bitShift) {
+                digit >>= bitShift;
+                if (digitShift + i + 1 < blockLength)
+                    digit |= r[digitShift + i + 1] << (digitBits - bitShift);
+            }
+            remainder[i] = digit;
+        }
+    }
+}
+
+// Knuth's algorithm D. Divides {dividend} in place by the normalized {divisor},
+// whose most significant bit is set and which must be greater than the top
+// divisorLength digits of {dividend}. {quotient} receives dividendLength -
+// divisorLength digits and the remainder is left in the low digits of {dividend}.
+void JSBigInt::divideDigitsSchoolbook(Digit* quotient, Digit* dividend, unsigned dividendLength, const Digit* divisor, unsigned divisorLength)
+{
+    ASSERT(divisorLength >= 2);
+    ASSERT(divisor[divisorLength - 1] >> (digitBits - 1));
+    ASSERT(compareDigits(dividend + dividendLength - divisorLength, divisor, divisorLength) < 0);
+
+    // As in absoluteDivWithBigIntDivisor, the names follow Knuth's book.
+    unsigned n = divisorLength;
+    Digit* u = dividend;
+    const Digit* v = divisor;
+    Digit vn1 = v[n - 1];
+    Digit vn2 = v[n - 2];
+    for (unsigned j = dividendLength - n; j--;) {
+        Digit qhat = std::numeric_limits<Digit>::max();
+        Digit ujn = u[j + n];
+        if (ujn != vn1) {
+            Digit rhat = 0;
+            qhat = digitDiv(ujn, u[j + n - 1], vn1, rhat);
+            Digit ujn2 = u[j + n - 2];
+            while (productGreaterThan(qhat, vn2, rhat, ujn2)) {
+                qhat--;
+                Digit prevRhat = rhat;
+                rhat += vn1;
+                if (rhat < prevRhat)
+                    break;
+            }
+        }
+
+        // Subtract {qhat} * {v} from the current n + 1 digits of {u}.
+        Digit carry = 0;
+        Digit borrow = 0;
+        for (unsigned i = 0; i < n; i++) {
+            Digit high;
+            Digit product = digitMul(qhat, v[i], high);
+            Digit newCarry = 0;
+            product = digitAdd(product, carry, newCarry);
+            carry = high + newCarry;
+            Digit newBorrow = 0;
+            Digit difference = digitSub(u[j + i], product, newBorrow);
+            difference = digitSub(difference, borrow, newBorrow);
+            u[j + i] = difference;
+            borrow = newBorrow;
+        }
+        Digit newBorrow = 0;
+        Digit difference = digitSub(u[j + n], carry, newBorrow);
+        u[j + n] = digitSub(difference, borrow, newBorrow);
+
+        // If that went below zero, {qhat} was one too large.
+        if (newBorrow) {
+            qhat--;
+            Digit carry = inplaceAddDigits(u + j, n, v, n);
+            u[j + n] += carry;
+        }
+
+        quotient[j] = qhat;
+    }
+}
+
+// Burnikel-Ziegler recursive division of the 2n-digit {dividend} by the
+// normalized n-digit {divisor}, where the dividend's top half is less than the
+// divisor. Produces an n-digit {quotient} and {remainder}.
+void JSBigInt::divideDigits2n1n(Digit* quotient, Digit* remainder, const Digit* dividend, const Digit* divisor, unsigned length)
+{
+    if (length % 2 || length < burnikelZieglerThreshold) {
+        Vector<Digit> u(2 * length);
+        std::copy(dividend, dividend + 2 * length, u.data());
+        divideDigitsSchoolbook(quotient, u.data(), 2 * length, divisor, length);
+        std::copy(u.data(), u.data() + length, remainder);
+        return;
+    }
+
+    // Split the dividend into four halves [a1 a2 a3 a4] and divide
+    // [a1 a2 a3] and then [r a4] by the divisor.
+    unsigned halfLength = length / 2;
+    Vector<Digit> u(3 * halfLength);
+    divideDigits3n2n(quotient + halfLength, u.data() + halfLength, dividend + halfLength, divisor, halfLength);
+    std::copy(dividend, dividend + halfLength, u.data());
+    divideDigits3n2n(quotient, remainder, u.data(), divisor, halfLength);
+}
+
+// Divides the 3n-digit {dividend} [a1 a2 a3] by the normalized 2n-digit
+// {divisor} [b1 b2], where [a1 a2] is less than the divisor. Produces an
+// n-digit {quotient} and 2n-digit {remainder}.
+void JSBigInt::divideDigits3n2n(Digit* quotient, Digit* remainder, const Digit* dividend, const Digit* divisor, unsigned length)
+{
+    const Digit* a1 = dividend + 2 * length;
+    const Digit* a2 = dividend + length;
+    const Digit* b1 = divisor + length;
+
+    // Estimate the quotient from [a1 a2] / b1. The estimate is at most two too
+    // large.
+    Vector<Digit> r1(length + 1);
+    if (compareDigits(a1, b1, length) < 0) {
+        divideDigits2n1n(quotient, r1.data(), a2, b1, length);
+        r1[length] = 0;
+    } else {
+        // Here a1 == b1, so the estimate is the largest n-digit number and
+        // [a1 a2] - estimate * b1 is a2 + b1.
+        std::fill(quotient, quotient + length, std::numeric_limits<Digit>::max());
+        std::copy(a2, a2 + length, r1.data());
+        r1[length] = inplaceAddDigits(r1.data(), length, b1, length);
+    }
+
+    // The remainder is [r1 a3] - estimate * b2, corrected by adding the divisor
+    // back while it is negative. Negative values are kept in two's complement
+    // over 2n + 1 digits, so adding the divisor carries out once it is not.
+    Vector<Digit> product(2 * length);
+    multiplyDigits(product.data(), quotient, length, divisor, length);
+    Vector<Digit> r(2 * length + 1);
+    std::copy(dividend, dividend + length, r.data());
+    std::copy(r1.begin(), r1.end(), r.data() + length);
+    if (inplaceSubDigits(r.data(), 2 * length + 1, product.data(), 2 * length)) {
+        do {
+            Digit borrow = 1;
+            for (unsigned i = 0; borrow && i < length; i++) {
+                Digit newBorrow = 0;
+                quotient[i] = digitSub(quotient[i], borrow, newBorrow);
+                borrow = newBorrow;
+            }
+        } while (!inplaceAddDigits(r.data(), 2 * length + 1, divisor, 2 * length));
+    }
+    ASSERT(!r[2 * length]);
+    std::copy(r.data(), r.data() + 2 * length, remainder);
+}
+
+// Appends the characters of {x} in {radix} to {resultString}, least significant
+// first, by splitting {x} with the precomputed powers of {chunkDivisor}. At
+// {level}, {x} is less than powers[level] squared and, unless it holds the most
+// significant characters, is padded with zeroes to chunkChars << (level + 1)
+// characters. {x} is used as scratch space.
+void JSBigInt::appendDigitsToString(Vector<LChar>& resultString, Digit* x, unsigned length, int level, const Vector<Vector<Digit>>& powers, unsigned radix, unsigned chunkChars, Digit chunkDivisor, bool isMostSignificant)
+{
+    while (length && !x[length - 1])
+        length--;
+
+    size_t paddedSize = resultString.size() + (static_cast<size_t>(chunkChars) << (level + 1));
+
+    if (level < 0 || length < toStringDivideAndConquerThreshold) {
+        while (length) {
+            Digit chunk = inplaceDivideDigitsByDigit(x, length, chunkDivisor);
+            if (!x[length - 1])
+                length--;
+            for (unsigned i = 0; i < chunkChars; i++) {
+                resultString.append(radixDigits[chunk % radix]);
+                chunk /= radix;
+            }
+        }
+    } else {
+        const Vector<Digit>& power = powers[level];
+        if (length < power.size())
+            appendDigitsToString(resultString, x, length, level - 1, powers, radix, chunkChars, chunkDivisor, isMostSignificant);
+        else {
+            Vector<Digit> quotient(length - power.size() + 1);
+            Vector<Digit> remainder(power.size());
+            divideDigits(quotient.data(), remainder.data(), x, length, power.data(), power.size());
+            appendDigitsToString(resultString, remainder.data(), remainder.size(), level - 1, powers, radix, chunkChars, chunkDivisor, false);
+            appendDigitsToString(resultString, quotient.data(), quotient.size(), level - 1, powers, radix, chunkChars, chunkDivisor, isMostSignificant);
+        }
+    }
+
+    if (!isMostSignificant) {
+        ASSERT(resultString.size() <= paddedSize);
+        while (resultString.size() < paddedSize)
+            resultString.append('0');
+    }
+}
+
 bool JSBigInt::equals(JSBigInt* x, JSBigInt* y)
 {
     if (x->sign() != y->sign())
@@ -957,6 +1390,19 @@ void JSBigInt::absoluteDivWithBigIntDivisor(ExecState* exec, JSBigInt* dividend,
     // come up with more descriptive names for them.
     unsigned n = divisor->length();
     unsigned m = dividend->length() - n;
+
+    // Large divisions use Burnikel-Ziegler division, which works on the digits directly.
+    if (n >= burnikelZieglerThreshold && m + 1 >= burnikelZieglerThreshold) {
+        JSBigInt* q = quotient ? createWithLengthUnchecked(vm, m + 1) : nullptr;
+        JSBigInt* r = remainder ? createWithLengthUnchecked(vm, n) : nullptr;
+        divideDigits(q ? q->dataStorage() : nullptr, r ? r->dataStorage() : nullptr, dividend->dataStorage(), dividend->length(), divisor->dataStorage(), n);
+        // Caller will right-trim.
+        if (quotient)
+            *quotient = q;
+        if (remainder)
+            *remainder = r;
+        return;
+    }
     
     // The quotient to be computed.
     JSBigInt* q = nullptr;
@@ -1551,52 +1997,74 @@ String JSBigInt::toStringGeneric(ExecState* exec, JSBigInt* x, unsigned radix)
         return String();
     }
 
-    Digit lastDigit;
-    if (length == 1)
-        lastDigit = x->digit(0);
-    else {
+    if (length >= toStringDivideAndConquerThreshold) {
         unsigned chunkChars = digitBits * bitsPerCharTableMultiplier / maxBitsPerChar;
         Digit chunkDivisor = digitPow(radix, chunkChars);
 
-        // By construction of chunkChars, there can't have been overflow.
-        ASSERT(chunkDivisor);
-        unsigned nonZeroDigit = length - 1;
-        ASSERT(x->digit(nonZeroDigit));
+        // Divide and conquer by the powers chunkDivisor^(2^k), up to the first
+        // one whose square exceeds {x}, so that each level of the recursion
+        // halves the size of the numbers it converts.
+        Vector<Vector<Digit>> powers;
+        powers.append(Vector<Digit>({ chunkDivisor }));
+        while (2 * powers.last().size() - 2 < length) {
+            const Vector<Digit>& power = powers.last();
+            Vector<Digit> square(2 * power.size());
+            multiplyDigits(square.data(), power.data(), power.size(), power.data(), power.size());
+            while (!square.last())
+                square.removeLast();
+            powers.append(WTFMove(square));
+        }
 
-        // {rest} holds the part of the BigInt that we haven't looked at yet.
-        // Not to be confused with "remainder"!
-        JSBigInt* rest = nullptr;
+        Vector<Digit> digits(length);
+        std::copy(x->dataStorage(), x->dataStorage() + length, digits.data());
+        appendDigitsToString(resultString, digits.data(), length, powers.size() - 1, powers, radix, chunkChars, chunkDivisor, true);
+    } else {
+        Digit lastDigit;
+        if (length == 1)
+            lastDigit = x->digit(0);
+        else {
+            unsigned chunkChars = digitBits * bitsPerCharTableMultiplier / maxBitsPerChar;
+            Digit chunkDivisor = digitPow(radix, chunkChars);
+
+            // By construction of chunkChars, there can't have been overflow.
+            ASSERT(chunkDivisor);
+            unsigned nonZeroDigit = length - 1;
+            ASSERT(x->digit(nonZeroDigit));
+
+            // {rest} holds the part of the BigInt that we haven't looked at yet.
+            // Not to be confused with "remainder"!
+            JSBigInt* rest = nullptr;
+
+            // In the first round, divide the input, allocating a new BigInt for
+            // the result == rest; from then on divide the rest in-place.
+            JSBigInt** dividend = &x;
+            do {
+                Digit chunk;
+                absoluteDivWithDigitDivisor(vm, *dividend, chunkDivisor, &rest, chunk);
+                dividend = &rest;
+                for (unsigned i = 0; i < chunkChars; i++) {
+                    resultString.append(radixDigits[chunk % radix]);
+                    chunk /= radix;
+                }
+                ASSERT(!chunk);
 
-        // In the first round, divide the input, allocating a new BigInt for
-        // the result == rest; from then on divide the rest in-place.
-        JSBigInt** dividend = &x;
-        do {
-            Digit chunk;
-            absoluteDivWithDigitDivisor(vm, *dividend, chunkDivisor, &rest, chunk);
-            dividend = &rest;
-            for (unsigned i = 0; i < chunkChars; i++) {
-                resultString.append(radixDigits[chunk % radix]);
-                chunk /= radix;
-            }
-            ASSERT(!chunk);
+                if (!rest->digit(nonZeroDigit))
+                    nonZeroDigit--;
 
-            if (!rest->digit(nonZeroDigit))
-                nonZeroDigit--;
+                // We can never clear more than one digit per iteration, because
+                // chunkDivisor is smaller than max digit value.
+                ASSERT(rest->digit(nonZeroDigit));
+            } while (nonZeroDigit > 0);
 
-            // We can never clear more than one digit per iteration, because
-            // chunkDivisor is smaller than max digit value.
-            ASSERT(rest->digit(nonZeroDigit));
-        } while (nonZeroDigit > 0);
+            lastDigit = rest->digit(0);
+        }
 
-        lastDigit = rest->digit(0);
+        do {
+            resultString.append(radixDigits[lastDigit % radix]);
+            lastDigit /= radix;
+        } while (lastDigit > 0);
     }
-
-    do {
-        resultString.append(radixDigits[lastDigit % radix]);
-        lastDigit /= radix;
-    } while (lastDigit > 0);
     ASSERT(resultString.size());
-    ASSERT(resultString.size() <= static_cast<size_t>(maximumCharactersRequired));
 
     // Remove leading zeroes.
     unsigned newSizeNoLeadingZeroes = resultString.size();
@@ -1604,6 +2072,7 @@ String JSBigInt::toStringGeneric(ExecState* exec, JSBigInt* x, unsigned radix)
         newSizeNoLeadingZeroes--;
 
     resultString.shrink(newSizeNoLeadingZeroes);
+    ASSERT(resultString.size() <= static_cast<size_t>(maximumCharactersRequired));
 
     if (sign)
         resultString.append('-');
@@ -196,6 +196,26 @@ private:
     static Digit digitDiv(Digit high, Digit low, Digit divisor, Digit& remainder);
     static Digit digitPow(Digit base, Digit exponent);
 
+    // Subquadratic algorithms for large BigInts. They work on little-endian spans of digits so
+    // that they can recurse without allocating cells; the thresholds are in digits.
+    static constexpr unsigned karatsubaThreshold = 34;
+    static constexpr unsigned burnikelZieglerThreshold = 57;
+    static constexpr unsigned toStringDivideAndConquerThreshold = 43;
+
+    static Digit inplaceAddDigits(Digit* x, unsigned xLength, const Digit* y, unsigned yLength);
+    static Digit inplaceSubDigits(Digit* x, unsigned xLength, const Digit* y, unsigned yLength);
+    static int compareDigits(const Digit* x, const Digit* y, unsigned length);
+    static void multiplyAccumulateDigits(const Digit* multiplicand, unsigned multiplicandLength, Digit multiplier, Digit* accumulator);
+    static void multiplyDigits(Digit* result, const Digit* x, unsigned xLength, const Digit* y, unsigned yLength);
+    static void multiplyDigitsKaratsuba(Digit* result, const Digit* x, const Digit* y, unsigned length, Digit* scratch);
+    static unsigned karatsubaScratchLength(unsigned length);
+    static Digit inplaceDivideDigitsByDigit(Digit* x, unsigned length, Digit divisor);
+    static void divideDigits(Digit* quotient, Digit* remainder, const Digit* dividend, unsigned dividendLength, const Digit* divisor, unsigned divisorLength);
+    static void divideDigitsSchoolbook(Digit* quotient, Digit* dividend, unsigned dividendLength, const Digit* divisor, unsigned divisorLength);
+    static void divideDigits2n1n(Digit* quotient, Digit* remainder, const Digit* dividend, const Digit* divisor, unsigned length);
+    static void divideDigits3n2n(Digit* quotient, Digit* remainder, const Digit* dividend, const Digit* divisor, unsigned length);
+    static void appendDigitsToString(Vector<LChar>&, Digit* x, unsigned length, int level, const Vector<Vector<Digit>>& powers, unsigned radix, unsigned chunkChars, Digit chunkDivisor, bool isMostSignificant);
+
     static String toStringBasePowerOfTwo(ExecState*, JSBigInt*, unsigned radix);
     static String toStringGeneric(ExecState*, JSBigInt*, unsigned radix);
 
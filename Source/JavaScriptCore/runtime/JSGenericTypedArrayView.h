@@ -28,6 +28,9 @@
 #include "JSArrayBufferView.h"
 #include "ThrowScope.h"
 #include "ToNativeFromValue.h"
+#include <wtf/MallocPtr.h>
+#include <wtf/NumberOfCores.h>
+#include <wtf/RadixSort.h>
 
 namespace JSC {
 
@@ -201,12 +204,10 @@ public:
         case TypeFloat64:
             sortFloat<int64_t>();
             break;
-        default: {
-            ElementType* array = typedVector();
-            std::sort(array, array + m_length);
+        default:
+            sortIntegral(std::is_integral<ElementType>());
             break;
         }
-        }
     }
 
     bool canAccessRangeQuickly(unsigned offset, unsigned length)
@@ -340,6 +341,17 @@ private:
         purifyArray();
 
         IntegralType* array = reinterpret_cast_ptr<IntegralType*>(typedVector());
+
+        // For the radix sort, flipping every bit of the negative numbers and only the sign bit of
+        // the others gives unsigned keys in the same order as the comparator below.
+        using UnsignedType = typename std::make_unsigned<IntegralType>::type;
+        constexpr UnsignedType signBit = static_cast<UnsignedType>(1) << (sizeof(UnsignedType) * 8 - 1);
+        if (radixSortIfProfitable(array, [] (IntegralType value) {
+            UnsignedType bits = static_cast<UnsignedType>(value);
+            return static_cast<UnsignedType>((bits & signBit) ? ~bits : bits | signBit);
+        }))
+            return;
+
         std::sort(array, array + m_length, [] (IntegralType a, IntegralType b) {
             if (a >= 0 || b >= 0)
                 return a < b;
@@ -348,6 +360,53 @@ private:
 
     }
 
+    void sortIntegral(std::false_type) { RELEASE_ASSERT_NOT_REACHED(); }
+
+    void sortIntegral(std::true_type)
+    {
+        ElementType* array = typedVector();
+
+        // Flipping the sign bit orders signed integers like unsigned ones.
+        using UnsignedType = typename std::make_unsigned<ElementType>::type;
+        constexpr UnsignedType signBit = std::is_signed<ElementType>::value ? static_cast<UnsignedType>(1) << (sizeof(UnsignedType) * 8 - 1) : 0;
+        if (radixSortIfProfitable(array, [] (ElementType value) {
+            return static_cast<UnsignedType>(static_cast<UnsignedType>(value) ^ signBit);
+        }))
+            return;
+
+        std::sort(array, array + m_length);
+    }
+
+    template<typename T, typename KeyFunction>
+    bool radixSortIfProfitable(T* array, const KeyFunction& keyOf)
+    {
+        size_t length = m_length;
+        if (length < Options::minimumTypedArrayLengthForRadixSort())
+            return false;
+
+        // Another thread may write to a shared buffer while we sort it, which would invalidate the
+        // bucket counts of the radix sort. So we sort a private copy of it instead.
+        bool isShared = this->isShared();
+        auto scratch = MallocPtr<T>::tryMalloc(length * sizeof(T) * (isShared ? 2 : 1));
+        if (!scratch)
+            return false;
+
+        T* data = array;
+        if (isShared) {
+            data = scratch.get() + length;
+            memcpy(data, array, length * sizeof(T));
+        }
+
+        unsigned numberOfJobs = 1;
+        if (length >= Options::minimumTypedArrayLengthForParallelSort())
+            numberOfJobs = WTF::numberOfProcessorCores();
+        radixSort(data, scratch.get(), length, keyOf, numberOfJobs);
+
+        if (isShared)
+            memcpy(array, data, length * sizeof(T));
+        return true;
+    }
+
 };
 
 template<typename Adaptor>
@@ -66,23 +66,24 @@ bool JSMap::isIteratorProtocolFastAndNonObservable()
     return true;
 }
 
-bool JSMap::canCloneFastAndNonObservable(Structure* structure)
+bool JSMap::isSetFastAndNonObservable(Structure* structure)
 {
-    auto setFastAndNonObservable = [&] (Structure* structure) {
-        JSGlobalObject* globalObject = structure->globalObject();
-        if (!globalObject->isMapPrototypeSetFastAndNonObservable())
-            return false;
+    JSGlobalObject* globalObject = structure->globalObject();
+    if (!globalObject->isMapPrototypeSetFastAndNonObservable())
+        return false;
 
-        if (structure->hasPolyProto())
-            return false;
+    if (structure->hasPolyProto())
+        return false;
 
-        if (structure->storedPrototype() != globalObject->mapPrototype())
-            return false;
+    if (structure->storedPrototype() != globalObject->mapPrototype())
+        return false;
 
-        return true;
-    };
+    return true;
+}
 
-    return isIteratorProtocolFastAndNonObservable() && setFastAndNonObservable(structure);
+bool JSMap::canCloneFastAndNonObservable(Structure* structure)
+{
+    return isIteratorProtocolFastAndNonObservable() && isSetFastAndNonObservable(structure);
 }
 
 }
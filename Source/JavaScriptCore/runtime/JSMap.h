@@ -43,7 +43,12 @@ public:
 
     static JSMap* create(ExecState* exec, VM& vm, Structure* structure)
     {
-        JSMap* instance = new (NotNull, allocateCell<JSMap>(vm.heap)) JSMap(vm, structure);
+        return create(exec, vm, structure, 0);
+    }
+
+    static JSMap* create(ExecState* exec, VM& vm, Structure* structure, uint32_t size)
+    {
+        JSMap* instance = new (NotNull, allocateCell<JSMap>(vm.heap)) JSMap(vm, structure, size);
         instance->finishCreation(exec, vm);
         return instance;
     }
@@ -57,12 +62,20 @@ public:
     bool canCloneFastAndNonObservable(Structure*);
     JSMap* clone(ExecState*, VM&, Structure*);
 
+    // True if calling "set" on a map with this structure is known to invoke Map.prototype.set.
+    static bool isSetFastAndNonObservable(Structure*);
+
 private:
     JSMap(VM& vm, Structure* structure)
         : Base(vm, structure)
     {
     }
 
+    JSMap(VM& vm, Structure* structure, uint32_t sizeHint)
+        : Base(vm, structure, sizeHint)
+    {
+    }
+
     static String toStringName(const JSObject*, ExecState*);
 };
 
@@ -100,6 +100,10 @@ private:
 
         bool appendNextProperty(Stringifier&, StringBuilder&);
 
+        // Set when m_propertyNames was read straight out of the object's structure. Property values can
+        // then be loaded from m_propertyOffsets for as long as the object keeps that structure.
+        bool hasStructureSnapshot() const { return !!m_structure; }
+
     private:
         JSObject* m_object;
         const bool m_isJSArray;
@@ -107,12 +111,16 @@ private:
         unsigned m_index { 0 };
         unsigned m_size { 0 };
         RefPtr<PropertyNameArrayData> m_propertyNames;
+        Structure* m_structure { nullptr };
+        Vector<PropertyOffset> m_propertyOffsets;
     };
 
     friend class Holder;
 
     JSValue toJSON(JSValue, const PropertyNameForFunctionCall&);
     JSValue toJSONImpl(VM&, JSValue, JSValue toJSONFunction, const PropertyNameForFunctionCall&);
+    bool toJSONIsKnownAbsent(VM&, JSObject*) const;
+    void cacheToJSONAbsence(VM&, JSObject*);
 
     enum StringifyResult { StringifyFailed, StringifySucceeded, StringifyFailedDueToUndefinedOrSymbolValue };
     StringifyResult appendStringifiedValue(StringBuilder&, JSValue, const Holder&, const PropertyNameForFunctionCall&);
@@ -133,6 +141,9 @@ private:
 
     MarkedArgumentBuffer m_objectStack;
     Vector<Holder, 16, UnsafeVectorOverflow> m_holderStack;
+    // The structure of the last object found to have no toJSON, followed by each (prototype, structure)
+    // pair along its prototype chain.
+    MarkedArgumentBuffer m_toJSONAbsenceChain;
     String m_repeatedGap;
     String m_indent;
 };
@@ -157,6 +168,36 @@ static inline JSValue unwrapBoxedPrimitive(ExecState* exec, JSValue value)
     return value;
 }
 
+// Plain objects whose own properties are all data properties can be enumerated straight from the
+// property table and read with getDirect(). A non-dictionary structure transitions whenever a property
+// is added, deleted or reconfigured, so checking the structure again before each read is enough.
+static inline bool canEnumerateFromStructure(Structure* structure)
+{
+    return structure->typeInfo().type() == FinalObjectType
+        && !structure->isDictionary()
+        && !hasIndexedProperties(structure->indexingType())
+        && !structure->hasGetterSetterProperties()
+        && !structure->hasCustomGetterSetterProperties();
+}
+
+// Whether a miss for toJSON in this structure's property table is a real miss that stays true until the
+// structure changes. JSArray only intercepts "length" in getOwnPropertySlot.
+static inline bool canCacheToJSONAbsence(Structure* structure)
+{
+    if (structure->isDictionary() || structure->hasPolyProto())
+        return false;
+    if (structure->typeInfo().prohibitsPropertyCaching() || structure->typeInfo().getOwnPropertySlotIsImpureForPropertyAbsence())
+        return false;
+    if (structure->typeInfo().overridesGetOwnPropertySlot()) {
+        JSType type = structure->typeInfo().type();
+        if (type != ArrayType && type != DerivedArrayType)
+            return false;
+    }
+    if (TypeInfo::hasStaticPropertyTable(structure->inlineTypeFlags()) && !structure->staticPropertiesReified())
+        return false;
+    return true;
+}
+
 static inline String gap(ExecState* exec, JSValue space)
 {
     VM& vm = exec->vm();
@@ -287,17 +328,54 @@ JSValue Stringifier::stringify(JSValue value)
     RELEASE_AND_RETURN(scope, jsString(m_exec, result.toString()));
 }
 
+bool Stringifier::toJSONIsKnownAbsent(VM& vm, JSObject* object) const
+{
+    if (m_toJSONAbsenceChain.isEmpty() || m_toJSONAbsenceChain.at(0) != object->structure(vm))
+        return false;
+    for (size_t i = 1; i < m_toJSONAbsenceChain.size(); i += 2) {
+        if (asObject(m_toJSONAbsenceChain.at(i))->structure(vm) != m_toJSONAbsenceChain.at(i + 1))
+            return false;
+    }
+    return true;
+}
+
+void Stringifier::cacheToJSONAbsence(VM& vm, JSObject* object)
+{
+    m_toJSONAbsenceChain.clear();
+    Structure* structure = object->structure(vm);
+    if (!canCacheToJSONAbsence(structure))
+        return;
+    m_toJSONAbsenceChain.append(structure);
+    for (JSObject* prototype = structure->storedPrototypeObject(); prototype; prototype = structure->storedPrototypeObject()) {
+        structure = prototype->structure(vm);
+        if (!canCacheToJSONAbsence(structure)) {
+            m_toJSONAbsenceChain.clear();
+            return;
+        }
+        m_toJSONAbsenceChain.append(prototype);
+        m_toJSONAbsenceChain.append(structure);
+    }
+    if (m_toJSONAbsenceChain.hasOverflowed())
+        m_toJSONAbsenceChain.clear();
+}
+
 ALWAYS_INLINE JSValue Stringifier::toJSON(JSValue baseValue, const PropertyNameForFunctionCall& propertyName)
 {
     VM& vm = m_exec->vm();
     auto scope = DECLARE_THROW_SCOPE(vm);
     scope.assertNoException();
 
+    if (baseValue.isObject() && toJSONIsKnownAbsent(vm, asObject(baseValue)))
+        return baseValue;
+
     PropertySlot slot(baseValue, PropertySlot::InternalMethodType::Get);
     bool hasProperty = baseValue.getPropertySlot(m_exec, vm.propertyNames->toJSON, slot);
     EXCEPTION_ASSERT(!scope.exception() || !hasProperty);
-    if (!hasProperty)
+    if (!hasProperty) {
+        if (!scope.exception() && baseValue.isObject())
+            cacheToJSONAbsence(vm, asObject(baseValue));
         return baseValue;
+    }
 
     JSValue toJSONFunction = slot.getValue(m_exec, vm.propertyNames->toJSON);
     RETURN_IF_EXCEPTION(scope, { });
@@ -420,6 +498,8 @@ Stringifier::StringifyResult Stringifier::appendStringifiedValue(StringBuilder&
         RETURN_IF_EXCEPTION(scope, StringifyFailed);
         if (UNLIKELY(builder.hasOverflowed()))
             return StringifyFailed;
+        if (m_holderStack.last().hasStructureSnapshot())
+            m_objectStack.removeLast();
         m_holderStack.removeLast();
         m_objectStack.removeLast();
     } while (!m_holderStack.isEmpty());
@@ -490,9 +570,23 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
             }
             builder.append('[');
         } else {
+            Structure* structure = m_object->structure(vm);
             if (stringifier.m_usingArrayReplacer)
                 m_propertyNames = stringifier.m_arrayReplacerPropertyNames.data();
-            else {
+            else if (canEnumerateFromStructure(structure)) {
+                PropertyNameArray objectPropertyNames(&vm, PropertyNameMode::Strings, PrivateSymbolMode::Exclude);
+                structure->forEachProperty(vm, [&] (const PropertyMapEntry& entry) -> bool {
+                    if ((entry.attributes & PropertyAttribute::DontEnum) || entry.key->isSymbol())
+                        return true;
+                    objectPropertyNames.addUnchecked(entry.key);
+                    m_propertyOffsets.append(entry.offset);
+                    return true;
+                });
+                m_propertyNames = objectPropertyNames.releaseData();
+                m_structure = structure;
+                // Keep the structure alive so that the identity check below cannot be fooled by a new structure allocated at the same address.
+                stringifier.m_objectStack.appendWithCrashOnOverflow(structure);
+            } else {
                 PropertyNameArray objectPropertyNames(&vm, PropertyNameMode::Strings, PrivateSymbolMode::Exclude);
                 m_object->methodTable(vm)->getOwnPropertyNames(m_object, exec, objectPropertyNames, EnumerationMode());
                 RETURN_IF_EXCEPTION(scope, false);
@@ -545,14 +639,19 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
         ASSERT(stringifyResult != StringifyFailedDueToUndefinedOrSymbolValue);
     } else {
         // Get the value.
-        PropertySlot slot(m_object, PropertySlot::InternalMethodType::Get);
         Identifier& propertyName = m_propertyNames->propertyNameVector()[index];
-        bool hasProperty = m_object->getPropertySlot(exec, propertyName, slot);
-        EXCEPTION_ASSERT(!scope.exception() || !hasProperty);
-        if (!hasProperty)
-            return true;
-        JSValue value = slot.getValue(exec, propertyName);
-        RETURN_IF_EXCEPTION(scope, false);
+        JSValue value;
+        if (m_structure && m_object->structure(vm) == m_structure)
+            value = m_object->getDirect(m_propertyOffsets[index]);
+        else {
+            PropertySlot slot(m_object, PropertySlot::InternalMethodType::Get);
+            bool hasProperty = m_object->getPropertySlot(exec, propertyName, slot);
+            EXCEPTION_ASSERT(!scope.exception() || !hasProperty);
+            if (!hasProperty)
+                return true;
+            value = slot.getValue(exec, propertyName);
+            RETURN_IF_EXCEPTION(scope, false);
+        }
 
         rollBackPoint = builder.length();
 
@@ -66,23 +66,24 @@ bool JSSet::isIteratorProtocolFastAndNonObservable()
     return true;
 }
 
-bool JSSet::canCloneFastAndNonObservable(Structure* structure)
+bool JSSet::isAddFastAndNonObservable(Structure* structure)
 {
-    auto addFastAndNonObservable = [&] (Structure* structure) {
-        JSGlobalObject* globalObject = structure->globalObject();
-        if (!globalObject->isSetPrototypeAddFastAndNonObservable())
-            return false;
+    JSGlobalObject* globalObject = structure->globalObject();
+    if (!globalObject->isSetPrototypeAddFastAndNonObservable())
+        return false;
 
-        if (structure->hasPolyProto())
-            return false;
+    if (structure->hasPolyProto())
+        return false;
 
-        if (structure->storedPrototype() != globalObject->jsSetPrototype())
-            return false;
+    if (structure->storedPrototype() != globalObject->jsSetPrototype())
+        return false;
 
-        return true;
-    };
+    return true;
+}
 
-    return isIteratorProtocolFastAndNonObservable() && addFastAndNonObservable(structure);
+bool JSSet::canCloneFastAndNonObservable(Structure* structure)
+{
+    return isIteratorProtocolFastAndNonObservable() && isAddFastAndNonObservable(structure);
 }
 
 }
@@ -57,6 +57,9 @@ public:
     bool canCloneFastAndNonObservable(Structure*);
     JSSet* clone(ExecState*, VM&, Structure*);
 
+    // True if calling "add" on a set with this structure is known to invoke Set.prototype.add.
+    static bool isAddFastAndNonObservable(Structure*);
+
 private:
     JSSet(VM& vm, Structure* structure)
         : Base(vm, structure)
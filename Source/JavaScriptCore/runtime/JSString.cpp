@@ -75,6 +75,11 @@ void JSString::dumpToStream(const JSCell* cell, PrintStream& out)
 
 bool JSString::equalSlowCase(ExecState* exec, JSString* other) const
 {
+    // Strings of different lengths differ no matter what their characters are, so there is no
+    // need to resolve ropes to find out.
+    if (length() != other->length())
+        return false;
+
     VM& vm = exec->vm();
     auto scope = DECLARE_THROW_SCOPE(vm);
     String str1 = value(exec);
@@ -214,6 +219,42 @@ void JSRopeString::clearFibers() const
         u[i].number = 0;
 }
 
+// Walks down the rope to the fiber that holds all of the characters [offset, offset + length) and
+// rebases {offset} onto it. The fiber is either resolved or a substring, so it can be viewed
+// without resolving anything. Returns null, leaving {offset} alone, if the characters span more than
+// one fiber or the fiber is more than s_maxFiberSearchDepth levels down.
+JSString* JSRopeString::findFiberContaining(unsigned& offset, unsigned length) const
+{
+    ASSERT(isRope() && !isSubstring());
+    ASSERT(offset <= this->length() && length <= this->length() - offset);
+
+    const JSRopeString* rope = this;
+    unsigned fiberOffset = offset;
+    for (unsigned depth = 0; depth < s_maxFiberSearchDepth; ++depth) {
+        JSString* containingFiber = nullptr;
+        for (size_t i = 0; i < s_maxInternalRopeLength; ++i) {
+            JSString* fiber = rope->fiber(i).get();
+            if (!fiber)
+                break;
+            if (fiberOffset < fiber->length()) {
+                if (length > fiber->length() - fiberOffset)
+                    return nullptr;
+                containingFiber = fiber;
+                break;
+            }
+            fiberOffset -= fiber->length();
+        }
+        if (!containingFiber)
+            return nullptr;
+        if (!containingFiber->isRope() || containingFiber->isSubstring()) {
+            offset = fiberOffset;
+            return containingFiber;
+        }
+        rope = static_cast<const JSRopeString*>(containingFiber);
+    }
+    return nullptr;
+}
+
 RefPtr<AtomicStringImpl> JSRopeString::resolveRopeToExistingAtomicString(ExecState* exec) const
 {
     if (length() > maxLengthForOnStackResolve) {
@@ -160,6 +160,9 @@ public:
     RefPtr<AtomicStringImpl> toExistingAtomicString(ExecState*) const;
 
     StringViewWithUnderlyingString viewWithUnderlyingString(ExecState*) const;
+    // Views the characters [offset, offset + length). When they all come from one fiber of a rope,
+    // this views that fiber instead of resolving the rope.
+    StringViewWithUnderlyingString viewWithUnderlyingString(ExecState*, unsigned offset, unsigned length) const;
 
     inline bool equal(ExecState*, JSString* other) const;
     const String& value(ExecState*) const;
@@ -330,8 +333,21 @@ private:
         RELEASE_ASSERT(!sumOverflows<int32_t>(offset, length));
         RELEASE_ASSERT(offset + length <= base->length());
         setLength(length);
-        setIs8Bit(base->is8Bit());
         setIsSubstring(true);
+        if (base->isRope() && !base->isSubstring()) {
+            // A substring that lies within one fiber of a rope is a substring of that fiber, which
+            // saves us from resolving the whole rope.
+            JSRopeString* baseRope = jsCast<JSRopeString*>(base);
+            if (JSString* fiber = baseRope->findFiberContaining(offset, length))
+                base = fiber;
+            else {
+                // For now, let's not allow substrings with a rope base.
+                // Resolve non-substring rope bases so we don't have to deal with it.
+                // FIXME: Evaluate if this would be worth adding more branches.
+                baseRope->resolveRope(exec);
+            }
+        }
+        setIs8Bit(base->is8Bit());
         if (base->isSubstring()) {
             JSRopeString* baseRope = jsCast<JSRopeString*>(base);
             substringBase().set(vm, this, baseRope->substringBase().get());
@@ -339,12 +355,6 @@ private:
         } else {
             substringBase().set(vm, this, base);
             substringOffset() = offset;
-
-            // For now, let's not allow substrings with a rope base.
-            // Resolve non-substring rope bases so we don't have to deal with it.
-            // FIXME: Evaluate if this would be worth adding more branches.
-            if (base->isRope())
-                jsCast<JSRopeString*>(base)->resolveRope(exec);
         }
     }
 
@@ -409,6 +419,10 @@ public:
 
     static const unsigned s_maxInternalRopeLength = 3;
 
+    // How many levels of a rope we walk down looking for the fiber that holds some characters
+    // before we give up and resolve the rope instead.
+    static const unsigned s_maxFiberSearchDepth = 32;
+
 private:
     static JSString* create(VM& vm, JSString* s1, JSString* s2)
     {
@@ -439,6 +453,7 @@ private:
     void resolveRopeInternal16(UChar*) const;
     void resolveRopeInternal16NoSubstring(UChar*) const;
     void clearFibers() const;
+    JSString* findFiberContaining(unsigned& offset, unsigned length) const;
     StringView unsafeView(ExecState*) const;
     StringViewWithUnderlyingString viewWithUnderlyingString(ExecState*) const;
 
@@ -570,9 +585,9 @@ inline JSString* JSString::getIndex(ExecState* exec, unsigned i)
     VM& vm = exec->vm();
     auto scope = DECLARE_THROW_SCOPE(vm);
     ASSERT(canGetIndex(i));
-    StringView view = unsafeView(exec);
+    StringView view = viewWithUnderlyingString(exec, i, 1).view;
     RETURN_IF_EXCEPTION(scope, nullptr);
-    return jsSingleCharacterString(exec, view[i]);
+    return jsSingleCharacterString(exec, view[0]);
 }
 
 inline JSString* jsString(VM* vm, const String& s)
@@ -767,6 +782,20 @@ ALWAYS_INLINE StringViewWithUnderlyingString JSString::viewWithUnderlyingString(
     return { m_value, m_value };
 }
 
+inline StringViewWithUnderlyingString JSString::viewWithUnderlyingString(ExecState* exec, unsigned offset, unsigned length) const
+{
+    ASSERT(offset <= this->length() && length <= this->length() - offset);
+    if (!length)
+        return { StringView(emptyString()), emptyString() };
+    const JSString* string = this;
+    if (isRope() && !isSubstring()) {
+        if (JSString* fiber = static_cast<const JSRopeString*>(this)->findFiberContaining(offset, length))
+            string = fiber;
+    }
+    auto viewWithString = string->viewWithUnderlyingString(exec);
+    return { viewWithString.view.substring(offset, length), WTFMove(viewWithString.underlyingString) };
+}
+
 inline bool JSString::isSubstring() const
 {
     return isRope() && static_cast<const JSRopeString*>(this)->isSubstring();
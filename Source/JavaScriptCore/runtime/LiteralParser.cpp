@@ -36,6 +36,7 @@
 #include "JSCInlines.h"
 #include "StrongInlines.h"
 #include <wtf/ASCIICType.h>
+#include <wtf/UnalignedAccess.h>
 #include <wtf/dtoa.h>
 #include <wtf/text/StringConcatenate.h>
 
@@ -582,16 +583,46 @@ static ALWAYS_INLINE bool isSafeStringCharacter(UChar c, UChar terminator)
     return (c >= ' ' && (set == SafeStringCharacterSet::Strict || c <= 0xff) && c != '\\' && c != terminator) || (c == '\t' && set != SafeStringCharacterSet::Strict);
 }
 
+// Skips the run of characters that isSafeStringCharacter<SafeStringCharacterSet::Strict> accepts,
+// testing a machine word's worth of characters at a time. A word is only handed to the scalar loop
+// once it contains a control character, a backslash or the terminator somewhere.
+template <typename CharType>
+static ALWAYS_INLINE const CharType* skipStrictSafeStringCharacters(const CharType* ptr, const CharType* end, CharType terminator)
+{
+    static_assert(sizeof(CharType) == 1 || sizeof(CharType) == 2, "");
+    constexpr unsigned charactersPerWord = sizeof(uint64_t) / sizeof(CharType);
+    constexpr uint64_t ones = std::numeric_limits<uint64_t>::max() / std::numeric_limits<typename std::make_unsigned<CharType>::type>::max();
+    constexpr uint64_t highBits = ones << (8 * sizeof(CharType) - 1);
+
+    // Each of these may flag extra lanes after the first real match, but never misses one.
+    auto hasLaneLessThan = [&] (uint64_t word, CharType value) {
+        return (word - ones * value) & ~word & highBits;
+    };
+    auto hasLaneEqualTo = [&] (uint64_t word, CharType value) {
+        return hasLaneLessThan(word ^ (ones * value), 1);
+    };
+
+    while (static_cast<size_t>(end - ptr) >= charactersPerWord) {
+        uint64_t word = WTF::unalignedLoad<uint64_t>(ptr);
+        if (hasLaneLessThan(word, ' ') | hasLaneEqualTo(word, '\\') | hasLaneEqualTo(word, terminator))
+            break;
+        ptr += charactersPerWord;
+    }
+
+    while (ptr < end && isSafeStringCharacter<SafeStringCharacterSet::Strict>(*ptr, terminator))
+        ++ptr;
+    return ptr;
+}
+
 template <typename CharType>
 ALWAYS_INLINE TokenType LiteralParser<CharType>::Lexer::lexString(LiteralParserToken<CharType>& token, CharType terminator)
 {
     ++m_ptr;
     const CharType* runStart = m_ptr;
 
-    if (m_mode == StrictJSON) {
-        while (m_ptr < m_end && isSafeStringCharacter<SafeStringCharacterSet::Strict>(*m_ptr, terminator))
-            ++m_ptr;
-    } else {
+    if (m_mode == StrictJSON)
+        m_ptr = skipStrictSafeStringCharacters(m_ptr, m_end, terminator);
+    else {
         while (m_ptr < m_end && isSafeStringCharacter<SafeStringCharacterSet::NonStrict>(*m_ptr, terminator))
             ++m_ptr;
     }
@@ -613,10 +644,9 @@ TokenType LiteralParser<CharType>::Lexer::lexStringSlow(LiteralParserToken<CharT
     goto slowPathBegin;
     do {
         runStart = m_ptr;
-        if (m_mode == StrictJSON) {
-            while (m_ptr < m_end && isSafeStringCharacter<SafeStringCharacterSet::Strict>(*m_ptr, terminator))
-                ++m_ptr;
-        } else {
+        if (m_mode == StrictJSON)
+            m_ptr = skipStrictSafeStringCharacters(m_ptr, m_end, terminator);
+        else {
             while (m_ptr < m_end && isSafeStringCharacter<SafeStringCharacterSet::NonStrict>(*m_ptr, terminator))
                 ++m_ptr;
         }
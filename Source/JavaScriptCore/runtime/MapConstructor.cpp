@@ -80,7 +80,18 @@ static EncodedJSValue JSC_HOST_CALL constructMap(ExecState* exec)
             RELEASE_AND_RETURN(scope, JSValue::encode(iterableMap->clone(exec, vm, mapStructure)));
     }
 
-    JSMap* map = JSMap::create(exec, vm, mapStructure);
+    JSArray* array = nullptr;
+    if (isJSArray(iterable) && jsCast<JSArray*>(iterable)->isIteratorProtocolFastAndNonObservable())
+        array = jsCast<JSArray*>(iterable);
+
+    // Size the table for the array up front so that we don't rehash repeatedly while filling it. Holey
+    // and sparse arrays can have a length far beyond what they store, so cap the hint at the storage
+    // the array has already allocated.
+    uint32_t sizeHint = 0;
+    if (array)
+        sizeHint = std::min(array->length(), array->getVectorLength());
+
+    JSMap* map = JSMap::create(exec, vm, mapStructure, sizeHint);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
 
     JSValue adderFunction = map->JSObject::get(exec, vm.propertyNames->set);
@@ -91,6 +102,37 @@ static EncodedJSValue JSC_HOST_CALL constructMap(ExecState* exec)
     if (adderFunctionCallType == CallType::None)
         return JSValue::encode(throwTypeError(exec, scope));
 
+    if (array && JSMap::isSetFastAndNonObservable(mapStructure)) {
+        // Iterating such an array is the same as reading each index below its current length, and the
+        // adder is the original Map.prototype.set, so we can skip both the iterator and the calls. We
+        // only take entries that are arrays whose key and value can be read without running any user
+        // code. Until we hit one that isn't, nothing observable has happened, so we can throw away what
+        // we added and start over with the generic loop. That loop also handles IteratorClose when an
+        // entry is not an object.
+        bool filledFromArray = true;
+        for (unsigned index = 0; index < array->length(); ++index) {
+            if (!array->canGetIndexQuickly(index)) {
+                filledFromArray = false;
+                break;
+            }
+            JSValue nextItem = array->getIndexQuickly(index);
+            if (!isJSArray(nextItem)) {
+                filledFromArray = false;
+                break;
+            }
+            JSArray* entry = asArray(nextItem);
+            if (!entry->canGetIndexQuickly(0) || !entry->canGetIndexQuickly(1)) {
+                filledFromArray = false;
+                break;
+            }
+            map->set(exec, entry->getIndexQuickly(0), entry->getIndexQuickly(1));
+            RETURN_IF_EXCEPTION(scope, encodedJSValue());
+        }
+        if (filledFromArray)
+            return JSValue::encode(map);
+        map->clear(exec);
+    }
+
     scope.release();
     forEachInIterable(exec, iterable, [&](VM& vm, ExecState* exec, JSValue nextItem) {
         auto scope = DECLARE_THROW_SCOPE(vm);
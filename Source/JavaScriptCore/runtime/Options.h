@@ -210,6 +210,7 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(bool, reportTotalCompileTimes, false, Normal, nullptr) \
     v(bool, reportParseTimes, false, Normal, "dumps JS function signature and the time it took to parse") \
     v(bool, reportBytecodeCompileTimes, false, Normal, "dumps JS function signature and the time it took to bytecode compile") \
+    v(bool, reportStartupTimes, false, Normal, "dumps the time it took to create each VM, to initialize each JSGlobalObject, and to instantiate and first call into each WebAssembly module") \
     v(bool, verboseExitProfile, false, Normal, nullptr) \
     v(bool, verboseCFA, false, Normal, nullptr) \
     v(bool, verboseDFGFailure, false, Normal, nullptr) \
@@ -219,6 +220,9 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(bool, testTheFTL, false, Normal, nullptr) \
     v(bool, verboseSanitizeStack, false, Normal, nullptr) \
     v(bool, useGenerationalGC, true, Normal, nullptr) \
+    v(bool, usePretenuring, false, Normal, "If true, allocation sites whose objects reliably survive collection will allocate them as old objects.") \
+    v(unsigned, pretenuringMinimumSampleCount, 8, Normal, nullptr) \
+    v(double, pretenuringSurvivalRateThreshold, 0.9, Normal, nullptr) \
     v(bool, useConcurrentBarriers, true, Normal, nullptr) \
     v(bool, useConcurrentGC, true, Normal, nullptr) \
     v(bool, collectContinuously, false, Normal, nullptr) \
@@ -269,6 +273,7 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(bool, enableJITDebugAssertions, !ASSERT_DISABLED, Normal, nullptr) \
     v(bool, useAccessInlining, true, Normal, nullptr) \
     v(unsigned, maxAccessVariantListSize, 8, Normal, nullptr) \
+    v(bool, useSharedPolymorphicAccessStubs, false, Normal, "If true, polymorphic access stubs that make no calls are shared by every inline cache of the VM that generates the same code.") \
     v(bool, usePolyvariantDevirtualization, true, Normal, nullptr) \
     v(bool, usePolymorphicAccessInlining, true, Normal, nullptr) \
     v(unsigned, maxPolymorphicAccessInliningListSize, 8, Normal, nullptr) \
@@ -329,6 +334,9 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(int32, thresholdForJITAfterWarmUp, 500, Normal, nullptr) \
     v(int32, thresholdForJITSoon, 100, Normal, nullptr) \
     \
+    v(optionString, warmStartProfileInputFile, nullptr, Normal, "file of profiles and tiers from a previous run, written by warmStartProfileOutputFile, to seed new CodeBlocks with") \
+    v(optionString, warmStartProfileOutputFile, nullptr, Normal, "file to write each function's profiles and the highest tier it reached to at exit") \
+    \
     v(int32, thresholdForOptimizeAfterWarmUp, 1000, Normal, nullptr) \
     v(int32, thresholdForOptimizeAfterLongWarmUp, 1000, Normal, nullptr) \
     v(int32, thresholdForOptimizeSoon, 1000, Normal, nullptr) \
@@ -370,8 +378,10 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     \
     v(unsigned, minimumNumberOfScansBetweenRebalance, 100, Normal, nullptr) \
     v(unsigned, numberOfGCMarkers, computeNumberOfGCMarkers(8), Normal, nullptr) \
+    v(bool, useWorkStealingMarkStacks, false, Normal, "If true, parallel markers offer full mark stack segments to each other through per-marker steal queues instead of donating through the shared mark stack.") \
     v(bool, useParallelMarkingConstraintSolver, true, Normal, nullptr) \
     v(unsigned, opaqueRootMergeThreshold, 1000, Normal, nullptr) \
+    v(unsigned, gcTelemetryRecordCount, 32, Normal, "number of recent collections whose per-phase statistics are kept by Heap::telemetry(); 0 disables recording") \
     v(double, minHeapUtilization, 0.8, Normal, nullptr) \
     v(double, minMarkedBlockUtilization, 0.9, Normal, nullptr) \
     v(unsigned, slowPathAllocsBetweenGCs, 0, Normal, "force a GC on every Nth slow path alloc, where N is specified by this option") \
@@ -398,6 +408,9 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(bool, logHeapStatisticsAtExit, false, Normal, nullptr) \
     v(bool, forceCodeBlockToJettisonDueToOldAge, false, Normal, "If true, this means that anytime we can jettison a CodeBlock due to old age, we do.") \
     v(bool, useEagerCodeBlockJettisonTiming, false, Normal, "If true, the time slices for jettisoning a CodeBlock due to old age are shrunk significantly.") \
+    v(bool, useColdCodeEviction, true, Normal, "If true, GC throws away optimized code and baseline inline cache stubs that have not run recently once executable memory runs short.") \
+    v(double, coldCodeEvictionThreshold, 0.5, Normal, "fraction of the executable memory pool that may be allocated or lost to fragmentation before cold code is evicted") \
+    v(double, coldCodeEvictionAge, 10, Normal, "seconds a CodeBlock must go without running before it can be evicted as cold") \
     \
     v(bool, useTypeProfiler, false, Normal, nullptr) \
     v(bool, useControlFlowProfiler, false, Normal, nullptr) \
@@ -408,6 +421,7 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(unsigned, samplingProfilerTopFunctionsCount, 12, Normal, "Number of top functions to report when using the command line interface.") \
     v(unsigned, samplingProfilerTopBytecodesCount, 40, Normal, "Number of top bytecodes to report when using the command line interface.") \
     v(optionString, samplingProfilerPath, nullptr, Normal, "The path to the directory to write sampiling profiler output to. This probably will not work with WK2 unless the path is in the whitelist.") \
+    v(bool, samplingProfilerCPUProfile, false, Normal, "If true, the sampling profiler records JIT tiers and writes a Chrome DevTools .cpuprofile to samplingProfilerPath instead of the top functions and bytecodes report.") \
     v(bool, sampleCCode, false, Normal, "Causes the sampling profiler to record profiling data for C frames.") \
     \
     v(bool, alwaysGeneratePCToCodeOriginMap, false, Normal, "This will make sure we always generate a PCToCodeOriginMap for JITed code.") \
@@ -444,6 +458,7 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(bool, coalesceSpillSlots, true, Normal, nullptr) \
     v(bool, logAirRegisterPressure, false, Normal, nullptr) \
     v(bool, useB3TailDup, true, Normal, nullptr) \
+    v(bool, useB3StorePacking, true, Normal, "If true, B3 packs adjacent narrow stores of constants or copied memory into wider stores.") \
     v(unsigned, maxB3TailDupBlockSize, 3, Normal, nullptr) \
     v(unsigned, maxB3TailDupBlockSuccessors, 3, Normal, nullptr) \
     \
@@ -461,6 +476,13 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(unsigned, prototypeHitCountForLLIntCaching, 2, Normal, "Number of prototype property hits before caching a prototype in the LLInt. A count of 0 means never cache.") \
     \
     v(bool, dumpCompiledRegExpPatterns, false, Normal, nullptr) \
+    v(bool, useRegExpLazyDFA, true, Normal, "matches RegExps prone to catastrophic backtracking with a linear-time lazy DFA when the pattern allows it") \
+    v(bool, forceRegExpLazyDFA, false, Normal, "uses the lazy DFA for every RegExp it supports, not only backtracking-prone ones") \
+    v(unsigned, maximumRegExpLazyDFAStates, 256, Normal, "number of states a RegExp lazy DFA caches before flushing its cache") \
+    v(bool, useRegExpRequiredLiteralScan, true, Normal, "skips RegExp start positions at which a literal every match contains cannot occur") \
+    \
+    v(unsigned, minimumTypedArrayLengthForRadixSort, 256, Normal, "typed arrays at least this long are sorted with a radix sort when no comparator is given") \
+    v(unsigned, minimumTypedArrayLengthForParallelSort, 1 << 20, Normal, "typed arrays at least this long are radix sorted on helper threads") \
     \
     v(bool, dumpModuleRecord, false, Normal, nullptr) \
     v(bool, dumpModuleLoadingState, false, Normal, nullptr) \
@@ -483,10 +505,13 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(unsigned, webAssemblyBBQOptimizationLevel, 1, Normal, "B3 Optimization level for BBQ Web Assembly module compilations.") \
     v(unsigned, webAssemblyOMGOptimizationLevel, Options::defaultB3OptLevel(), Normal, "B3 Optimization level for OMG Web Assembly module compilations.") \
     \
+    v(bool, useWebAssemblyInterpreter, false, Normal, "If true, WebAssembly functions start out in an in-place interpreter and tier up to BBQ once they are warm.") \
+    v(unsigned, webAssemblyBBQTierUpCount, 1000, Normal, "The countdown before we tier up a function from the interpreter to BBQ.") \
     v(bool, useBBQTierUpChecks, true, Normal, "Enables tier up checks for our BBQ code.") \
     v(unsigned, webAssemblyOMGTierUpCount, 5000, Normal, "The countdown before we tier up a function to OMG.") \
     v(unsigned, webAssemblyLoopDecrement, 15, Normal, "The amount the tier up countdown is decremented on each loop backedge.") \
     v(unsigned, webAssemblyFunctionEntryDecrement, 1, Normal, "The amount the tier up countdown is decremented on each function entry.") \
+    v(bool, useWebAssemblyOSR, true, Normal, "If true, BBQ loops whose tier up countdown trips will OSR enter OMG code compiled for that loop.") \
     \
     /* FIXME: enable fast memories on iOS and pre-allocate them. https://bugs.webkit.org/show_bug.cgi?id=170774 */ \
     v(bool, useWebAssemblyFastMemory, !isIOS(), Normal, "If true, we will try to use a 32-bit address space with a signal handler to bounds check wasm memory.") \
@@ -496,8 +521,12 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(unsigned, maxNumWebAssemblyFastMemories, 4, Normal, nullptr) \
     v(bool, useFastTLSForWasmContext, true, Normal, "If true, we will store context in fast TLS. If false, we will pin it to a register.") \
     v(bool, useWebAssemblyStreamingApi, enableWebAssemblyStreamingApi, Normal, "Allow to run WebAssembly's Streaming API") \
+    v(bool, useWebAssemblyBulkMemory, true, Normal, "Allow the memory.copy and memory.fill operations from the WebAssembly bulk memory proposal.") \
     v(bool, useCallICsForWebAssemblyToJSCalls, true, Normal, "If true, we will use CallLinkInfo to inline cache Wasm to JS calls.") \
     v(bool, useEagerWebAssemblyModuleHashing, false, Normal, "Unnamed WebAssembly modules are identified in backtraces through their hash, if available.") \
+    v(bool, useWebAssemblyModuleCache, false, Normal, "If true, compiling the same WebAssembly module bytes again reuses the already compiled Wasm::Module and its code.") \
+    v(size, webAssemblyModuleCacheSize, 64 * MB, Normal, "Maximum total size in bytes of the module sources whose compiled code the WebAssembly module cache keeps alive.") \
+    v(bool, dumpWebAssemblyModuleCacheStatistics, false, Normal, "Logs WebAssembly module cache hits and misses.") \
     v(bool, useBigInt, false, Normal, "If true, we will enable BigInt support.") \
     v(bool, useIntlNumberFormatToParts, enableIntlNumberFormatToParts, Normal, "If true, we will enable Intl.NumberFormat.prototype.formatToParts") \
     v(bool, useIntlPluralRules, enableIntlPluralRules, Normal, "If true, we will enable Intl.PluralRules.") \
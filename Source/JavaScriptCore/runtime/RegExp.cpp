@@ -243,6 +243,8 @@ size_t RegExp::estimatedSize(JSCell* cell, VM& vm)
 {
     RegExp* thisObject = static_cast<RegExp*>(cell);
     size_t regexDataSize = thisObject->m_regExpBytecode ? thisObject->m_regExpBytecode->estimatedSizeInBytes() : 0;
+    if (thisObject->m_regExpLazyDFA)
+        regexDataSize += thisObject->m_regExpLazyDFA->estimatedSize();
 #if ENABLE(YARR_JIT)
     regexDataSize += thisObject->m_regExpJITCode.size();
 #endif
@@ -285,6 +287,15 @@ void RegExp::byteCodeCompileIfNecessary(VM* vm)
     m_regExpBytecode = byteCodeCompilePattern(vm, pattern);
 }
 
+void RegExp::compileLazyDFAIfProfitable(Yarr::YarrPattern& pattern)
+{
+    if (m_regExpLazyDFA || !Options::useRegExpLazyDFA())
+        return;
+    if (!Options::forceRegExpLazyDFA() && !Yarr::YarrLazyDFA::isBacktrackingProne(pattern))
+        return;
+    m_regExpLazyDFA = Yarr::YarrLazyDFA::create(pattern);
+}
+
 void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
 {
     ConcurrentJSLocker locker(m_lock);
@@ -302,6 +313,8 @@ void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
         m_state = ByteCode;
     }
 
+    compileLazyDFAIfProfitable(pattern);
+
 #if ENABLE(YARR_JIT)
     if (!pattern.containsUnsignedLengthPattern() && VM::canUseRegExpJIT()
 #if !ENABLE(YARR_JIT_BACKREFERENCES)
@@ -359,6 +372,8 @@ void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
         m_state = ByteCode;
     }
 
+    compileLazyDFAIfProfitable(pattern);
+
 #if ENABLE(YARR_JIT)
     if (!pattern.containsUnsignedLengthPattern() && VM::canUseRegExpJIT()
 #if !ENABLE(YARR_JIT_BACKREFERENCES)
@@ -409,6 +424,7 @@ void RegExp::deleteCode()
     m_regExpJITCode.clear();
 #endif
     m_regExpBytecode = nullptr;
+    m_regExpLazyDFA = nullptr;
 }
 
 #if ENABLE(YARR_JIT_DEBUG)
@@ -32,6 +32,7 @@
 #if ENABLE(YARR_JIT)
 #include "YarrJIT.h"
 #endif
+#include "YarrLazyDFA.h"
 
 namespace JSC {
 
@@ -153,6 +154,9 @@ private:
     void compileMatchOnly(VM*, Yarr::YarrCharSize);
     void compileIfNecessaryMatchOnly(VM&, Yarr::YarrCharSize);
 
+    void compileLazyDFAIfProfitable(Yarr::YarrPattern&);
+    bool matchWithLazyDFA(const String&, unsigned startOffset, MatchResult&);
+
 #if ENABLE(YARR_JIT_DEBUG)
     void matchCompareWithInterpreter(const String&, int startOffset, int* offsetVector, int jitResult);
 #endif
@@ -166,6 +170,7 @@ private:
     Vector<String> m_captureGroupNames;
     HashMap<String, unsigned> m_namedGroupToParenIndex;
     std::unique_ptr<Yarr::BytecodePattern> m_regExpBytecode;
+    std::unique_ptr<Yarr::YarrLazyDFA> m_regExpLazyDFA;
 #if ENABLE(REGEXP_TRACING)
     double m_rtMatchOnlyTotalSubjectStringLen { 0.0 };
     double m_rtMatchTotalSubjectStringLen { 0.0 };
@@ -129,6 +129,14 @@ ALWAYS_INLINE void RegExp::compileIfNecessary(VM& vm, Yarr::YarrCharSize charSiz
     compile(&vm, charSize);
 }
 
+ALWAYS_INLINE bool RegExp::matchWithLazyDFA(const String& s, unsigned startOffset, MatchResult& result)
+{
+    // The DFA builds its states while matching, so only the main thread may use it.
+    if (!m_regExpLazyDFA || isCompilationThread() || s.length() > INT_MAX)
+        return false;
+    return m_regExpLazyDFA->match(s, startOffset, result);
+}
+
 template<typename VectorType>
 ALWAYS_INLINE int RegExp::matchInline(VM& vm, const String& s, unsigned startOffset, VectorType& ovector)
 {
@@ -152,6 +160,25 @@ ALWAYS_INLINE int RegExp::matchInline(VM& vm, const String& s, unsigned startOff
     ovector.resize(offsetVectorSize);
     int* offsetVector = ovector.data();
 
+    MatchResult lazyDFAResult;
+    if (matchWithLazyDFA(s, startOffset, lazyDFAResult)) {
+        if (!lazyDFAResult) {
+            std::fill(offsetVector, offsetVector + offsetVectorSize, -1);
+            return -1;
+        }
+#if ENABLE(REGEXP_TRACING)
+        m_rtMatchFoundCount++;
+#endif
+        if (!m_numSubpatterns) {
+            offsetVector[0] = lazyDFAResult.start;
+            offsetVector[1] = lazyDFAResult.end;
+            return lazyDFAResult.start;
+        }
+        // Only the backtracking engines record captures. Starting them where the match is known to
+        // begin spares them every failed attempt at an earlier position.
+        startOffset = lazyDFAResult.start;
+    }
+
     int result;
 #if ENABLE(YARR_JIT)
     if (m_state == JITCode) {
@@ -272,6 +299,15 @@ ALWAYS_INLINE MatchResult RegExp::matchInline(VM& vm, const String& s, unsigned
         return MatchResult::failed();
     }
 
+    MatchResult lazyDFAResult;
+    if (matchWithLazyDFA(s, startOffset, lazyDFAResult)) {
+#if ENABLE(REGEXP_TRACING)
+        if (lazyDFAResult)
+            m_rtMatchOnlyFoundCount++;
+#endif
+        return lazyDFAResult;
+    }
+
 #if ENABLE(YARR_JIT)
     MatchResult result;
 
@@ -68,6 +68,11 @@ static const bool sReportStats = false;
 using FrameType = SamplingProfiler::FrameType;
 using UnprocessedStackFrame = SamplingProfiler::UnprocessedStackFrame;
 
+static bool shouldCollectCodeLocationDetails()
+{
+    return Options::collectSamplingProfilerDataForJSCShell() || Options::samplingProfilerCPUProfile();
+}
+
 ALWAYS_INLINE static void reportStats()
 {
     if (sReportStats && sNumTotalWalks && static_cast<uint64_t>(sNumTotalWalks) % sNumWalkReportingFrequency == 0) {
@@ -472,7 +477,7 @@ void SamplingProfiler::processUnverifiedStackTraces()
                     location.lineNumber, location.columnNumber);
                 location.bytecodeIndex = bytecodeIndex;
             }
-            if (Options::collectSamplingProfilerDataForJSCShell()) {
+            if (shouldCollectCodeLocationDetails()) {
                 location.codeBlockHash = codeBlock->hash();
                 location.jitType = codeBlock->jitType();
             }
@@ -493,7 +498,7 @@ void SamplingProfiler::processUnverifiedStackTraces()
             StackFrame& stackFrame = stackTrace.frames.last();
             bool alreadyHasExecutable = !!stackFrame.executable;
             if (calleeBits.isWasm()) {
-                stackFrame.frameType = FrameType::Unknown;
+                stackFrame.frameType = FrameType::Wasm;
                 return;
             }
 
@@ -558,7 +563,7 @@ void SamplingProfiler::processUnverifiedStackTraces()
                 appendCodeBlock(codeOrigin.inlineCallFrame ? codeOrigin.inlineCallFrame->baselineCodeBlock.get() : machineCodeBlock, codeOrigin.bytecodeIndex);
             });
 
-            if (Options::collectSamplingProfilerDataForJSCShell()) {
+            if (shouldCollectCodeLocationDetails()) {
                 RELEASE_ASSERT(machineOrigin.isSet());
                 RELEASE_ASSERT(!machineOrigin.inlineCallFrame);
 
@@ -772,6 +777,8 @@ String SamplingProfiler::StackFrame::displayName(VM& vm)
     }
     if (frameType == FrameType::Host)
         return "(host)"_s;
+    if (frameType == FrameType::Wasm)
+        return "(wasm)"_s;
 
     if (executable->isHostFunction())
         return static_cast<NativeExecutable*>(executable)->name();
@@ -795,7 +802,7 @@ String SamplingProfiler::StackFrame::displayNameForJSONTests(VM& vm)
             return name;
     }
 
-    if (frameType == FrameType::Unknown || frameType == FrameType::C)
+    if (frameType == FrameType::Unknown || frameType == FrameType::Wasm || frameType == FrameType::C)
         return "(unknown)"_s;
     if (frameType == FrameType::Host)
         return "(host)"_s;
@@ -822,7 +829,7 @@ String SamplingProfiler::StackFrame::displayNameForJSONTests(VM& vm)
 
 int SamplingProfiler::StackFrame::functionStartLine()
 {
-    if (frameType == FrameType::Unknown || frameType == FrameType::Host || frameType == FrameType::C)
+    if (frameType == FrameType::Unknown || frameType == FrameType::Host || frameType == FrameType::Wasm || frameType == FrameType::C)
         return -1;
 
     if (executable->isHostFunction())
@@ -832,7 +839,7 @@ int SamplingProfiler::StackFrame::functionStartLine()
 
 unsigned SamplingProfiler::StackFrame::functionStartColumn()
 {
-    if (frameType == FrameType::Unknown || frameType == FrameType::Host || frameType == FrameType::C)
+    if (frameType == FrameType::Unknown || frameType == FrameType::Host || frameType == FrameType::Wasm || frameType == FrameType::C)
         return std::numeric_limits<unsigned>::max();
 
     if (executable->isHostFunction())
@@ -843,7 +850,7 @@ unsigned SamplingProfiler::StackFrame::functionStartColumn()
 
 intptr_t SamplingProfiler::StackFrame::sourceID()
 {
-    if (frameType == FrameType::Unknown || frameType == FrameType::Host || frameType == FrameType::C)
+    if (frameType == FrameType::Unknown || frameType == FrameType::Host || frameType == FrameType::Wasm || frameType == FrameType::C)
         return -1;
 
     if (executable->isHostFunction())
@@ -854,7 +861,7 @@ intptr_t SamplingProfiler::StackFrame::sourceID()
 
 String SamplingProfiler::StackFrame::url()
 {
-    if (frameType == FrameType::Unknown || frameType == FrameType::Host || frameType == FrameType::C)
+    if (frameType == FrameType::Unknown || frameType == FrameType::Host || frameType == FrameType::Wasm || frameType == FrameType::C)
         return emptyString();
 
     if (executable->isHostFunction())
@@ -866,6 +873,31 @@ String SamplingProfiler::StackFrame::url()
     return url;
 }
 
+const char* SamplingProfiler::StackFrame::tierName() const
+{
+    switch (frameType) {
+    case FrameType::Executable: {
+        if (executable->isHostFunction())
+            return "Host";
+        // Inlined frames report the tier of the machine frame they were inlined into.
+        JITCode::JITType jitType = machineLocation ? machineLocation->first.jitType : semanticLocation.jitType;
+        if (jitType == JITCode::None)
+            return "Unknown";
+        return JITCode::typeName(jitType);
+    }
+    case FrameType::Host:
+        return "Host";
+    case FrameType::Wasm:
+        return "Wasm";
+    case FrameType::C:
+        return "C";
+    case FrameType::Unknown:
+        return "Unknown";
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
 Vector<SamplingProfiler::StackTrace> SamplingProfiler::releaseStackTraces(const AbstractLocker& locker)
 {
     ASSERT(m_lock.isLocked());
@@ -945,6 +977,12 @@ void SamplingProfiler::reportDataToOptionFile()
         const char* path = Options::samplingProfilerPath();
         StringPrintStream pathOut;
         pathOut.print(path, "/");
+        if (Options::samplingProfilerCPUProfile()) {
+            pathOut.print("JSCSampilingProfile-", reinterpret_cast<uintptr_t>(this), ".cpuprofile");
+            auto out = FilePrintStream::open(pathOut.toCString().data(), "w");
+            reportCPUProfile(*out);
+            return;
+        }
         pathOut.print("JSCSampilingProfile-", reinterpret_cast<uintptr_t>(this), ".txt");
         auto out = FilePrintStream::open(pathOut.toCString().data(), "w");
         reportTopFunctions(*out);
@@ -1079,6 +1117,217 @@ void SamplingProfiler::reportTopBytecodes(PrintStream& out)
     }
 }
 
+static String symbolicateNativeCode(const void* pc)
+{
+#if HAVE(DLADDR)
+    auto demangled = WTF::StackTrace::demangle(const_cast<void*>(pc));
+    if (demangled)
+        return String(demangled->demangledName() ? demangled->demangledName() : demangled->mangledName());
+#else
+    UNUSED_PARAM(pc);
+#endif
+    return String();
+}
+
+void SamplingProfiler::reportCPUProfile(PrintStream& out)
+{
+    LockHolder locker(m_lock);
+    DeferGCForAWhile deferGC(m_vm.heap);
+
+    {
+        HeapIterationScope heapIterationScope(m_vm.heap);
+        processUnverifiedStackTraces();
+    }
+
+    using TickCounts = HashMap<unsigned, unsigned, WTF::IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned>>;
+    struct ProfileNode {
+        String functionName;
+        String url;
+        intptr_t scriptID { 0 };
+        int lineNumber { -1 };
+        int columnNumber { -1 };
+        const char* tier { "" };
+        unsigned hitCount { 0 };
+        HashMap<String, unsigned> childIndices;
+        Vector<unsigned> children;
+        TickCounts lineTicks;
+        TickCounts bytecodeTicks;
+    };
+
+    // The tree is keyed on everything DevTools shows for a frame plus the tier, so the same
+    // function running in LLInt and in the DFG shows up as two sibling nodes.
+    Vector<ProfileNode> nodes;
+    nodes.append(ProfileNode());
+    nodes[0].functionName = "(root)"_s;
+    nodes[0].url = emptyString();
+
+    auto childFor = [&] (unsigned parentIndex, StackFrame& frame) -> unsigned {
+        ProfileNode node;
+        node.tier = frame.tierName();
+        switch (frame.frameType) {
+        case FrameType::Executable:
+            node.functionName = frame.displayName(m_vm);
+            if (frame.executable->isHostFunction()) {
+                NativeFunction function(static_cast<NativeExecutable*>(frame.executable)->function());
+                node.url = symbolicateNativeCode(function.rawPointer());
+                break;
+            }
+            node.url = frame.url();
+            node.scriptID = frame.sourceID();
+            // DevTools expects zero-based positions, while JSC's are one-based.
+            node.lineNumber = frame.functionStartLine() - 1;
+            node.columnNumber = static_cast<int>(frame.functionStartColumn()) - 1;
+            break;
+        case FrameType::C:
+            node.functionName = symbolicateNativeCode(frame.cCodePC);
+            if (node.functionName.isEmpty())
+                node.functionName = "(unknown)"_s;
+            break;
+        case FrameType::Host:
+        case FrameType::Wasm:
+        case FrameType::Unknown:
+            node.functionName = frame.displayName(m_vm);
+            break;
+        }
+        if (node.url.isNull())
+            node.url = emptyString();
+
+        StringBuilder key;
+        key.append(node.functionName);
+        key.append('\n');
+        key.append(node.url);
+        key.append('\n');
+        key.appendNumber(node.scriptID);
+        key.append(':');
+        key.appendNumber(node.lineNumber);
+        key.append(':');
+        key.appendNumber(node.columnNumber);
+        key.append(':');
+        key.append(node.tier);
+
+        auto addResult = nodes[parentIndex].childIndices.add(key.toString(), nodes.size());
+        if (!addResult.isNewEntry)
+            return addResult.iterator->value;
+        nodes[parentIndex].children.append(nodes.size());
+        nodes.append(WTFMove(node));
+        return nodes.size() - 1;
+    };
+
+    Vector<unsigned> samples;
+    Vector<Seconds> timestamps;
+    samples.reserveInitialCapacity(m_stackTraces.size());
+    timestamps.reserveInitialCapacity(m_stackTraces.size());
+    for (StackTrace& stackTrace : m_stackTraces) {
+        unsigned nodeIndex = 0;
+        for (size_t i = stackTrace.frames.size(); i--;)
+            nodeIndex = childFor(nodeIndex, stackTrace.frames[i]);
+
+        ProfileNode& leaf = nodes[nodeIndex];
+        leaf.hitCount++;
+        if (stackTrace.frames.size()) {
+            StackFrame& topFrame = stackTrace.frames.first();
+            if (topFrame.hasExpressionInfo())
+                leaf.lineTicks.add(topFrame.lineNumber(), 0).iterator->value++;
+            if (topFrame.semanticLocation.hasBytecodeIndex())
+                leaf.bytecodeTicks.add(topFrame.semanticLocation.bytecodeIndex, 0).iterator->value++;
+        }
+        samples.uncheckedAppend(nodeIndex + 1);
+        timestamps.uncheckedAppend(stackTrace.timestamp);
+    }
+
+    StringBuilder json;
+    json.appendLiteral("{\"nodes\":[");
+    for (unsigned i = 0; i < nodes.size(); ++i) {
+        ProfileNode& node = nodes[i];
+        if (i)
+            json.append(',');
+        json.appendLiteral("{\"id\":");
+        json.appendNumber(i + 1);
+        json.appendLiteral(",\"callFrame\":{\"functionName\":");
+        json.appendQuotedJSONString(node.functionName);
+        json.appendLiteral(",\"scriptId\":\"");
+        json.appendNumber(std::max<intptr_t>(node.scriptID, 0));
+        json.appendLiteral("\",\"url\":");
+        json.appendQuotedJSONString(node.url);
+        json.appendLiteral(",\"lineNumber\":");
+        json.appendNumber(node.lineNumber);
+        json.appendLiteral(",\"columnNumber\":");
+        json.appendNumber(node.columnNumber);
+        json.appendLiteral("},\"hitCount\":");
+        json.appendNumber(node.hitCount);
+        if (i) {
+            json.appendLiteral(",\"tier\":\"");
+            json.append(node.tier);
+            json.append('"');
+        }
+        if (!node.children.isEmpty()) {
+            json.appendLiteral(",\"children\":[");
+            for (unsigned j = 0; j < node.children.size(); ++j) {
+                if (j)
+                    json.append(',');
+                json.appendNumber(node.children[j] + 1);
+            }
+            json.append(']');
+        }
+        auto appendTicks = [&] (const char* name, const char* keyName, const TickCounts& ticks) {
+            if (ticks.isEmpty())
+                return;
+            Vector<std::pair<unsigned, unsigned>> sortedTicks;
+            for (auto& entry : ticks)
+                sortedTicks.append(std::make_pair(entry.key, entry.value));
+            std::sort(sortedTicks.begin(), sortedTicks.end());
+            json.appendLiteral(",\"");
+            json.append(name);
+            json.appendLiteral("\":[");
+            for (unsigned j = 0; j < sortedTicks.size(); ++j) {
+                if (j)
+                    json.append(',');
+                json.appendLiteral("{\"");
+                json.append(keyName);
+                json.appendLiteral("\":");
+                json.appendNumber(sortedTicks[j].first);
+                json.appendLiteral(",\"ticks\":");
+                json.appendNumber(sortedTicks[j].second);
+                json.append('}');
+            }
+            json.append(']');
+        };
+        appendTicks("positionTicks", "line", node.lineTicks);
+        appendTicks("bytecodeTicks", "bytecodeIndex", node.bytecodeTicks);
+        json.append('}');
+    }
+    json.append(']');
+
+    // DevTools wants microsecond timestamps and a delta from the previous sample for each sample.
+    auto microseconds = [] (Seconds time) -> long long {
+        return static_cast<long long>(time.microseconds());
+    };
+    long long startTime = timestamps.isEmpty() ? 0 : microseconds(timestamps.first());
+    long long endTime = timestamps.isEmpty() ? 0 : microseconds(timestamps.last());
+    json.appendLiteral(",\"startTime\":");
+    json.appendNumber(startTime);
+    json.appendLiteral(",\"endTime\":");
+    json.appendNumber(endTime);
+    json.appendLiteral(",\"samples\":[");
+    for (unsigned i = 0; i < samples.size(); ++i) {
+        if (i)
+            json.append(',');
+        json.appendNumber(samples[i]);
+    }
+    json.appendLiteral("],\"timeDeltas\":[");
+    long long previousTime = startTime;
+    for (unsigned i = 0; i < timestamps.size(); ++i) {
+        if (i)
+            json.append(',');
+        long long time = microseconds(timestamps[i]);
+        json.appendNumber(time - previousTime);
+        previousTime = time;
+    }
+    json.appendLiteral("]}");
+
+    out.print(json.toString());
+}
+
 } // namespace JSC
 
 namespace WTF {
@@ -1094,6 +1343,9 @@ void printInternal(PrintStream& out, SamplingProfiler::FrameType frameType)
     case SamplingProfiler::FrameType::Host:
         out.print("Host");
         break;
+    case SamplingProfiler::FrameType::Wasm:
+        out.print("Wasm");
+        break;
     case SamplingProfiler::FrameType::C:
     case SamplingProfiler::FrameType::Unknown:
         out.print("Unknown");
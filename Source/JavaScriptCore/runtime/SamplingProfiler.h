@@ -68,6 +68,7 @@ public:
     enum class FrameType { 
         Executable,
         Host,
+        Wasm,
         C,
         Unknown
     };
@@ -134,6 +135,7 @@ public:
         unsigned functionStartColumn();
         intptr_t sourceID();
         String url();
+        const char* tierName() const;
     };
 
     struct UnprocessedStackTrace {
@@ -181,6 +183,8 @@ public:
     JS_EXPORT_PRIVATE void reportTopFunctions(PrintStream&);
     JS_EXPORT_PRIVATE void reportTopBytecodes();
     JS_EXPORT_PRIVATE void reportTopBytecodes(PrintStream&);
+    // Writes the samples as a Chrome DevTools .cpuprofile, a JSON call tree with per-sample time deltas.
+    JS_EXPORT_PRIVATE void reportCPUProfile(PrintStream&);
 
 private:
     void createThreadIfNecessary(const AbstractLocker&);
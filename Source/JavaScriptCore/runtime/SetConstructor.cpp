@@ -80,7 +80,18 @@ static EncodedJSValue JSC_HOST_CALL constructSet(ExecState* exec)
             RELEASE_AND_RETURN(scope, JSValue::encode(iterableSet->clone(exec, vm, setStructure)));
     }
 
-    JSSet* set = JSSet::create(exec, vm, setStructure);
+    JSArray* array = nullptr;
+    if (isJSArray(iterable) && jsCast<JSArray*>(iterable)->isIteratorProtocolFastAndNonObservable())
+        array = jsCast<JSArray*>(iterable);
+
+    // Size the table for the array up front so that we don't rehash repeatedly while filling it. Holey
+    // and sparse arrays can have a length far beyond what they store, so cap the hint at the storage
+    // the array has already allocated.
+    uint32_t sizeHint = 0;
+    if (array)
+        sizeHint = std::min(array->length(), array->getVectorLength());
+
+    JSSet* set = JSSet::create(exec, vm, setStructure, sizeHint);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
 
     JSValue adderFunction = set->JSObject::get(exec, vm.propertyNames->add);
@@ -91,6 +102,25 @@ static EncodedJSValue JSC_HOST_CALL constructSet(ExecState* exec)
     if (UNLIKELY(adderFunctionCallType == CallType::None))
         return JSValue::encode(throwTypeError(exec, scope));
 
+    if (array && JSSet::isAddFastAndNonObservable(setStructure)) {
+        // Iterating such an array is the same as reading each index below its current length, and the
+        // adder is the original Set.prototype.add, so we can skip both the iterator and the calls. We
+        // only read indices that don't need the prototype chain. Until we hit a hole, nothing observable
+        // has happened, so we can throw away what we added and start over with the generic loop.
+        bool filledFromArray = true;
+        for (unsigned index = 0; index < array->length(); ++index) {
+            if (!array->canGetIndexQuickly(index)) {
+                filledFromArray = false;
+                break;
+            }
+            set->add(exec, array->getIndexQuickly(index));
+            RETURN_IF_EXCEPTION(scope, encodedJSValue());
+        }
+        if (filledFromArray)
+            return JSValue::encode(set);
+        set->clear(exec);
+    }
+
     scope.release();
     forEachInIterable(exec, iterable, [&](VM&, ExecState* exec, JSValue nextValue) {
         MarkedArgumentBuffer arguments;
@@ -970,21 +970,19 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharAt(ExecState* exec)
     JSValue thisValue = exec->thisValue();
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec, scope);
-    auto viewWithString = thisValue.toString(exec)->viewWithUnderlyingString(exec);
-    RETURN_IF_EXCEPTION(scope, encodedJSValue());
-    StringView view = viewWithString.view;
+    JSString* thisJSString = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
     JSValue a0 = exec->argument(0);
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
-        if (i < view.length())
-            return JSValue::encode(jsSingleCharacterString(exec, view[i]));
+        if (i < thisJSString->length())
+            RELEASE_AND_RETURN(scope, JSValue::encode(thisJSString->getIndex(exec, i)));
         return JSValue::encode(jsEmptyString(exec));
     }
     double dpos = a0.toInteger(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
-    if (dpos >= 0 && dpos < view.length())
-        return JSValue::encode(jsSingleCharacterString(exec, view[static_cast<unsigned>(dpos)]));
+    if (dpos >= 0 && dpos < thisJSString->length())
+        RELEASE_AND_RETURN(scope, JSValue::encode(thisJSString->getIndex(exec, static_cast<unsigned>(dpos))));
     return JSValue::encode(jsEmptyString(exec));
 }
 
@@ -996,21 +994,24 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharCodeAt(ExecState* exec)
     JSValue thisValue = exec->thisValue();
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec, scope);
-    auto viewWithString = thisValue.toString(exec)->viewWithUnderlyingString(exec);
+    JSString* thisJSString = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
-    StringView view = viewWithString.view;
     JSValue a0 = exec->argument(0);
-    if (a0.isUInt32()) {
-        uint32_t i = a0.asUInt32();
-        if (i < view.length())
-            return JSValue::encode(jsNumber(view[i]));
-        return JSValue::encode(jsNaN());
+    unsigned i;
+    if (a0.isUInt32())
+        i = a0.asUInt32();
+    else {
+        double dpos = a0.toInteger(exec);
+        RETURN_IF_EXCEPTION(scope, encodedJSValue());
+        if (!(dpos >= 0 && dpos < thisJSString->length()))
+            return JSValue::encode(jsNaN());
+        i = static_cast<unsigned>(dpos);
     }
-    double dpos = a0.toInteger(exec);
+    if (i >= thisJSString->length())
+        return JSValue::encode(jsNaN());
+    auto viewWithString = thisJSString->viewWithUnderlyingString(exec, i, 1);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
-    if (dpos >= 0 && dpos < view.length())
-        return JSValue::encode(jsNumber(view[static_cast<int>(dpos)]));
-    return JSValue::encode(jsNaN());
+    return JSValue::encode(jsNumber(viewWithString.view[0]));
 }
 
 static inline UChar32 codePointAt(const String& string, unsigned position, unsigned length)
@@ -1666,7 +1667,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncStartsWith(ExecState* exec)
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec, scope);
 
-    String stringToSearchIn = thisValue.toWTFString(exec);
+    JSString* stringToSearchIn = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
 
     JSValue a0 = exec->argument(0);
@@ -1678,17 +1679,24 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncStartsWith(ExecState* exec)
     String searchString = a0.toWTFString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
 
+    unsigned length = stringToSearchIn->length();
+
     JSValue positionArg = exec->argument(1);
     unsigned start = 0;
     if (positionArg.isInt32())
         start = std::max(0, positionArg.asInt32());
     else {
-        unsigned length = stringToSearchIn.length();
         start = clampAndTruncateToUnsigned(positionArg.toInteger(exec), 0, length);
         RETURN_IF_EXCEPTION(scope, encodedJSValue());
     }
 
-    return JSValue::encode(jsBoolean(stringToSearchIn.hasInfixStartingAt(searchString, start)));
+    if (start > length || searchString.length() > length - start)
+        return JSValue::encode(jsBoolean(false));
+
+    // Only look at the characters we compare, so that we do not resolve a rope when they come from one of its fibers.
+    auto viewWithString = stringToSearchIn->viewWithUnderlyingString(exec, start, searchString.length());
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    return JSValue::encode(jsBoolean(viewWithString.view == searchString));
 }
 
 EncodedJSValue JSC_HOST_CALL stringProtoFuncEndsWith(ExecState* exec)
@@ -1700,7 +1708,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncEndsWith(ExecState* exec)
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec, scope);
 
-    String stringToSearchIn = thisValue.toWTFString(exec);
+    JSString* stringToSearchIn = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
 
     JSValue a0 = exec->argument(0);
@@ -1712,7 +1720,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncEndsWith(ExecState* exec)
     String searchString = a0.toWTFString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
 
-    unsigned length = stringToSearchIn.length();
+    unsigned length = stringToSearchIn->length();
 
     JSValue endPositionArg = exec->argument(1);
     unsigned end = length;
@@ -1723,7 +1731,14 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncEndsWith(ExecState* exec)
         RETURN_IF_EXCEPTION(scope, encodedJSValue());
     }
 
-    return JSValue::encode(jsBoolean(stringToSearchIn.hasInfixEndingAt(searchString, std::min(end, length))));
+    end = std::min(end, length);
+    if (searchString.length() > end)
+        return JSValue::encode(jsBoolean(false));
+
+    // Only look at the characters we compare, so that we do not resolve a rope when they come from one of its fibers.
+    auto viewWithString = stringToSearchIn->viewWithUnderlyingString(exec, end - searchString.length(), searchString.length());
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    return JSValue::encode(jsBoolean(viewWithString.view == searchString));
 }
 
 static EncodedJSValue JSC_HOST_CALL stringIncludesImpl(VM& vm, ExecState* exec, String stringToSearchIn, String searchString, JSValue positionArg)
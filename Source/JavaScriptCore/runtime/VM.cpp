@@ -131,6 +131,7 @@
 #include "RuntimeType.h"
 #include "SamplingProfiler.h"
 #include "ShadowChicken.h"
+#include "SharedJITStubSet.h"
 #include "SimpleTypedArrayController.h"
 #include "SourceProviderCache.h"
 #include "StackVisitor.h"
@@ -455,6 +456,7 @@ VM::VM(VMType vmType, HeapType heapType)
 
 #if ENABLE(JIT)
     jitStubs = std::make_unique<JITThunks>();
+    sharedJITStubs = std::make_unique<SharedJITStubSet>();
 #endif
 
 #if ENABLE(FTL_JIT)
@@ -633,14 +635,26 @@ void VM::setLastStackTop(void* lastStackTop)
     m_lastStackTop = lastStackTop;
 }
 
+static void reportVMCreationTimeIfNeeded(MonotonicTime before)
+{
+    if (UNLIKELY(Options::reportStartupTimes()))
+        dataLog("Created VM in ", (MonotonicTime::now() - before).milliseconds(), " ms.\n");
+}
+
 Ref<VM> VM::createContextGroup(HeapType heapType)
 {
-    return adoptRef(*new VM(APIContextGroup, heapType));
+    MonotonicTime before = MonotonicTime::now();
+    Ref<VM> vm = adoptRef(*new VM(APIContextGroup, heapType));
+    reportVMCreationTimeIfNeeded(before);
+    return vm;
 }
 
 Ref<VM> VM::create(HeapType heapType)
 {
-    return adoptRef(*new VM(Default, heapType));
+    MonotonicTime before = MonotonicTime::now();
+    Ref<VM> vm = adoptRef(*new VM(Default, heapType));
+    reportVMCreationTimeIfNeeded(before);
+    return vm;
 }
 
 bool VM::sharedInstanceExists()
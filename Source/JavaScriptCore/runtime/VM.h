@@ -137,6 +137,9 @@ class SamplingProfiler;
 #endif
 class ShadowChicken;
 class ScriptExecutable;
+#if ENABLE(JIT)
+class SharedJITStubSet;
+#endif
 class SourceProvider;
 class SourceProviderCache;
 class StackFrame;
@@ -659,6 +662,7 @@ public:
     {
         return jitStubs->ctiStub(this, generator);
     }
+    std::unique_ptr<SharedJITStubSet> sharedJITStubs;
 
 #endif // ENABLE(JIT)
 #if ENABLE(FTL_JIT)
@@ -420,12 +420,12 @@ static bool runFromFiles(GlobalObject* globalObject, const Vector<String>& files
 
     VM& vm = globalObject->vm();
 
-    bool success = true;
     for (size_t i = 0; i < files.size(); i++) {
         FILE* testCasesFile = fopen(files[i].utf8().data(), "rb");
 
         if (!testCasesFile) {
             printf("Unable to open test data file \"%s\"\n", files[i].utf8().data());
+            failures++;
             continue;
         }
             
@@ -487,7 +487,7 @@ static bool runFromFiles(GlobalObject* globalObject, const Vector<String>& files
 #if ENABLE(REGEXP_TRACING)
     vm.dumpRegExpTrace();
 #endif
-    return success;
+    return !failures;
 }
 
 #define RUNNING_FROM_XCODE 0
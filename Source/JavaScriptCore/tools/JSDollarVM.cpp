@@ -1108,7 +1108,7 @@ public:
     WasmStreamingParser(VM& vm, Structure* structure)
         : Base(vm, structure)
         , m_info(Wasm::ModuleInformation::create())
-        , m_streamingParser(m_info.get())
+        , m_streamingParser(m_info.get(), m_client)
     {
     }
 
@@ -1141,6 +1141,7 @@ public:
     DECLARE_INFO;
 
     Ref<Wasm::ModuleInformation> m_info;
+    Wasm::StreamingParserClient m_client;
     Wasm::StreamingParser m_streamingParser;
 };
 
@@ -57,7 +57,9 @@
 #include "WasmFunctionParser.h"
 #include "WasmInstance.h"
 #include "WasmMemory.h"
+#include "WasmOMGForOSREntryPlan.h"
 #include "WasmOMGPlan.h"
+#include "WasmOSREntryData.h"
 #include "WasmOpcodeOrigin.h"
 #include "WasmSignatureInlines.h"
 #include "WasmThunks.h"
@@ -178,7 +180,7 @@ public:
             return fail(__VA_ARGS__);             \
     } while (0)
 
-    B3IRGenerator(const ModuleInformation&, Procedure&, InternalFunction*, Vector<UnlinkedWasmToWasmCall>&, MemoryMode, CompilationMode, unsigned functionIndex, TierUpCount*, ThrowWasmException);
+    B3IRGenerator(const ModuleInformation&, Procedure&, InternalFunction*, Vector<UnlinkedWasmToWasmCall>&, MemoryMode, CompilationMode, unsigned functionIndex, unsigned loopIndexForOSREntry, TierUpCount*, ThrowWasmException);
 
     PartialResult WARN_UNUSED_RETURN addArguments(const Signature&);
     PartialResult WARN_UNUSED_RETURN addLocal(Type, uint32_t);
@@ -197,6 +199,8 @@ public:
     PartialResult WARN_UNUSED_RETURN store(StoreOpType, ExpressionType pointer, ExpressionType value, uint32_t offset);
     PartialResult WARN_UNUSED_RETURN addGrowMemory(ExpressionType delta, ExpressionType& result);
     PartialResult WARN_UNUSED_RETURN addCurrentMemory(ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addMemoryCopy(ExpressionType destination, ExpressionType source, ExpressionType count);
+    PartialResult WARN_UNUSED_RETURN addMemoryFill(ExpressionType destination, ExpressionType value, ExpressionType count);
 
     // Basic operators
     template<OpType>
@@ -208,7 +212,7 @@ public:
     // Control flow
     ControlData WARN_UNUSED_RETURN addTopLevel(Type signature);
     ControlData WARN_UNUSED_RETURN addBlock(Type signature);
-    ControlData WARN_UNUSED_RETURN addLoop(Type signature);
+    ControlData WARN_UNUSED_RETURN addLoop(Type signature, ExpressionList& enclosingStack, uint32_t loopIndex);
     PartialResult WARN_UNUSED_RETURN addIf(ExpressionType condition, Type signature, ControlData& result);
     PartialResult WARN_UNUSED_RETURN addElse(ControlData&, const ExpressionList&);
     PartialResult WARN_UNUSED_RETURN addElseToUnreachable(ControlData&);
@@ -230,12 +234,16 @@ public:
     Value* constant(B3::Type, uint64_t bits, Optional<Origin> = WTF::nullopt);
     void insertConstants();
 
+    bool hasOSREntry() const { return m_rootBlock && m_rootBlock->numSuccessors(); }
+
 private:
     void emitExceptionCheck(CCallHelpers&, ExceptionType);
 
     void emitTierUpCheck(uint32_t decrementCount, Origin);
+    void emitLoopTierUpCheck(uint32_t loopIndex, const ExpressionList& enclosingStack);
 
     ExpressionType emitCheckAndPreparePointer(ExpressionType pointer, uint32_t offset, uint32_t sizeOfOp);
+    ExpressionType emitCheckAndPrepareBulkMemoryRange(ExpressionType pointer, ExpressionType count);
     B3::Kind memoryKind(B3::Opcode memoryOp);
     ExpressionType emitLoadOp(LoadOpType, ExpressionType pointer, uint32_t offset);
     void emitStoreOp(StoreOpType, ExpressionType pointer, ExpressionType value, uint32_t offset);
@@ -258,10 +266,13 @@ private:
     const MemoryMode m_mode { MemoryMode::BoundsChecking };
     const CompilationMode m_compilationMode { CompilationMode::BBQMode };
     const unsigned m_functionIndex { UINT_MAX };
-    const TierUpCount* m_tierUp { nullptr };
+    const unsigned m_loopIndexForOSREntry { UINT_MAX };
+    TierUpCount* m_tierUp { nullptr };
 
     Procedure& m_proc;
+    BasicBlock* m_rootBlock { nullptr }; // Only used when compiling for OSR entry.
     BasicBlock* m_currentBlock { nullptr };
+    Value* m_osrEntryScratchBuffer { nullptr };
     Vector<Variable*> m_locals;
     Vector<UnlinkedWasmToWasmCall>& m_unlinkedWasmToWasmCalls; // List each call site and the function index whose address it should be patched with.
     HashMap<ValueKey, Value*> m_constantPool;
@@ -322,11 +333,12 @@ void B3IRGenerator::restoreWasmContextInstance(Procedure& proc, BasicBlock* bloc
     });
 }
 
-B3IRGenerator::B3IRGenerator(const ModuleInformation& info, Procedure& procedure, InternalFunction* compilation, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls, MemoryMode mode, CompilationMode compilationMode, unsigned functionIndex, TierUpCount* tierUp, ThrowWasmException throwWasmException)
+B3IRGenerator::B3IRGenerator(const ModuleInformation& info, Procedure& procedure, InternalFunction* compilation, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls, MemoryMode mode, CompilationMode compilationMode, unsigned functionIndex, unsigned loopIndexForOSREntry, TierUpCount* tierUp, ThrowWasmException throwWasmException)
     : m_info(info)
     , m_mode(mode)
     , m_compilationMode(compilationMode)
     , m_functionIndex(functionIndex)
+    , m_loopIndexForOSREntry(loopIndexForOSREntry)
     , m_tierUp(tierUp)
     , m_proc(procedure)
     , m_unlinkedWasmToWasmCalls(unlinkedWasmToWasmCalls)
@@ -450,6 +462,15 @@ B3IRGenerator::B3IRGenerator(const ModuleInformation& info, Procedure& procedure
         });
     }
 
+    if (m_compilationMode == CompilationMode::OMGForOSREntryMode) {
+        // We are only ever entered from a BBQ loop, which passes us a buffer holding its live values. The rest of the
+        // function is still generated from its start, but the root block jumps straight into the loop, leaving the
+        // code before it unreachable.
+        m_rootBlock = m_currentBlock;
+        m_osrEntryScratchBuffer = m_rootBlock->appendNew<ArgumentRegValue>(m_proc, Origin(), GPRInfo::argumentGPR0);
+        m_currentBlock = m_proc.addBlock();
+    }
+
     emitTierUpCheck(TierUpCount::functionEntryDecrement(), Origin());
 }
 
@@ -612,6 +633,57 @@ auto B3IRGenerator::addCurrentMemory(ExpressionType& result) -> PartialResult
     return { };
 }
 
+Value* B3IRGenerator::emitCheckAndPrepareBulkMemoryRange(ExpressionType pointer, ExpressionType count)
+{
+    // Bulk memory operations trap before writing anything if any byte of the range is out of bounds. Both
+    // operands are 32-bit, so their sum can't overflow in 64-bit. Even in Signaling mode we check explicitly,
+    // since a fault halfway through the range would already have written its beginning.
+    pointer = m_currentBlock->appendNew<Value>(m_proc, ZExt32, origin(), pointer);
+    Value* end = m_currentBlock->appendNew<Value>(m_proc, Add, origin(), pointer,
+        m_currentBlock->appendNew<Value>(m_proc, ZExt32, origin(), count));
+    Value* size = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), instanceValue(), safeCast<int32_t>(Instance::offsetOfCachedMemorySize()));
+
+    CheckValue* check = m_currentBlock->appendNew<CheckValue>(m_proc, Check, origin(),
+        m_currentBlock->appendNew<Value>(m_proc, Above, origin(), end, size));
+    check->setGenerator([=] (CCallHelpers& jit, const B3::StackmapGenerationParams&) {
+        this->emitExceptionCheck(jit, ExceptionType::OutOfBoundsMemoryAccess);
+    });
+
+    return m_currentBlock->appendNew<WasmAddressValue>(m_proc, origin(), pointer, m_memoryBaseGPR);
+}
+
+auto B3IRGenerator::addMemoryCopy(ExpressionType destination, ExpressionType source, ExpressionType count) -> PartialResult
+{
+    Value* destinationAddress = emitCheckAndPrepareBulkMemoryRange(destination, count);
+    Value* sourceAddress = emitCheckAndPrepareBulkMemoryRange(source, count);
+
+    // The ranges may overlap.
+    void (*memoryCopy)(uint8_t*, const uint8_t*, uint32_t) = [] (uint8_t* destination, const uint8_t* source, uint32_t count) {
+        memmove(destination, source, count);
+    };
+
+    m_currentBlock->appendNew<CCallValue>(m_proc, B3::Void, origin(),
+        m_currentBlock->appendNew<ConstPtrValue>(m_proc, origin(), tagCFunctionPtr<void*>(memoryCopy, B3CCallPtrTag)),
+        destinationAddress, sourceAddress, count);
+
+    return { };
+}
+
+auto B3IRGenerator::addMemoryFill(ExpressionType destination, ExpressionType value, ExpressionType count) -> PartialResult
+{
+    Value* destinationAddress = emitCheckAndPrepareBulkMemoryRange(destination, count);
+
+    void (*memoryFill)(uint8_t*, uint32_t, uint32_t) = [] (uint8_t* destination, uint32_t value, uint32_t count) {
+        memset(destination, static_cast<uint8_t>(value), count);
+    };
+
+    m_currentBlock->appendNew<CCallValue>(m_proc, B3::Void, origin(),
+        m_currentBlock->appendNew<ConstPtrValue>(m_proc, origin(), tagCFunctionPtr<void*>(memoryFill, B3CCallPtrTag)),
+        destinationAddress, value, count);
+
+    return { };
+}
+
 auto B3IRGenerator::setLocal(uint32_t index, ExpressionType value) -> PartialResult
 {
     ASSERT(m_locals[index]);
@@ -945,15 +1017,112 @@ void B3IRGenerator::emitTierUpCheck(uint32_t decrementCount, Origin origin)
     });
 }
 
-B3IRGenerator::ControlData B3IRGenerator::addLoop(Type signature)
+void B3IRGenerator::emitLoopTierUpCheck(uint32_t loopIndex, const ExpressionList& enclosingStack)
+{
+    if (!m_tierUp)
+        return;
+
+    if (!Options::useWebAssemblyOSR()) {
+        emitTierUpCheck(TierUpCount::loopDecrement(), origin());
+        return;
+    }
+
+    Origin origin = this->origin();
+    Value* countDownLocation = constant(pointerType(), reinterpret_cast<uint64_t>(m_tierUp), origin);
+    Value* oldCountDown = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int32, origin, countDownLocation);
+    Value* newCountDown = m_currentBlock->appendNew<Value>(m_proc, Sub, origin, oldCountDown, constant(Int32, TierUpCount::loopDecrement(), origin));
+    m_currentBlock->appendNew<MemoryValue>(m_proc, Store, origin, newCountDown, countDownLocation);
+
+    // This must match the order in which addLoop() loads the values when compiling for OSR entry.
+    Vector<Value*> liveValues;
+    for (Variable* local : m_locals)
+        liveValues.append(m_currentBlock->appendNew<VariableValue>(m_proc, B3::Get, origin, local));
+    for (auto& entry : m_parser->controlStack())
+        liveValues.appendVector(entry.enclosedExpressionStack);
+    liveValues.appendVector(enclosingStack);
+
+    Vector<B3::Type> types;
+    for (Value* value : liveValues)
+        types.append(value->type());
+
+    PatchpointValue* patch = m_currentBlock->appendNew<PatchpointValue>(m_proc, B3::Void, origin);
+    Effects effects = Effects::none();
+    // FIXME: we should have a more precise heap range for the tier up count.
+    effects.reads = B3::HeapRange::top();
+    effects.writes = B3::HeapRange::top();
+    effects.exitsSideways = true;
+    patch->effects = effects;
+    // The probe below returns the OSR entry buffer and entrypoint in these.
+    patch->clobberLate(RegisterSet(GPRInfo::argumentGPR0, GPRInfo::argumentGPR1));
+
+    patch->append(newCountDown, ValueRep::SomeRegister);
+    patch->append(oldCountDown, ValueRep::SomeRegister);
+    patch->append(instanceValue(), ValueRep::ColdAny);
+    patch->appendVectorWithRep(liveValues, ValueRep::ColdAny);
+
+    TierUpCount* tierUp = m_tierUp;
+    unsigned functionIndex = m_functionIndex;
+    patch->setGenerator([=] (CCallHelpers& jit, const StackmapGenerationParams& params) {
+        MacroAssembler::Jump tierUpTrigger = jit.branch32(MacroAssembler::Above, params[0].gpr(), params[1].gpr());
+        MacroAssembler::Label tierUpResume = jit.label();
+
+        StackMap values;
+        values.reserveInitialCapacity(types.size());
+        for (unsigned i = 0; i < types.size(); ++i)
+            values.uncheckedAppend(OSREntryValue(params[i + 3], types[i]));
+        OSREntryData* osrEntryData = &tierUp->addOSREntryData(functionIndex, loopIndex, params[2], WTFMove(values));
+        RegisterAtOffsetList calleeSaveRegisters = params.proc().calleeSaveRegisterAtOffsetList();
+
+        params.addLatePath([=] (CCallHelpers& jit) {
+            tierUpTrigger.link(&jit);
+
+            jit.probe(OMGForOSREntryPlan::triggerOSREntryNow, osrEntryData);
+            jit.branchTestPtr(MacroAssembler::Zero, GPRInfo::argumentGPR0).linkTo(tierUpResume, &jit);
+
+            // Tear down our frame as if we were returning. The OSR entry builds its own frame in its place and
+            // returns to our caller.
+            jit.emitRestore(calleeSaveRegisters);
+            jit.emitFunctionEpilogue();
+            jit.jump(GPRInfo::argumentGPR1, WasmEntryPtrTag);
+        });
+    });
+}
+
+B3IRGenerator::ControlData B3IRGenerator::addLoop(Type signature, ExpressionList& enclosingStack, uint32_t loopIndex)
 {
     BasicBlock* body = m_proc.addBlock();
     BasicBlock* continuation = m_proc.addBlock();
 
     m_currentBlock->appendNewControlValue(m_proc, Jump, origin(), body);
 
+    if (loopIndex == m_loopIndexForOSREntry) {
+        ASSERT(m_compilationMode == CompilationMode::OMGForOSREntryMode);
+        m_currentBlock = m_rootBlock;
+
+        unsigned indexInBuffer = 0;
+        auto loadFromScratchBuffer = [&] (B3::Type type) {
+            int32_t offset = safeCast<int32_t>(indexInBuffer++ * sizeof(uint64_t));
+            return m_currentBlock->appendNew<MemoryValue>(m_proc, Load, type, origin(), m_osrEntryScratchBuffer, offset);
+        };
+
+        for (Variable* local : m_locals)
+            m_currentBlock->appendNew<VariableValue>(m_proc, Set, origin(), local, loadFromScratchBuffer(local->type()));
+
+        // Values computed before the loop are unreachable from here, so everything still on the enclosing stacks is
+        // replaced by what the BBQ frame had.
+        auto reloadExpressionStack = [&] (ExpressionList& expressionStack) {
+            for (Value*& value : expressionStack)
+                value = loadFromScratchBuffer(value->type());
+        };
+        for (auto& entry : m_parser->controlStack())
+            reloadExpressionStack(entry.enclosedExpressionStack);
+        reloadExpressionStack(enclosingStack);
+
+        m_currentBlock->appendNewControlValue(m_proc, Jump, origin(), body);
+    }
+
     m_currentBlock = body;
-    emitTierUpCheck(TierUpCount::loopDecrement(), origin());
+    emitLoopTierUpCheck(loopIndex, enclosingStack);
 
     return ControlData(m_proc, origin(), signature, BlockType::Loop, continuation, body);
 }
@@ -1382,7 +1551,7 @@ auto B3IRGenerator::origin() -> Origin
     return bitwise_cast<Origin>(origin);
 }
 
-Expected<std::unique_ptr<InternalFunction>, String> parseAndCompile(CompilationContext& compilationContext, const uint8_t* functionStart, size_t functionLength, const Signature& signature, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls, const ModuleInformation& info, MemoryMode mode, CompilationMode compilationMode, uint32_t functionIndex, TierUpCount* tierUp, ThrowWasmException throwWasmException)
+Expected<std::unique_ptr<InternalFunction>, String> parseAndCompile(CompilationContext& compilationContext, const uint8_t* functionStart, size_t functionLength, const Signature& signature, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls, const ModuleInformation& info, MemoryMode mode, CompilationMode compilationMode, uint32_t functionIndex, uint32_t loopIndexForOSREntry, TierUpCount* tierUp, ThrowWasmException throwWasmException)
 {
     auto result = std::make_unique<InternalFunction>();
 
@@ -1406,10 +1575,13 @@ Expected<std::unique_ptr<InternalFunction>, String> parseAndCompile(CompilationC
         ? Options::webAssemblyBBQOptimizationLevel()
         : Options::webAssemblyOMGOptimizationLevel());
 
-    B3IRGenerator irGenerator(info, procedure, result.get(), unlinkedWasmToWasmCalls, mode, compilationMode, functionIndex, tierUp, throwWasmException);
+    B3IRGenerator irGenerator(info, procedure, result.get(), unlinkedWasmToWasmCalls, mode, compilationMode, functionIndex, loopIndexForOSREntry, tierUp, throwWasmException);
     FunctionParser<B3IRGenerator> parser(irGenerator, functionStart, functionLength, signature, info);
     WASM_FAIL_IF_HELPER_FAILS(parser.parse());
 
+    // BBQ code only asks for loops it has parsed itself.
+    RELEASE_ASSERT(compilationMode != CompilationMode::OMGForOSREntryMode || irGenerator.hasOSREntry());
+
     irGenerator.insertConstants();
 
     procedure.resetReachability();
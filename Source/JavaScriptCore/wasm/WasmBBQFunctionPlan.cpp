@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmBBQFunctionPlan.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "B3Compilation.h"
+#include "B3OpaqueByproducts.h"
+#include "JSCInlines.h"
+#include "LinkBuffer.h"
+#include "WasmB3IRGenerator.h"
+#include "WasmCallee.h"
+#include "WasmContext.h"
+#include "WasmInstance.h"
+#include "WasmMachineThreads.h"
+#include "WasmMemory.h"
+#include "WasmNameSection.h"
+#include "WasmSignatureInlines.h"
+#include "WasmValidate.h"
+#include "WasmWorklist.h"
+#include <wtf/DataLog.h>
+#include <wtf/Locker.h>
+
+namespace JSC { namespace Wasm {
+
+namespace WasmBBQFunctionPlanInternal {
+static const bool verbose = false;
+}
+
+BBQFunctionPlan::BBQFunctionPlan(Context* context, Ref<Module>&& module, uint32_t functionIndex, MemoryMode mode, CompletionTask&& task)
+    : Base(context, makeRef(const_cast<ModuleInformation&>(module->moduleInformation())), WTFMove(task))
+    , m_module(WTFMove(module))
+    , m_codeBlock(*m_module->codeBlockFor(mode))
+    , m_functionIndex(functionIndex)
+{
+    setMode(mode);
+    ASSERT(m_codeBlock->runnable());
+    ASSERT(m_codeBlock.ptr() == m_module->codeBlockFor(m_mode));
+    dataLogLnIf(WasmBBQFunctionPlanInternal::verbose, "Starting BBQ function plan for ", functionIndex, " of module: ", RawPointer(&m_module.get()));
+}
+
+void BBQFunctionPlan::work(CompilationEffort)
+{
+    ASSERT(m_codeBlock->runnable());
+    ASSERT(m_codeBlock.ptr() == m_module->codeBlockFor(mode()));
+    const FunctionData& function = m_moduleInformation->functions[m_functionIndex];
+
+    const uint32_t functionIndexSpace = m_functionIndex + m_module->moduleInformation().importFunctionCount();
+    ASSERT(functionIndexSpace < m_module->moduleInformation().functionIndexSpaceSize());
+
+    SignatureIndex signatureIndex = m_moduleInformation->internalFunctionSignatureIndices[m_functionIndex];
+    const Signature& signature = SignatureInformation::get(signatureIndex);
+    ASSERT(validateFunction(function.data.data(), function.data.size(), signature, m_moduleInformation.get()));
+
+    Vector<UnlinkedWasmToWasmCall> unlinkedCalls;
+    CompilationContext context;
+    TierUpCount* tierUp = Options::useBBQTierUpChecks() ? &m_codeBlock->tierUpCount(m_functionIndex) : nullptr;
+    auto parseAndCompileResult = parseAndCompile(context, function.data.data(), function.data.size(), signature, unlinkedCalls, m_moduleInformation.get(), m_mode, CompilationMode::BBQMode, m_functionIndex, UINT32_MAX, tierUp);
+
+    if (UNLIKELY(!parseAndCompileResult)) {
+        fail(holdLock(m_lock), makeString(parseAndCompileResult.error(), "when trying to tier up ", String::number(m_functionIndex)));
+        return;
+    }
+
+    Entrypoint bbqEntrypoint;
+    LinkBuffer linkBuffer(*context.wasmEntrypointJIT, nullptr, JITCompilationCanFail);
+    if (UNLIKELY(linkBuffer.didFailToAllocate())) {
+        Base::fail(holdLock(m_lock), makeString("Out of executable memory while tiering up function at index ", String::number(m_functionIndex)));
+        return;
+    }
+
+    bbqEntrypoint.compilation = std::make_unique<B3::Compilation>(
+        FINALIZE_CODE(linkBuffer, B3CompilationPtrTag, "WebAssembly BBQ function[%i] %s", m_functionIndex, signature.toString().ascii().data()),
+        WTFMove(context.wasmEntrypointByproducts));
+
+    bbqEntrypoint.calleeSaveRegisters = WTFMove(parseAndCompileResult.value()->entrypoint.calleeSaveRegisters);
+
+    MacroAssemblerCodePtr<WasmEntryPtrTag> entrypoint;
+    {
+        ASSERT(m_codeBlock.ptr() == m_module->codeBlockFor(mode()));
+        Ref<Callee> callee = Callee::create(WTFMove(bbqEntrypoint), functionIndexSpace, m_moduleInformation->nameSection->get(functionIndexSpace));
+        MacroAssembler::repatchPointer(parseAndCompileResult.value()->calleeMoveLocation, CalleeBits::boxWasm(callee.ptr()));
+        entrypoint = callee->entrypoint();
+
+        LockHolder holder(m_codeBlock->m_lock);
+        // A hot loop may have gotten the function to OMG before we finished, in which case we are too late.
+        if (m_codeBlock->m_optimizedCallees[m_functionIndex]) {
+            dataLogLnIf(WasmBBQFunctionPlanInternal::verbose, "Function ", m_functionIndex, " already has OMG code");
+            holder.unlockEarly();
+            complete(holdLock(m_lock));
+            return;
+        }
+
+        // Frames still running in the interpreter return into its trampoline, so we keep it alive.
+        m_codeBlock->m_interpreterCallees[m_functionIndex] = WTFMove(m_codeBlock->m_callees[m_functionIndex]);
+        m_codeBlock->m_callees[m_functionIndex] = WTFMove(callee);
+
+        for (auto& call : unlinkedCalls) {
+            MacroAssemblerCodePtr<WasmEntryPtrTag> entrypoint;
+            if (call.functionIndexSpace < m_module->moduleInformation().importFunctionCount())
+                entrypoint = m_codeBlock->m_wasmToWasmExitStubs[call.functionIndexSpace].code();
+            else
+                entrypoint = m_codeBlock->wasmEntrypointCalleeFromFunctionIndexSpace(call.functionIndexSpace).entrypoint().retagged<WasmEntryPtrTag>();
+
+            MacroAssembler::repatchNearCall(call.callLocation, CodeLocationLabel<WasmEntryPtrTag>(entrypoint));
+        }
+        // Unlike OMG code, we keep the callsites already there, since those of the embedder entrypoint still call the trampoline.
+        m_codeBlock->m_wasmToWasmCallsites[m_functionIndex].appendVector(unlinkedCalls);
+    }
+
+    // See OMGPlan::work() for why we do this before making the code visible.
+    resetInstructionCacheOnAllThreads();
+    WTF::storeStoreFence(); // This probably isn't necessary but it's good to be paranoid.
+
+    {
+        LockHolder holder(m_codeBlock->m_lock);
+
+        // OMG code published after we took the lock above would only be overwritten by ours here.
+        if (!m_codeBlock->m_optimizedCallees[m_functionIndex]) {
+            m_codeBlock->m_wasmIndirectCallEntryPoints[m_functionIndex] = entrypoint;
+            for (auto& callsites : m_codeBlock->m_wasmToWasmCallsites) {
+                for (auto& call : callsites) {
+                    if (call.functionIndexSpace == functionIndexSpace) {
+                        dataLogLnIf(WasmBBQFunctionPlanInternal::verbose, "Repatching call at: ", RawPointer(call.callLocation.dataLocation()), " to ", RawPointer(entrypoint.executableAddress()));
+                        MacroAssembler::repatchNearCall(call.callLocation, CodeLocationLabel<WasmEntryPtrTag>(entrypoint));
+                    }
+                }
+            }
+        }
+    }
+
+    complete(holdLock(m_lock));
+}
+
+void BBQFunctionPlan::runForIndex(Instance* instance, uint32_t functionIndex)
+{
+    Wasm::CodeBlock& codeBlock = *instance->codeBlock();
+    ASSERT(instance->memory()->mode() == codeBlock.mode());
+
+    Ref<Plan> plan = adoptRef(*new BBQFunctionPlan(instance->context(), Ref<Wasm::Module>(instance->module()), functionIndex, codeBlock.mode(), Plan::dontFinalize()));
+    ensureWorklist().enqueue(plan.copyRef());
+    if (UNLIKELY(!Options::useConcurrentJIT()))
+        plan->waitForCompletion();
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
@@ -34,6 +34,7 @@
 #include "WasmCallee.h"
 #include "WasmCallingConvention.h"
 #include "WasmFaultSignalHandler.h"
+#include "WasmInterpreterGenerator.h"
 #include "WasmMemory.h"
 #include "WasmModuleParser.h"
 #include "WasmSignatureInlines.h"
@@ -165,13 +166,16 @@ void BBQPlan::prepare()
         || !tryReserveCapacity(m_unlinkedWasmToWasmCalls, functions.size(), " unlinked WebAssembly to WebAssembly calls")
         || !tryReserveCapacity(m_wasmInternalFunctions, functions.size(), " WebAssembly functions")
         || !tryReserveCapacity(m_compilationContexts, functions.size(), " compilation contexts")
-        || !tryReserveCapacity(m_tierUpCounts, functions.size(), " tier-up counts"))
+        || !tryReserveCapacity(m_tierUpCounts, functions.size(), " tier-up counts")
+        || (Options::useWebAssemblyInterpreter() && !tryReserveCapacity(m_interpreterFunctions, functions.size(), " interpreter functions")))
         return;
 
     m_unlinkedWasmToWasmCalls.resize(functions.size());
     m_wasmInternalFunctions.resize(functions.size());
     m_compilationContexts.resize(functions.size());
     m_tierUpCounts.resize(functions.size());
+    if (Options::useWebAssemblyInterpreter())
+        m_interpreterFunctions.resize(functions.size());
 
     for (unsigned importIndex = 0; importIndex < m_moduleInformation->imports.size(); ++importIndex) {
         Import* import = &m_moduleInformation->imports[importIndex];
@@ -262,37 +266,91 @@ void BBQPlan::compileFunctions(CompilationEffort effort)
             ++m_currentIndex;
         }
 
-        const auto& function = functions[functionIndex];
-        SignatureIndex signatureIndex = m_moduleInformation->internalFunctionSignatureIndices[functionIndex];
-        const Signature& signature = SignatureInformation::get(signatureIndex);
-        unsigned functionIndexSpace = m_wasmToWasmExitStubs.size() + functionIndex;
-        ASSERT_UNUSED(functionIndexSpace, m_moduleInformation->signatureIndexFromFunctionIndexSpace(functionIndexSpace) == signatureIndex);
-        ASSERT(validateFunction(function.data.data(), function.data.size(), signature, m_moduleInformation.get()));
-
-        m_unlinkedWasmToWasmCalls[functionIndex] = Vector<UnlinkedWasmToWasmCall>();
-        TierUpCount* tierUp = Options::useBBQTierUpChecks() ? &m_tierUpCounts[functionIndex] : nullptr;
-        auto parseAndCompileResult = parseAndCompile(m_compilationContexts[functionIndex], function.data.data(), function.data.size(), signature, m_unlinkedWasmToWasmCalls[functionIndex], m_moduleInformation.get(), m_mode, CompilationMode::BBQMode, functionIndex, tierUp, m_throwWasmException);
-
-        if (UNLIKELY(!parseAndCompileResult)) {
+        if (!compileFunction(functionIndex)) {
             auto locker = holdLock(m_lock);
-            if (!m_errorMessage) {
-                // Multiple compiles could fail simultaneously. We arbitrarily choose the first.
-                fail(locker, makeString(parseAndCompileResult.error(), ", in function at index ", String::number(functionIndex))); // FIXME make this an Expected.
-            }
             m_currentIndex = functions.size();
             return;
         }
 
-        m_wasmInternalFunctions[functionIndex] = WTFMove(*parseAndCompileResult);
+        bytesCompiled += functions[functionIndex].data.size();
+    }
+}
 
-        if (m_exportedFunctionIndices.contains(functionIndex)) {
-            auto locker = holdLock(m_lock);
-            auto result = m_embedderToWasmInternalFunctions.add(functionIndex, m_createEmbedderWrapper(m_compilationContexts[functionIndex], signature, &m_unlinkedWasmToWasmCalls[functionIndex], m_moduleInformation.get(), m_mode, functionIndex));
-            ASSERT_UNUSED(result, result.isNewEntry);
+bool BBQPlan::compileFunction(uint32_t functionIndex)
+{
+    const auto& function = m_moduleInformation->functions[functionIndex];
+    SignatureIndex signatureIndex = m_moduleInformation->internalFunctionSignatureIndices[functionIndex];
+    const Signature& signature = SignatureInformation::get(signatureIndex);
+    unsigned functionIndexSpace = m_wasmToWasmExitStubs.size() + functionIndex;
+    ASSERT_UNUSED(functionIndexSpace, m_moduleInformation->signatureIndexFromFunctionIndexSpace(functionIndexSpace) == signatureIndex);
+    ASSERT(validateFunction(function.data.data(), function.data.size(), signature, m_moduleInformation.get()));
+
+    m_unlinkedWasmToWasmCalls[functionIndex] = Vector<UnlinkedWasmToWasmCall>();
+    Expected<std::unique_ptr<InternalFunction>, String> parseAndCompileResult;
+    if (Options::useWebAssemblyInterpreter()) {
+        // The interpreter's trampoline makes its calls indirectly, so it has no callsites to link.
+        m_interpreterFunctions[functionIndex] = std::make_unique<InterpreterFunction>(functionIndex, signatureIndex);
+        parseAndCompileResult = generateInterpreterFunction(m_compilationContexts[functionIndex], function.data.data(), function.data.size(), signature, m_moduleInformation.get(), m_mode, *m_interpreterFunctions[functionIndex], m_throwWasmException);
+    } else {
+        TierUpCount* tierUp = Options::useBBQTierUpChecks() ? &m_tierUpCounts[functionIndex] : nullptr;
+        parseAndCompileResult = parseAndCompile(m_compilationContexts[functionIndex], function.data.data(), function.data.size(), signature, m_unlinkedWasmToWasmCalls[functionIndex], m_moduleInformation.get(), m_mode, CompilationMode::BBQMode, functionIndex, UINT32_MAX, tierUp, m_throwWasmException);
+    }
+
+    if (UNLIKELY(!parseAndCompileResult)) {
+        auto locker = holdLock(m_lock);
+        if (!m_errorMessage) {
+            // Multiple compiles could fail simultaneously. We arbitrarily choose the first.
+            fail(locker, makeString(parseAndCompileResult.error(), ", in function at index ", String::number(functionIndex))); // FIXME make this an Expected.
         }
+        return false;
+    }
 
-        bytesCompiled += function.data.size();
+    m_wasmInternalFunctions[functionIndex] = WTFMove(*parseAndCompileResult);
+
+    if (m_exportedFunctionIndices.contains(functionIndex)) {
+        auto locker = holdLock(m_lock);
+        auto result = m_embedderToWasmInternalFunctions.add(functionIndex, m_createEmbedderWrapper(m_compilationContexts[functionIndex], signature, &m_unlinkedWasmToWasmCalls[functionIndex], m_moduleInformation.get(), m_mode, functionIndex));
+        ASSERT_UNUSED(result, result.isNewEntry);
+    }
+    return true;
+}
+
+bool BBQPlan::compileStreamedFunction(uint32_t functionIndex)
+{
+    ASSERT(m_state >= State::Prepared);
+    {
+        auto locker = holdLock(m_lock);
+        // Another function already failed, so there is no point compiling this one.
+        if (failed())
+            return false;
+    }
+
+    // Nothing validated this function up front, since its bytes have only just arrived.
+    const auto& function = m_moduleInformation->functions[functionIndex];
+    const Signature& signature = SignatureInformation::get(m_moduleInformation->internalFunctionSignatureIndices[functionIndex]);
+    auto validationResult = validateFunction(function.data.data(), function.data.size(), signature, m_moduleInformation.get());
+    if (UNLIKELY(!validationResult)) {
+        auto locker = holdLock(m_lock);
+        if (!m_errorMessage)
+            fail(locker, makeString(validationResult.error(), ", in function at index ", String::number(functionIndex))); // FIXME make this an Expected.
+        return false;
+    }
+
+    return compileFunction(functionIndex);
+}
+
+void BBQPlan::completeStreaming(String&& errorMessage)
+{
+    auto locker = holdLock(m_lock);
+    if (isComplete())
+        return;
+    if (!errorMessage.isNull()) {
+        fail(locker, WTFMove(errorMessage));
+        return;
     }
+    m_currentIndex = m_moduleInformation->functions.size();
+    moveToState(State::Compiled);
+    complete(locker);
 }
 
 void BBQPlan::complete(const AbstractLocker& locker)
@@ -29,6 +29,7 @@
 
 #include "CompilationResult.h"
 #include "WasmB3IRGenerator.h"
+#include "WasmInterpreter.h"
 #include "WasmModuleInformation.h"
 #include "WasmPlan.h"
 #include "WasmTierUpCount.h"
@@ -64,6 +65,12 @@ public:
     JS_EXPORT_PRIVATE void prepare();
     void compileFunctions(CompilationEffort);
 
+    // Streaming compilation hands us each function as soon as its bytes arrive instead of going through work(),
+    // and calls prepare() itself once the code section starts. completeStreaming() links everything once all the
+    // functions have been compiled, or fails the plan if errorMessage isn't null.
+    bool compileStreamedFunction(uint32_t functionIndex);
+    void completeStreaming(String&& errorMessage);
+
     template<typename Functor>
     void initializeCallees(const Functor&);
 
@@ -109,6 +116,12 @@ public:
         return WTFMove(m_tierUpCounts);
     }
 
+    Vector<std::unique_ptr<InterpreterFunction>> takeInterpreterFunctions()
+    {
+        RELEASE_ASSERT(!failed() && !hasWork());
+        return WTFMove(m_interpreterFunctions);
+    }
+
     enum class State : uint8_t {
         Initial,
         Validated,
@@ -138,6 +151,7 @@ private:
     void complete(const AbstractLocker&) override;
 
     const char* stateString(State);
+    bool compileFunction(uint32_t functionIndex);
     
     Vector<uint8_t> m_source;
     Bag<CallLinkInfo> m_callLinkInfos;
@@ -147,6 +161,8 @@ private:
     HashMap<uint32_t, std::unique_ptr<InternalFunction>, typename DefaultHash<uint32_t>::Hash, WTF::UnsignedWithZeroKeyHashTraits<uint32_t>> m_embedderToWasmInternalFunctions;
     Vector<CompilationContext> m_compilationContexts;
     Vector<TierUpCount> m_tierUpCounts;
+    // Only used with useWebAssemblyInterpreter, and then only for functions we run in the interpreter.
+    Vector<std::unique_ptr<InterpreterFunction>> m_interpreterFunctions;
 
     Vector<Vector<UnlinkedWasmToWasmCall>> m_unlinkedWasmToWasmCalls;
     State m_state;
@@ -37,11 +37,17 @@ namespace JSC { namespace Wasm {
 
 Ref<CodeBlock> CodeBlock::create(Context* context, MemoryMode mode, ModuleInformation& moduleInformation, CreateEmbedderWrapper&& createEmbedderWrapper, ThrowWasmException throwWasmException)
 {
-    auto* result = new (NotNull, fastMalloc(sizeof(CodeBlock))) CodeBlock(context, mode, moduleInformation, WTFMove(createEmbedderWrapper), throwWasmException);
+    auto* result = new (NotNull, fastMalloc(sizeof(CodeBlock))) CodeBlock(context, mode, moduleInformation, WTFMove(createEmbedderWrapper), throwWasmException, CompilationKind::Whole);
     return adoptRef(*result);
 }
 
-CodeBlock::CodeBlock(Context* context, MemoryMode mode, ModuleInformation& moduleInformation, CreateEmbedderWrapper&& createEmbedderWrapper, ThrowWasmException throwWasmException)
+Ref<CodeBlock> CodeBlock::createForStreaming(Context* context, MemoryMode mode, ModuleInformation& moduleInformation, CreateEmbedderWrapper&& createEmbedderWrapper, ThrowWasmException throwWasmException)
+{
+    auto* result = new (NotNull, fastMalloc(sizeof(CodeBlock))) CodeBlock(context, mode, moduleInformation, WTFMove(createEmbedderWrapper), throwWasmException, CompilationKind::Streaming);
+    return adoptRef(*result);
+}
+
+CodeBlock::CodeBlock(Context* context, MemoryMode mode, ModuleInformation& moduleInformation, CreateEmbedderWrapper&& createEmbedderWrapper, ThrowWasmException throwWasmException, CompilationKind kind)
     : m_calleeCount(moduleInformation.internalFunctionCount())
     , m_mode(mode)
 {
@@ -58,6 +64,8 @@ CodeBlock::CodeBlock(Context* context, MemoryMode mode, ModuleInformation& modul
         // FIXME: we should eventually collect the BBQ code.
         m_callees.resize(m_calleeCount);
         m_optimizedCallees.resize(m_calleeCount);
+        m_osrEntryCallees.resize(m_calleeCount);
+        m_interpreterCallees.resize(m_calleeCount);
         m_wasmIndirectCallEntryPoints.resize(m_calleeCount);
 
         m_plan->initializeCallees([&] (unsigned calleeIndex, RefPtr<Wasm::Callee>&& embedderEntrypointCallee, Ref<Wasm::Callee>&& wasmEntrypointCallee) {
@@ -72,11 +80,15 @@ CodeBlock::CodeBlock(Context* context, MemoryMode mode, ModuleInformation& modul
         m_wasmToWasmExitStubs = m_plan->takeWasmToWasmExitStubs();
         m_wasmToWasmCallsites = m_plan->takeWasmToWasmCallsites();
         m_tierUpCounts = m_plan->takeTierUpCounts();
+        m_interpreterFunctions = m_plan->takeInterpreterFunctions();
 
         setCompilationFinished();
     }), WTFMove(createEmbedderWrapper), throwWasmException));
     m_plan->setMode(mode);
 
+    if (kind == CompilationKind::Streaming)
+        return;
+
     auto& worklist = Wasm::ensureWorklist();
     // Note, immediately after we enqueue the plan, there is a chance the above callback will be called.
     worklist.enqueue(makeRef(*m_plan.get()));
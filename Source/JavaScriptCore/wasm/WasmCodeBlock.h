@@ -42,8 +42,12 @@ namespace Wasm {
 
 class Callee;
 struct Context;
+class BBQFunctionPlan;
 class BBQPlan;
+class InterpreterFunction;
+class OMGForOSREntryPlan;
 class OMGPlan;
+class StreamingCompiler;
 struct ModuleInformation;
 struct UnlinkedWasmToWasmCall;
 enum class MemoryMode : uint8_t;
@@ -53,6 +57,8 @@ public:
     typedef void CallbackType(Ref<CodeBlock>&&);
     using AsyncCompilationCallback = RefPtr<WTF::SharedTask<CallbackType>>;
     static Ref<CodeBlock> create(Context*, MemoryMode, ModuleInformation&, CreateEmbedderWrapper&&, ThrowWasmException);
+    // The StreamingCompiler drives this CodeBlock's plan itself, feeding it functions while the module is still arriving.
+    static Ref<CodeBlock> createForStreaming(Context*, MemoryMode, ModuleInformation&, CreateEmbedderWrapper&&, ThrowWasmException);
 
     void waitUntilFinished();
     void compileAsync(Context*, AsyncCompilationCallback&&);
@@ -108,20 +114,35 @@ public:
         return m_tierUpCounts[functionIndex];
     }
 
+    // OSR entry callees are never thrown away, so the result stays valid as long as this CodeBlock.
+    Callee* osrEntryCallee(uint32_t functionIndex)
+    {
+        auto locker = holdLock(m_lock);
+        return m_osrEntryCallees[functionIndex].get();
+    }
+
     bool isSafeToRun(MemoryMode);
 
     MemoryMode mode() const { return m_mode; }
 
     ~CodeBlock();
 private:
+    friend class BBQFunctionPlan;
+    friend class OMGForOSREntryPlan;
     friend class OMGPlan;
+    friend class StreamingCompiler;
 
-    CodeBlock(Context*, MemoryMode, ModuleInformation&, CreateEmbedderWrapper&&, ThrowWasmException);
+    enum class CompilationKind : uint8_t { Whole, Streaming };
+    CodeBlock(Context*, MemoryMode, ModuleInformation&, CreateEmbedderWrapper&&, ThrowWasmException, CompilationKind);
     void setCompilationFinished();
     unsigned m_calleeCount;
     MemoryMode m_mode;
     Vector<RefPtr<Callee>> m_callees;
     Vector<RefPtr<Callee>> m_optimizedCallees;
+    Vector<RefPtr<Callee>> m_osrEntryCallees;
+    // The interpreter's trampolines, once BBQ code has replaced them in m_callees.
+    Vector<RefPtr<Callee>> m_interpreterCallees;
+    Vector<std::unique_ptr<InterpreterFunction>> m_interpreterFunctions;
     HashMap<uint32_t, RefPtr<Callee>, typename DefaultHash<uint32_t>::Hash, WTF::UnsignedWithZeroKeyHashTraits<uint32_t>> m_embedderCallees;
     Vector<MacroAssemblerCodePtr<WasmEntryPtrTag>> m_wasmIndirectCallEntryPoints;
     Vector<TierUpCount> m_tierUpCounts;
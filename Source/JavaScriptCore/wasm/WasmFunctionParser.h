@@ -59,6 +59,9 @@ public:
     OpType currentOpcode() const { return m_currentOpcode; }
     size_t currentOpcodeStartingOffset() const { return m_currentOpcodeStartingOffset; }
 
+    Vector<ControlEntry>& controlStack() { return m_controlStack; }
+    ExpressionList& expressionStack() { return m_expressionStack; }
+
 private:
     static const bool verbose = false;
 
@@ -66,6 +69,7 @@ private:
     PartialResult WARN_UNUSED_RETURN parseExpression();
     PartialResult WARN_UNUSED_RETURN parseUnreachableExpression();
     PartialResult WARN_UNUSED_RETURN unifyControl(Vector<ExpressionType>&, unsigned level);
+    PartialResult WARN_UNUSED_RETURN parseExt1OpType(Ext1OpType&);
 
 #define WASM_TRY_POP_EXPRESSION_STACK_INTO(result, what) do {                               \
         WASM_PARSER_FAIL_IF(m_expressionStack.isEmpty(), "can't pop empty stack in " what); \
@@ -92,6 +96,7 @@ private:
     size_t m_currentOpcodeStartingOffset { 0 };
 
     unsigned m_unreachableBlocks { 0 };
+    uint32_t m_loopIndex { 0 };
 };
 
 template<typename Context>
@@ -157,6 +162,17 @@ auto FunctionParser<Context>::parseBody() -> PartialResult
     return { };
 }
 
+template<typename Context>
+auto FunctionParser<Context>::parseExt1OpType(Ext1OpType& result) -> PartialResult
+{
+    uint32_t op;
+    WASM_PARSER_FAIL_IF(!Options::useWebAssemblyBulkMemory(), "invalid opcode ", m_currentOpcode);
+    WASM_PARSER_FAIL_IF(!parseVarUInt32(op), "can't decode extended opcode");
+    WASM_PARSER_FAIL_IF(!isValidExt1OpType(op), "invalid extended opcode ", op);
+    result = static_cast<Ext1OpType>(op);
+    return { };
+}
+
 template<typename Context>
 template<OpType op>
 auto FunctionParser<Context>::binaryCase() -> PartialResult
@@ -374,7 +390,9 @@ auto FunctionParser<Context>::parseExpression() -> PartialResult
     case Block: {
         Type inlineSignature;
         WASM_PARSER_FAIL_IF(!parseResultType(inlineSignature), "can't get block's inline signature");
-        m_controlStack.append({ WTFMove(m_expressionStack), m_context.addBlock(inlineSignature) });
+        // The context sees the enclosing expression stack in place, as it does for loops and ifs.
+        ControlType control = m_context.addBlock(inlineSignature);
+        m_controlStack.append({ WTFMove(m_expressionStack), WTFMove(control) });
         m_expressionStack = ExpressionList();
         return { };
     }
@@ -382,7 +400,9 @@ auto FunctionParser<Context>::parseExpression() -> PartialResult
     case Loop: {
         Type inlineSignature;
         WASM_PARSER_FAIL_IF(!parseResultType(inlineSignature), "can't get loop's inline signature");
-        m_controlStack.append({ WTFMove(m_expressionStack), m_context.addLoop(inlineSignature) });
+        ExpressionList enclosingStack = WTFMove(m_expressionStack);
+        ControlType control = m_context.addLoop(inlineSignature, enclosingStack, m_loopIndex++);
+        m_controlStack.append({ WTFMove(enclosingStack), WTFMove(control) });
         m_expressionStack = ExpressionList();
         return { };
     }
@@ -519,6 +539,52 @@ auto FunctionParser<Context>::parseExpression() -> PartialResult
 
         return { };
     }
+
+    case Ext1: {
+        Ext1OpType op;
+        WASM_FAIL_IF_HELPER_FAILS(parseExt1OpType(op));
+
+        switch (op) {
+        case Ext1OpType::MemoryCopy: {
+            WASM_PARSER_FAIL_IF(!m_info.memory, "memory.copy is only valid if a memory is defined or imported");
+
+            uint8_t reserved;
+            WASM_PARSER_FAIL_IF(!parseVarUInt1(reserved), "can't parse destination reserved varUint1 for memory.copy");
+            WASM_PARSER_FAIL_IF(reserved != 0, "destination reserved varUint1 for memory.copy must be zero");
+            WASM_PARSER_FAIL_IF(!parseVarUInt1(reserved), "can't parse source reserved varUint1 for memory.copy");
+            WASM_PARSER_FAIL_IF(reserved != 0, "source reserved varUint1 for memory.copy must be zero");
+
+            ExpressionType destination;
+            ExpressionType source;
+            ExpressionType count;
+            WASM_TRY_POP_EXPRESSION_STACK_INTO(count, "memory.copy");
+            WASM_TRY_POP_EXPRESSION_STACK_INTO(source, "memory.copy");
+            WASM_TRY_POP_EXPRESSION_STACK_INTO(destination, "memory.copy");
+
+            WASM_TRY_ADD_TO_CONTEXT(addMemoryCopy(destination, source, count));
+            return { };
+        }
+
+        case Ext1OpType::MemoryFill: {
+            WASM_PARSER_FAIL_IF(!m_info.memory, "memory.fill is only valid if a memory is defined or imported");
+
+            uint8_t reserved;
+            WASM_PARSER_FAIL_IF(!parseVarUInt1(reserved), "can't parse reserved varUint1 for memory.fill");
+            WASM_PARSER_FAIL_IF(reserved != 0, "reserved varUint1 for memory.fill must be zero");
+
+            ExpressionType destination;
+            ExpressionType value;
+            ExpressionType count;
+            WASM_TRY_POP_EXPRESSION_STACK_INTO(count, "memory.fill");
+            WASM_TRY_POP_EXPRESSION_STACK_INTO(value, "memory.fill");
+            WASM_TRY_POP_EXPRESSION_STACK_INTO(destination, "memory.fill");
+
+            WASM_TRY_ADD_TO_CONTEXT(addMemoryFill(destination, value, count));
+            return { };
+        }
+        }
+        RELEASE_ASSERT_NOT_REACHED();
+    }
     }
 
     ASSERT_NOT_REACHED();
@@ -637,6 +703,16 @@ auto FunctionParser<Context>::parseUnreachableExpression() -> PartialResult
         return { };
     }
 
+    case Ext1: {
+        Ext1OpType op;
+        WASM_FAIL_IF_HELPER_FAILS(parseExt1OpType(op));
+        uint8_t reserved;
+        WASM_PARSER_FAIL_IF(!parseVarUInt1(reserved), "can't parse reserved varUint1 for ", makeString(op), " in unreachable context");
+        if (op == Ext1OpType::MemoryCopy)
+            WASM_PARSER_FAIL_IF(!parseVarUInt1(reserved), "can't parse source reserved varUint1 for memory.copy in unreachable context");
+        return { };
+    }
+
     // no immediate cases
     FOR_EACH_WASM_BINARY_OP(CREATE_CASE)
     FOR_EACH_WASM_UNARY_OP(CREATE_CASE)
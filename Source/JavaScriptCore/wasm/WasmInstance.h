@@ -136,6 +136,17 @@ public:
         m_storeTopCallFrame(callFrame);
     }
 
+    // Holds the values a BBQ loop passes to the OMG code it OSR enters. It is only read by that
+    // code's entry, before anything else can run on this instance.
+    uint64_t* osrEntryScratchBuffer(size_t numberOfValues)
+    {
+        // The buffer pointer doubles as the "do enter" flag, so it must never be null.
+        numberOfValues = std::max<size_t>(numberOfValues, 1);
+        if (m_osrEntryScratchBuffer.size() < numberOfValues)
+            m_osrEntryScratchBuffer.grow(numberOfValues);
+        return m_osrEntryScratchBuffer.data();
+    }
+
 private:
     Instance(Context*, Ref<Module>&&, EntryFrame**, void**, StoreTopCallFrameCallback&&);
     
@@ -156,6 +167,7 @@ private:
     void** m_pointerToActualStackLimit { nullptr };
     void* m_cachedStackLimit { bitwise_cast<void*>(std::numeric_limits<uintptr_t>::max()) };
     StoreTopCallFrameCallback m_storeTopCallFrame;
+    Vector<uint64_t> m_osrEntryScratchBuffer;
     unsigned m_numImportFunctions { 0 };
 };
 
@@ -0,0 +1,722 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmInterpreter.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmBBQFunctionPlan.h"
+#include "WasmCallee.h"
+#include "WasmCodeBlock.h"
+#include "WasmInstance.h"
+#include "WasmMemory.h"
+#include "WasmModule.h"
+#include "WasmOMGForOSREntryPlan.h"
+#include "WasmOMGPlan.h"
+#include "WasmOps.h"
+#include "WasmTable.h"
+#include "WasmTierUpCount.h"
+#include <cmath>
+#include <wtf/LEBDecoder.h>
+#include <wtf/MathExtras.h>
+
+namespace JSC { namespace Wasm {
+
+namespace WasmInterpreterInternal {
+static const bool verbose = false;
+}
+
+InterpreterFunction::InterpreterFunction(uint32_t functionIndex, SignatureIndex signatureIndex)
+    : m_functionIndex(functionIndex)
+    , m_signatureIndex(signatureIndex)
+    , m_tierUpCountdown(Options::webAssemblyBBQTierUpCount())
+    , m_tierUpStarted(false)
+{
+}
+
+// Every value takes a 64-bit slot. Values of 32-bit types live in the low bits, and whoever reads them
+// ignores the high bits, which is also how the trampoline passes arguments and B3 code reads the OSR
+// entry buffer.
+static ALWAYS_INLINE uint32_t asI32(uint64_t value) { return static_cast<uint32_t>(value); }
+static ALWAYS_INLINE float asF32(uint64_t value) { return bitwise_cast<float>(asI32(value)); }
+static ALWAYS_INLINE double asF64(uint64_t value) { return bitwise_cast<double>(value); }
+static ALWAYS_INLINE uint64_t fromF32(float value) { return bitwise_cast<uint32_t>(value); }
+static ALWAYS_INLINE uint64_t fromF64(double value) { return bitwise_cast<uint64_t>(value); }
+
+static ALWAYS_INLINE uint64_t countTrailingZeros64(uint64_t value)
+{
+    uint32_t low = static_cast<uint32_t>(value);
+    if (low)
+        return ctz32(low);
+    return 32 + ctz32(static_cast<uint32_t>(value >> 32));
+}
+
+template<typename T>
+static ALWAYS_INLINE T rotateLeft(T value, T shift)
+{
+    constexpr T mask = sizeof(T) * 8 - 1;
+    shift &= mask;
+    return (value << shift) | (value >> ((-shift) & mask));
+}
+
+template<typename T>
+static ALWAYS_INLINE T rotateRight(T value, T shift)
+{
+    constexpr T mask = sizeof(T) * 8 - 1;
+    shift &= mask;
+    return (value >> shift) | (value << ((-shift) & mask));
+}
+
+template<typename T>
+static T wasmMin(T left, T right)
+{
+    if (std::isnan(left) || std::isnan(right))
+        return left + right;
+    if (left == right)
+        return std::signbit(left) ? left : right;
+    return left < right ? left : right;
+}
+
+template<typename T>
+static T wasmMax(T left, T right)
+{
+    if (std::isnan(left) || std::isnan(right))
+        return left + right;
+    if (left == right)
+        return std::signbit(left) ? right : left;
+    return left > right ? left : right;
+}
+
+// The bounds are powers of two, so they are exact in both float and double.
+template<typename Result, typename Input>
+static bool truncateToInteger(Input value, Result& result)
+{
+    Input truncated = std::trunc(value);
+    Input upper = std::ldexp(static_cast<Input>(1), std::numeric_limits<Result>::digits);
+    Input lower = std::numeric_limits<Result>::is_signed ? -upper : 0;
+    if (!(truncated >= lower && truncated < upper))
+        return false;
+    result = static_cast<Result>(truncated);
+    return true;
+}
+
+template<typename T>
+static ALWAYS_INLINE T loadFromMemory(const uint8_t* pointer)
+{
+    T result;
+    memcpy(&result, pointer, sizeof(T));
+    return result;
+}
+
+template<typename T>
+static ALWAYS_INLINE void storeToMemory(uint8_t* pointer, T value)
+{
+    memcpy(pointer, &value, sizeof(T));
+}
+
+uint32_t runInterpreter(InterpreterFrame* frame)
+{
+    Instance* instance = frame->instance;
+    InterpreterFunction& function = *frame->function;
+    const ModuleInformation& info = instance->module().moduleInformation();
+    const Vector<uint8_t>& code = info.functions[function.functionIndex()].data;
+    const uint8_t* bytes = code.data();
+    size_t length = code.size();
+    const Signature& functionSignature = SignatureInformation::get(function.signatureIndex());
+
+    uint64_t* locals = frame->values();
+    uint64_t* stackBase = locals + function.numberOfLocals();
+    size_t pc;
+    uint32_t sideTableIndex;
+    uint64_t* sp;
+
+    if (!frame->pc) {
+        std::fill(locals + functionSignature.argumentCount(), stackBase, 0);
+        pc = function.codeStartPC();
+        sideTableIndex = 0;
+        sp = stackBase;
+
+        if (UNLIKELY(function.checkIfShouldTierUp(TierUpCount::functionEntryDecrement()))) {
+            if (function.shouldStartTierUp())
+                BBQFunctionPlan::runForIndex(instance, function.functionIndex());
+            function.optimizeAfterWarmUp();
+        }
+    } else {
+        pc = frame->pc;
+        sideTableIndex = frame->sideTableIndex;
+        sp = stackBase + frame->stackHeight;
+        if (frame->resultPending) {
+            *sp++ = frame->result;
+            frame->resultPending = 0;
+        }
+    }
+
+    auto exit = [&] (InterpreterExit kind, uint32_t callSignatureSlot = 0) -> uint32_t {
+        frame->pc = pc;
+        frame->sideTableIndex = sideTableIndex;
+        frame->stackHeight = sp - stackBase;
+        return static_cast<uint32_t>(kind) + callSignatureSlot;
+    };
+
+    auto trap = [&] (ExceptionType type) -> uint32_t {
+        frame->exceptionType = static_cast<uint64_t>(type);
+        return exit(InterpreterExit::Trap);
+    };
+
+    // The validator has already checked the immediates.
+    auto readU32 = [&] () -> uint32_t {
+        uint32_t result;
+        bool success = WTF::LEBDecoder::decodeUInt32(bytes, length, pc, result);
+        ASSERT_UNUSED(success, success);
+        return result;
+    };
+
+    auto branch = [&] (const InterpreterSideTableEntry& entry) {
+        uint64_t* target = stackBase + entry.targetStackHeight;
+        std::copy(sp - entry.arity, sp, target);
+        sp = target + entry.arity;
+        pc = entry.targetPC;
+        sideTableIndex = entry.targetSideTableIndex;
+    };
+
+    auto call = [&] (SignatureIndex signatureIndex, void* target, Instance* targetInstance) -> uint32_t {
+        const Signature& signature = SignatureInformation::get(signatureIndex);
+        sp -= signature.argumentCount();
+        frame->exitTarget = target;
+        frame->exitTargetInstance = targetInstance;
+        frame->exitBuffer = sp;
+        frame->resultPending = signature.returnType() != Void;
+        return exit(InterpreterExit::Call, function.callSignatureSlot(signatureIndex));
+    };
+
+    auto doReturn = [&] () -> uint32_t {
+        if (functionSignature.returnType() != Void)
+            frame->result = sp[-1];
+        return exit(InterpreterExit::Return);
+    };
+
+    // Pops the address and returns where the access goes, or nullptr if it is out of bounds.
+    auto memoryAccess = [&] (size_t size) -> uint8_t* {
+        readU32(); // Alignment hint.
+        uint32_t offset = readU32();
+        uint32_t pointer = asI32(*--sp);
+        if (UNLIKELY(static_cast<uint64_t>(pointer) + offset + size > instance->cachedMemorySize()))
+            return nullptr;
+        return static_cast<uint8_t*>(instance->cachedMemory()) + pointer + offset;
+    };
+
+#define INTERPRETER_LOAD(name, memoryType, valueType) \
+    case name: { \
+        uint8_t* pointer = memoryAccess(sizeof(memoryType)); \
+        if (UNLIKELY(!pointer)) \
+            return trap(ExceptionType::OutOfBoundsMemoryAccess); \
+        *sp++ = static_cast<valueType>(loadFromMemory<memoryType>(pointer)); \
+        break; \
+    }
+
+#define INTERPRETER_STORE(name, memoryType) \
+    case name: { \
+        uint64_t value = *--sp; \
+        uint8_t* pointer = memoryAccess(sizeof(memoryType)); \
+        if (UNLIKELY(!pointer)) \
+            return trap(ExceptionType::OutOfBoundsMemoryAccess); \
+        storeToMemory(pointer, static_cast<memoryType>(value)); \
+        break; \
+    }
+
+#define INTERPRETER_UNARY(name, type, read, write, expression) \
+    case name: { \
+        type operand = read(sp[-1]); \
+        UNUSED_VARIABLE(operand); \
+        sp[-1] = write(expression); \
+        break; \
+    }
+
+#define INTERPRETER_BINARY(name, type, read, write, expression) \
+    case name: { \
+        type right = read(sp[-1]); \
+        type left = read(sp[-2]); \
+        --sp; \
+        sp[-1] = write(expression); \
+        break; \
+    }
+
+#define INTERPRETER_TRUNCATE(name, resultType, valueType, read) \
+    case name: { \
+        resultType result; \
+        if (UNLIKELY(!truncateToInteger(read(sp[-1]), result))) \
+            return trap(ExceptionType::OutOfBoundsTrunc); \
+        sp[-1] = static_cast<valueType>(result); \
+        break; \
+    }
+
+#define I32(value) static_cast<uint64_t>(static_cast<uint32_t>(value))
+#define I64(value) static_cast<uint64_t>(value)
+#define BOOL(value) static_cast<uint64_t>(!!(value))
+
+    while (true) {
+        OpType op = static_cast<OpType>(bytes[pc++]);
+        switch (op) {
+        case Unreachable:
+            return trap(ExceptionType::Unreachable);
+
+        case Nop:
+            break;
+
+        case Block:
+            ++pc; // Block type.
+            break;
+
+        case Loop: {
+            ++pc; // Block type.
+            const InterpreterSideTableEntry& entry = function.sideTableEntry(sideTableIndex++);
+            if (UNLIKELY(function.checkIfShouldTierUp(TierUpCount::loopDecrement()))) {
+                if (function.shouldStartTierUp())
+                    BBQFunctionPlan::runForIndex(instance, function.functionIndex());
+                else if (Options::useWebAssemblyOSR()) {
+                    // A hot loop is also a good reason for later calls to start in OMG code.
+                    OMGPlan::runForIndex(instance, function.functionIndex());
+                    if (Callee* osrEntryCallee = OMGForOSREntryPlan::osrEntryCalleeForLoop(instance, function.functionIndex(), entry.loopIndex)) {
+                        dataLogLnIf(WasmInterpreterInternal::verbose, "OSR entering loop ", entry.loopIndex, " of ", function.functionIndex(), " from the interpreter");
+                        // The locals are followed by the value stack, which is just what the OSR entry expects.
+                        size_t numberOfValues = sp - locals;
+                        uint64_t* buffer = instance->osrEntryScratchBuffer(numberOfValues);
+                        std::copy(locals, sp, buffer);
+                        frame->exitBuffer = buffer;
+                        frame->exitTarget = osrEntryCallee->entrypoint().executableAddress();
+                        return exit(InterpreterExit::OSREntry);
+                    }
+                }
+                function.optimizeAfterWarmUp();
+            }
+            break;
+        }
+
+        case If: {
+            ++pc; // Block type.
+            if (asI32(*--sp))
+                ++sideTableIndex;
+            else
+                branch(function.sideTableEntry(sideTableIndex));
+            break;
+        }
+
+        case Else:
+            // We only get here by falling off the end of the then branch.
+            branch(function.sideTableEntry(sideTableIndex));
+            break;
+
+        case End:
+            if (pc - 1 == function.returnPC())
+                return doReturn();
+            break;
+
+        case Br:
+            branch(function.sideTableEntry(sideTableIndex));
+            break;
+
+        case BrIf: {
+            if (asI32(*--sp))
+                branch(function.sideTableEntry(sideTableIndex));
+            else {
+                readU32();
+                ++sideTableIndex;
+            }
+            break;
+        }
+
+        case BrTable: {
+            uint32_t numberOfTargets = readU32();
+            uint32_t index = asI32(*--sp);
+            branch(function.sideTableEntry(sideTableIndex + std::min(index, numberOfTargets)));
+            break;
+        }
+
+        case Return:
+            return doReturn();
+
+        case Drop:
+            --sp;
+            break;
+
+        case Select: {
+            uint32_t condition = asI32(sp[-1]);
+            uint64_t nonZero = sp[-3];
+            uint64_t zero = sp[-2];
+            sp -= 2;
+            sp[-1] = condition ? nonZero : zero;
+            break;
+        }
+
+        case GetLocal:
+            *sp++ = locals[readU32()];
+            break;
+
+        case SetLocal:
+            locals[readU32()] = *--sp;
+            break;
+
+        case TeeLocal:
+            locals[readU32()] = sp[-1];
+            break;
+
+        case GetGlobal:
+            *sp++ = instance->loadI64Global(readU32());
+            break;
+
+        case SetGlobal: {
+            uint32_t index = readU32();
+            uint64_t value = *--sp;
+            if (info.globals[index].type == I32 || info.globals[index].type == F32)
+                value = asI32(value);
+            instance->setGlobal(index, value);
+            break;
+        }
+
+        case I32Const: {
+            int32_t value;
+            bool success = WTF::LEBDecoder::decodeInt32(bytes, length, pc, value);
+            ASSERT_UNUSED(success, success);
+            *sp++ = I32(value);
+            break;
+        }
+
+        case I64Const: {
+            int64_t value;
+            bool success = WTF::LEBDecoder::decodeInt64(bytes, length, pc, value);
+            ASSERT_UNUSED(success, success);
+            *sp++ = I64(value);
+            break;
+        }
+
+        case F32Const:
+            *sp++ = loadFromMemory<uint32_t>(bytes + pc);
+            pc += sizeof(uint32_t);
+            break;
+
+        case F64Const:
+            *sp++ = loadFromMemory<uint64_t>(bytes + pc);
+            pc += sizeof(uint64_t);
+            break;
+
+        case Call: {
+            uint32_t functionIndexSpace = readU32();
+            SignatureIndex signatureIndex = info.signatureIndexFromFunctionIndexSpace(functionIndexSpace);
+            if (info.isImportedFunctionFromFunctionIndexSpace(functionIndexSpace)) {
+                Instance::ImportFunctionInfo* import = instance->importFunctionInfo(functionIndexSpace);
+                if (import->targetInstance)
+                    return call(signatureIndex, import->wasmEntrypointLoadLocation->executableAddress(), import->targetInstance);
+                return call(signatureIndex, import->wasmToEmbedderStub.executableAddress(), instance);
+            }
+            return call(signatureIndex, instance->codeBlock()->entrypointLoadLocationFromFunctionIndexSpace(functionIndexSpace)->executableAddress(), instance);
+        }
+
+        case CallIndirect: {
+            uint32_t signatureIndexInModule = readU32();
+            ++pc; // Reserved table index.
+            uint32_t calleeIndex = asI32(*--sp);
+            Table* table = instance->table();
+            if (UNLIKELY(calleeIndex >= table->length()))
+                return trap(ExceptionType::OutOfBoundsCallIndirect);
+            const WasmToWasmImportableFunction& callee = table->function(calleeIndex);
+            if (UNLIKELY(callee.signatureIndex == Signature::invalidIndex))
+                return trap(ExceptionType::NullTableEntry);
+            SignatureIndex signatureIndex = SignatureInformation::get(info.usedSignatures[signatureIndexInModule].get());
+            if (UNLIKELY(callee.signatureIndex != signatureIndex))
+                return trap(ExceptionType::BadSignature);
+            return call(signatureIndex, callee.entrypointLoadLocation->executableAddress(), table->instance(calleeIndex));
+        }
+
+        case CurrentMemory:
+            ++pc; // Reserved memory index.
+            *sp++ = I32(instance->cachedMemorySize() / PageCount::pageSize);
+            break;
+
+        case GrowMemory: {
+            ++pc; // Reserved memory index.
+            int32_t delta = static_cast<int32_t>(asI32(sp[-1]));
+            int32_t result = -1;
+            instance->storeTopCallFrame(frame->callFrame);
+            if (delta >= 0) {
+                auto grown = instance->memory()->grow(PageCount(delta));
+                if (grown)
+                    result = grown.value().pageCount();
+            }
+            sp[-1] = I32(result);
+            break;
+        }
+
+        case Ext1: {
+            // Like B3 code, nothing is written if any byte of a range is out of bounds.
+            auto inBounds = [&] (uint32_t pointer, uint32_t count) {
+                return static_cast<uint64_t>(pointer) + count <= instance->cachedMemorySize();
+            };
+            uint8_t* memory = static_cast<uint8_t*>(instance->cachedMemory());
+            switch (static_cast<Ext1OpType>(readU32())) {
+            case Ext1OpType::MemoryCopy: {
+                pc += 2; // Reserved destination and source memory indices.
+                uint32_t count = asI32(sp[-1]);
+                uint32_t source = asI32(sp[-2]);
+                uint32_t destination = asI32(sp[-3]);
+                sp -= 3;
+                if (UNLIKELY(!inBounds(destination, count) || !inBounds(source, count)))
+                    return trap(ExceptionType::OutOfBoundsMemoryAccess);
+                memmove(memory + destination, memory + source, count);
+                break;
+            }
+            case Ext1OpType::MemoryFill: {
+                ++pc; // Reserved memory index.
+                uint32_t count = asI32(sp[-1]);
+                uint8_t value = static_cast<uint8_t>(sp[-2]);
+                uint32_t destination = asI32(sp[-3]);
+                sp -= 3;
+                if (UNLIKELY(!inBounds(destination, count)))
+                    return trap(ExceptionType::OutOfBoundsMemoryAccess);
+                memset(memory + destination, value, count);
+                break;
+            }
+            }
+            break;
+        }
+
+        INTERPRETER_LOAD(I32Load, uint32_t, uint32_t)
+        INTERPRETER_LOAD(I32Load8S, int8_t, uint32_t)
+        INTERPRETER_LOAD(I32Load8U, uint8_t, uint32_t)
+        INTERPRETER_LOAD(I32Load16S, int16_t, uint32_t)
+        INTERPRETER_LOAD(I32Load16U, uint16_t, uint32_t)
+        INTERPRETER_LOAD(I64Load, uint64_t, uint64_t)
+        INTERPRETER_LOAD(I64Load8S, int8_t, uint64_t)
+        INTERPRETER_LOAD(I64Load8U, uint8_t, uint64_t)
+        INTERPRETER_LOAD(I64Load16S, int16_t, uint64_t)
+        INTERPRETER_LOAD(I64Load16U, uint16_t, uint64_t)
+        INTERPRETER_LOAD(I64Load32S, int32_t, uint64_t)
+        INTERPRETER_LOAD(I64Load32U, uint32_t, uint64_t)
+        INTERPRETER_LOAD(F32Load, uint32_t, uint32_t)
+        INTERPRETER_LOAD(F64Load, uint64_t, uint64_t)
+
+        INTERPRETER_STORE(I32Store, uint32_t)
+        INTERPRETER_STORE(I32Store8, uint8_t)
+        INTERPRETER_STORE(I32Store16, uint16_t)
+        INTERPRETER_STORE(I64Store, uint64_t)
+        INTERPRETER_STORE(I64Store8, uint8_t)
+        INTERPRETER_STORE(I64Store16, uint16_t)
+        INTERPRETER_STORE(I64Store32, uint32_t)
+        INTERPRETER_STORE(F32Store, uint32_t)
+        INTERPRETER_STORE(F64Store, uint64_t)
+
+        INTERPRETER_UNARY(I32Eqz, uint32_t, asI32, BOOL, !operand)
+        INTERPRETER_UNARY(I32Clz, uint32_t, asI32, I32, clz32(operand))
+        INTERPRETER_UNARY(I32Ctz, uint32_t, asI32, I32, ctz32(operand))
+        INTERPRETER_UNARY(I32Popcnt, uint32_t, asI32, I32, WTF::bitCount(operand))
+        INTERPRETER_UNARY(I64Eqz, uint64_t, I64, BOOL, !operand)
+        INTERPRETER_UNARY(I64Clz, uint64_t, I64, I64, clz64(operand))
+        INTERPRETER_UNARY(I64Ctz, uint64_t, I64, I64, countTrailingZeros64(operand))
+        INTERPRETER_UNARY(I64Popcnt, uint64_t, I64, I64, WTF::bitCount(operand))
+
+        INTERPRETER_UNARY(F32Abs, uint32_t, asI32, I32, operand & 0x7fffffffu)
+        INTERPRETER_UNARY(F32Neg, uint32_t, asI32, I32, operand ^ 0x80000000u)
+        INTERPRETER_UNARY(F32Ceil, float, asF32, fromF32, std::ceil(operand))
+        INTERPRETER_UNARY(F32Floor, float, asF32, fromF32, std::floor(operand))
+        INTERPRETER_UNARY(F32Trunc, float, asF32, fromF32, std::trunc(operand))
+        INTERPRETER_UNARY(F32Nearest, float, asF32, fromF32, std::nearbyint(operand))
+        INTERPRETER_UNARY(F32Sqrt, float, asF32, fromF32, std::sqrt(operand))
+        INTERPRETER_UNARY(F64Abs, uint64_t, I64, I64, operand & 0x7fffffffffffffffull)
+        INTERPRETER_UNARY(F64Neg, uint64_t, I64, I64, operand ^ 0x8000000000000000ull)
+        INTERPRETER_UNARY(F64Ceil, double, asF64, fromF64, std::ceil(operand))
+        INTERPRETER_UNARY(F64Floor, double, asF64, fromF64, std::floor(operand))
+        INTERPRETER_UNARY(F64Trunc, double, asF64, fromF64, std::trunc(operand))
+        INTERPRETER_UNARY(F64Nearest, double, asF64, fromF64, std::nearbyint(operand))
+        INTERPRETER_UNARY(F64Sqrt, double, asF64, fromF64, std::sqrt(operand))
+
+        INTERPRETER_UNARY(I32WrapI64, uint64_t, I64, I32, operand)
+        INTERPRETER_UNARY(I64ExtendSI32, uint32_t, asI32, I64, static_cast<int64_t>(static_cast<int32_t>(operand)))
+        INTERPRETER_UNARY(I64ExtendUI32, uint32_t, asI32, I64, operand)
+        INTERPRETER_UNARY(F32ConvertSI32, uint32_t, asI32, fromF32, static_cast<float>(static_cast<int32_t>(operand)))
+        INTERPRETER_UNARY(F32ConvertUI32, uint32_t, asI32, fromF32, static_cast<float>(operand))
+        INTERPRETER_UNARY(F32ConvertSI64, uint64_t, I64, fromF32, static_cast<float>(static_cast<int64_t>(operand)))
+        INTERPRETER_UNARY(F32ConvertUI64, uint64_t, I64, fromF32, static_cast<float>(operand))
+        INTERPRETER_UNARY(F64ConvertSI32, uint32_t, asI32, fromF64, static_cast<double>(static_cast<int32_t>(operand)))
+        INTERPRETER_UNARY(F64ConvertUI32, uint32_t, asI32, fromF64, static_cast<double>(operand))
+        INTERPRETER_UNARY(F64ConvertSI64, uint64_t, I64, fromF64, static_cast<double>(static_cast<int64_t>(operand)))
+        INTERPRETER_UNARY(F64ConvertUI64, uint64_t, I64, fromF64, static_cast<double>(operand))
+        INTERPRETER_UNARY(F32DemoteF64, double, asF64, fromF32, static_cast<float>(operand))
+        INTERPRETER_UNARY(F64PromoteF32, float, asF32, fromF64, static_cast<double>(operand))
+        INTERPRETER_UNARY(I32ReinterpretF32, uint32_t, asI32, I32, operand)
+        INTERPRETER_UNARY(F32ReinterpretI32, uint32_t, asI32, I32, operand)
+        INTERPRETER_UNARY(I64ReinterpretF64, uint64_t, I64, I64, operand)
+        INTERPRETER_UNARY(F64ReinterpretI64, uint64_t, I64, I64, operand)
+
+        INTERPRETER_TRUNCATE(I32TruncSF32, int32_t, uint32_t, asF32)
+        INTERPRETER_TRUNCATE(I32TruncUF32, uint32_t, uint32_t, asF32)
+        INTERPRETER_TRUNCATE(I32TruncSF64, int32_t, uint32_t, asF64)
+        INTERPRETER_TRUNCATE(I32TruncUF64, uint32_t, uint32_t, asF64)
+        INTERPRETER_TRUNCATE(I64TruncSF32, int64_t, uint64_t, asF32)
+        INTERPRETER_TRUNCATE(I64TruncUF32, uint64_t, uint64_t, asF32)
+        INTERPRETER_TRUNCATE(I64TruncSF64, int64_t, uint64_t, asF64)
+        INTERPRETER_TRUNCATE(I64TruncUF64, uint64_t, uint64_t, asF64)
+
+        INTERPRETER_BINARY(I32Add, uint32_t, asI32, I32, left + right)
+        INTERPRETER_BINARY(I32Sub, uint32_t, asI32, I32, left - right)
+        INTERPRETER_BINARY(I32Mul, uint32_t, asI32, I32, left * right)
+        INTERPRETER_BINARY(I32And, uint32_t, asI32, I32, left & right)
+        INTERPRETER_BINARY(I32Or, uint32_t, asI32, I32, left | right)
+        INTERPRETER_BINARY(I32Xor, uint32_t, asI32, I32, left ^ right)
+        INTERPRETER_BINARY(I32Shl, uint32_t, asI32, I32, left << (right & 31))
+        INTERPRETER_BINARY(I32ShrS, uint32_t, asI32, I32, static_cast<int32_t>(left) >> (right & 31))
+        INTERPRETER_BINARY(I32ShrU, uint32_t, asI32, I32, left >> (right & 31))
+        INTERPRETER_BINARY(I32Rotl, uint32_t, asI32, I32, rotateLeft(left, right))
+        INTERPRETER_BINARY(I32Rotr, uint32_t, asI32, I32, rotateRight(left, right))
+        INTERPRETER_BINARY(I32Eq, uint32_t, asI32, BOOL, left == right)
+        INTERPRETER_BINARY(I32Ne, uint32_t, asI32, BOOL, left != right)
+        INTERPRETER_BINARY(I32LtS, uint32_t, asI32, BOOL, static_cast<int32_t>(left) < static_cast<int32_t>(right))
+        INTERPRETER_BINARY(I32LtU, uint32_t, asI32, BOOL, left < right)
+        INTERPRETER_BINARY(I32GtS, uint32_t, asI32, BOOL, static_cast<int32_t>(left) > static_cast<int32_t>(right))
+        INTERPRETER_BINARY(I32GtU, uint32_t, asI32, BOOL, left > right)
+        INTERPRETER_BINARY(I32LeS, uint32_t, asI32, BOOL, static_cast<int32_t>(left) <= static_cast<int32_t>(right))
+        INTERPRETER_BINARY(I32LeU, uint32_t, asI32, BOOL, left <= right)
+        INTERPRETER_BINARY(I32GeS, uint32_t, asI32, BOOL, static_cast<int32_t>(left) >= static_cast<int32_t>(right))
+        INTERPRETER_BINARY(I32GeU, uint32_t, asI32, BOOL, left >= right)
+
+        INTERPRETER_BINARY(I64Add, uint64_t, I64, I64, left + right)
+        INTERPRETER_BINARY(I64Sub, uint64_t, I64, I64, left - right)
+        INTERPRETER_BINARY(I64Mul, uint64_t, I64, I64, left * right)
+        INTERPRETER_BINARY(I64And, uint64_t, I64, I64, left & right)
+        INTERPRETER_BINARY(I64Or, uint64_t, I64, I64, left | right)
+        INTERPRETER_BINARY(I64Xor, uint64_t, I64, I64, left ^ right)
+        INTERPRETER_BINARY(I64Shl, uint64_t, I64, I64, left << (right & 63))
+        INTERPRETER_BINARY(I64ShrS, uint64_t, I64, I64, static_cast<int64_t>(left) >> (right & 63))
+        INTERPRETER_BINARY(I64ShrU, uint64_t, I64, I64, left >> (right & 63))
+        INTERPRETER_BINARY(I64Rotl, uint64_t, I64, I64, rotateLeft(left, right))
+        INTERPRETER_BINARY(I64Rotr, uint64_t, I64, I64, rotateRight(left, right))
+        INTERPRETER_BINARY(I64Eq, uint64_t, I64, BOOL, left == right)
+        INTERPRETER_BINARY(I64Ne, uint64_t, I64, BOOL, left != right)
+        INTERPRETER_BINARY(I64LtS, uint64_t, I64, BOOL, static_cast<int64_t>(left) < static_cast<int64_t>(right))
+        INTERPRETER_BINARY(I64LtU, uint64_t, I64, BOOL, left < right)
+        INTERPRETER_BINARY(I64GtS, uint64_t, I64, BOOL, static_cast<int64_t>(left) > static_cast<int64_t>(right))
+        INTERPRETER_BINARY(I64GtU, uint64_t, I64, BOOL, left > right)
+        INTERPRETER_BINARY(I64LeS, uint64_t, I64, BOOL, static_cast<int64_t>(left) <= static_cast<int64_t>(right))
+        INTERPRETER_BINARY(I64LeU, uint64_t, I64, BOOL, left <= right)
+        INTERPRETER_BINARY(I64GeS, uint64_t, I64, BOOL, static_cast<int64_t>(left) >= static_cast<int64_t>(right))
+        INTERPRETER_BINARY(I64GeU, uint64_t, I64, BOOL, left >= right)
+
+        INTERPRETER_BINARY(F32Add, float, asF32, fromF32, left + right)
+        INTERPRETER_BINARY(F32Sub, float, asF32, fromF32, left - right)
+        INTERPRETER_BINARY(F32Mul, float, asF32, fromF32, left * right)
+        INTERPRETER_BINARY(F32Div, float, asF32, fromF32, left / right)
+        INTERPRETER_BINARY(F32Min, float, asF32, fromF32, wasmMin(left, right))
+        INTERPRETER_BINARY(F32Max, float, asF32, fromF32, wasmMax(left, right))
+        INTERPRETER_BINARY(F32Copysign, uint32_t, asI32, I32, (left & 0x7fffffffu) | (right & 0x80000000u))
+        INTERPRETER_BINARY(F32Eq, float, asF32, BOOL, left == right)
+        INTERPRETER_BINARY(F32Ne, float, asF32, BOOL, left != right)
+        INTERPRETER_BINARY(F32Lt, float, asF32, BOOL, left < right)
+        INTERPRETER_BINARY(F32Gt, float, asF32, BOOL, left > right)
+        INTERPRETER_BINARY(F32Le, float, asF32, BOOL, left <= right)
+        INTERPRETER_BINARY(F32Ge, float, asF32, BOOL, left >= right)
+
+        INTERPRETER_BINARY(F64Add, double, asF64, fromF64, left + right)
+        INTERPRETER_BINARY(F64Sub, double, asF64, fromF64, left - right)
+        INTERPRETER_BINARY(F64Mul, double, asF64, fromF64, left * right)
+        INTERPRETER_BINARY(F64Div, double, asF64, fromF64, left / right)
+        INTERPRETER_BINARY(F64Min, double, asF64, fromF64, wasmMin(left, right))
+        INTERPRETER_BINARY(F64Max, double, asF64, fromF64, wasmMax(left, right))
+        INTERPRETER_BINARY(F64Copysign, uint64_t, I64, I64, (left & 0x7fffffffffffffffull) | (right & 0x8000000000000000ull))
+        INTERPRETER_BINARY(F64Eq, double, asF64, BOOL, left == right)
+        INTERPRETER_BINARY(F64Ne, double, asF64, BOOL, left != right)
+        INTERPRETER_BINARY(F64Lt, double, asF64, BOOL, left < right)
+        INTERPRETER_BINARY(F64Gt, double, asF64, BOOL, left > right)
+        INTERPRETER_BINARY(F64Le, double, asF64, BOOL, left <= right)
+        INTERPRETER_BINARY(F64Ge, double, asF64, BOOL, left >= right)
+
+        case I32DivS:
+        case I32DivU:
+        case I32RemS:
+        case I32RemU: {
+            uint32_t right = asI32(sp[-1]);
+            uint32_t left = asI32(sp[-2]);
+            if (UNLIKELY(!right))
+                return trap(ExceptionType::DivisionByZero);
+            uint32_t result;
+            if (op == I32DivU)
+                result = left / right;
+            else if (op == I32RemU)
+                result = left % right;
+            else if (static_cast<int32_t>(right) == -1) {
+                if (op == I32DivS && static_cast<int32_t>(left) == std::numeric_limits<int32_t>::min())
+                    return trap(ExceptionType::IntegerOverflow);
+                result = op == I32DivS ? -left : 0;
+            } else if (op == I32DivS)
+                result = static_cast<int32_t>(left) / static_cast<int32_t>(right);
+            else
+                result = static_cast<int32_t>(left) % static_cast<int32_t>(right);
+            --sp;
+            sp[-1] = I32(result);
+            break;
+        }
+
+        case I64DivS:
+        case I64DivU:
+        case I64RemS:
+        case I64RemU: {
+            uint64_t right = sp[-1];
+            uint64_t left = sp[-2];
+            if (UNLIKELY(!right))
+                return trap(ExceptionType::DivisionByZero);
+            uint64_t result;
+            if (op == I64DivU)
+                result = left / right;
+            else if (op == I64RemU)
+                result = left % right;
+            else if (static_cast<int64_t>(right) == -1) {
+                if (op == I64DivS && static_cast<int64_t>(left) == std::numeric_limits<int64_t>::min())
+                    return trap(ExceptionType::IntegerOverflow);
+                result = op == I64DivS ? -left : 0;
+            } else if (op == I64DivS)
+                result = static_cast<int64_t>(left) / static_cast<int64_t>(right);
+            else
+                result = static_cast<int64_t>(left) % static_cast<int64_t>(right);
+            --sp;
+            sp[-1] = result;
+            break;
+        }
+
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+    }
+
+#undef INTERPRETER_LOAD
+#undef INTERPRETER_STORE
+#undef INTERPRETER_UNARY
+#undef INTERPRETER_BINARY
+#undef INTERPRETER_TRUNCATE
+#undef I32
+#undef I64
+#undef BOOL
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
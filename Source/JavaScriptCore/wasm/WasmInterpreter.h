@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "Options.h"
+#include "WasmSignature.h"
+#include <wtf/Atomics.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace JSC { namespace Wasm {
+
+class Instance;
+
+// The interpreter runs the function's bytecode in place. Rather than decoding the block structure as
+// it goes, it finds where to continue after each control transfer in a side table built once by
+// InterpreterGenerator. Every if, else, br, br_if and loop has one entry, and every br_table has one
+// per target followed by one for its default target, all in bytecode order. The interpreter keeps the
+// index of the next entry to use alongside the pc, so falling through an instruction only skips its
+// entries.
+struct InterpreterSideTableEntry {
+    uint32_t targetPC;
+    uint32_t targetSideTableIndex;
+    // Height of the value stack at the target, not counting the values the branch transfers.
+    uint32_t targetStackHeight;
+    uint32_t arity;
+    // Only meaningful for the entry of a loop instruction, which is also the target of its back edges.
+    uint32_t loopIndex;
+};
+
+class InterpreterFunction {
+    WTF_MAKE_NONCOPYABLE(InterpreterFunction);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    InterpreterFunction(uint32_t functionIndex, SignatureIndex);
+
+    uint32_t functionIndex() const { return m_functionIndex; }
+    SignatureIndex signatureIndex() const { return m_signatureIndex; }
+
+    // Locals include the arguments. Both locals and stack values take one 64-bit slot each.
+    uint32_t numberOfLocals() const { return m_numberOfLocals; }
+    uint32_t maxStackHeight() const { return m_maxStackHeight; }
+    uint32_t codeStartPC() const { return m_codeStartPC; }
+    uint32_t returnPC() const { return m_returnPC; }
+
+    const InterpreterSideTableEntry& sideTableEntry(uint32_t index) const { return m_sideTable[index]; }
+
+    // Calls exit to the trampoline, which has code to pass arguments for each of these signatures.
+    const Vector<SignatureIndex>& callSignatures() const { return m_callSignatures; }
+    uint32_t callSignatureSlot(SignatureIndex signatureIndex) const
+    {
+        size_t slot = m_callSignatures.find(signatureIndex);
+        ASSERT(slot != notFound);
+        return static_cast<uint32_t>(slot);
+    }
+
+    // Like TierUpCount, the countdown isn't updated atomically but starting the tier up is.
+    bool checkIfShouldTierUp(uint32_t decrement)
+    {
+        m_tierUpCountdown -= static_cast<int32_t>(decrement);
+        return m_tierUpCountdown < 0;
+    }
+    bool shouldStartTierUp() { return !m_tierUpStarted.exchange(true); }
+    void optimizeAfterWarmUp() { m_tierUpCountdown = Options::webAssemblyOMGTierUpCount(); }
+
+private:
+    friend class InterpreterGenerator;
+
+    uint32_t m_functionIndex;
+    SignatureIndex m_signatureIndex;
+    uint32_t m_numberOfLocals { 0 };
+    uint32_t m_maxStackHeight { 0 };
+    uint32_t m_codeStartPC { 0 };
+    uint32_t m_returnPC { 0 };
+    Vector<InterpreterSideTableEntry> m_sideTable;
+    Vector<SignatureIndex> m_callSignatures;
+    int32_t m_tierUpCountdown;
+    Atomic<bool> m_tierUpStarted;
+};
+
+// What the interpreter asks its trampoline to do when it returns. A call with the k-th of the function's
+// call signatures is reported as Call + k.
+enum class InterpreterExit : uint32_t {
+    Return,
+    Trap,
+    OSREntry,
+    Call,
+};
+
+// Lives in the trampoline's stack frame, followed by the locals and then the value stack. Every field
+// the trampoline uses is 64 bits wide so that the values that follow stay aligned.
+struct InterpreterFrame {
+    Instance* instance;
+    InterpreterFunction* function;
+    void* callFrame;
+
+    // Set by the interpreter before exiting. For a call, the target is the entrypoint to call with the
+    // context switched to the target instance, and the buffer holds the arguments. For an OSR entry,
+    // the target is the OMG entrypoint, and the buffer holds the values it expects.
+    void* exitTarget;
+    Instance* exitTargetInstance;
+    uint64_t* exitBuffer;
+    // The function's result on return, or the callee's result stored by the trampoline after a call.
+    uint64_t result;
+    uint64_t exceptionType;
+
+    uint32_t pc;
+    uint32_t sideTableIndex;
+    uint32_t stackHeight;
+    uint32_t resultPending;
+
+    uint64_t* values() { return bitwise_cast<uint64_t*>(this + 1); }
+
+    static ptrdiff_t offsetOfInstance() { return OBJECT_OFFSETOF(InterpreterFrame, instance); }
+    static ptrdiff_t offsetOfFunction() { return OBJECT_OFFSETOF(InterpreterFrame, function); }
+    static ptrdiff_t offsetOfCallFrame() { return OBJECT_OFFSETOF(InterpreterFrame, callFrame); }
+    static ptrdiff_t offsetOfExitTarget() { return OBJECT_OFFSETOF(InterpreterFrame, exitTarget); }
+    static ptrdiff_t offsetOfExitTargetInstance() { return OBJECT_OFFSETOF(InterpreterFrame, exitTargetInstance); }
+    static ptrdiff_t offsetOfExitBuffer() { return OBJECT_OFFSETOF(InterpreterFrame, exitBuffer); }
+    static ptrdiff_t offsetOfResult() { return OBJECT_OFFSETOF(InterpreterFrame, result); }
+    static ptrdiff_t offsetOfExceptionType() { return OBJECT_OFFSETOF(InterpreterFrame, exceptionType); }
+    static ptrdiff_t offsetOfPC() { return OBJECT_OFFSETOF(InterpreterFrame, pc); }
+    static ptrdiff_t offsetOfSideTableIndex() { return OBJECT_OFFSETOF(InterpreterFrame, sideTableIndex); }
+    static ptrdiff_t offsetOfStackHeight() { return OBJECT_OFFSETOF(InterpreterFrame, stackHeight); }
+    static ptrdiff_t offsetOfResultPending() { return OBJECT_OFFSETOF(InterpreterFrame, resultPending); }
+};
+
+static_assert(!(sizeof(InterpreterFrame) % sizeof(uint64_t)), "The values following an InterpreterFrame must be 64-bit aligned");
+
+// Interprets the frame's function from where it last exited, or from its start if its pc is 0, until
+// the trampoline has to take over. Returns an InterpreterExit, plus the call signature slot for calls.
+uint32_t runInterpreter(InterpreterFrame*);
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
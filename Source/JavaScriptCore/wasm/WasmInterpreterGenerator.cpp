@@ -0,0 +1,606 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmInterpreterGenerator.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "AllowMacroScratchRegisterUsage.h"
+#include "CCallHelpers.h"
+#include "LinkBuffer.h"
+#include "WasmCallingConvention.h"
+#include "WasmContextInlines.h"
+#include "WasmFunctionParser.h"
+#include "WasmInstance.h"
+#include "WasmThunks.h"
+#include <wtf/LEBDecoder.h>
+
+namespace JSC { namespace Wasm {
+
+static uint32_t codeStartPC(const uint8_t* functionStart, size_t functionLength)
+{
+    // The parser has already validated the local declarations, so we only skip over them.
+    size_t offset = 0;
+    uint32_t localGroupCount;
+    bool success = WTF::LEBDecoder::decodeUInt32(functionStart, functionLength, offset, localGroupCount);
+    for (uint32_t i = 0; i < localGroupCount; ++i) {
+        uint32_t numberOfLocals;
+        success &= WTF::LEBDecoder::decodeUInt32(functionStart, functionLength, offset, numberOfLocals);
+        ++offset; // Type.
+    }
+    ASSERT_UNUSED(success, success);
+    return offset;
+}
+
+class InterpreterGenerator {
+public:
+    struct ControlData {
+        ControlData(BlockType type, Type signature, uint32_t stackHeight)
+            : blockType(type)
+            , signature(signature)
+            , stackHeight(stackHeight)
+        {
+        }
+
+        ControlData()
+        {
+        }
+
+        void dump(PrintStream& out) const
+        {
+            out.print(blockType == BlockType::TopLevel ? "TopLevel" : blockType == BlockType::Loop ? "Loop" : blockType == BlockType::If ? "If" : "Block", " at height ", stackHeight);
+        }
+
+        uint32_t branchArity() const { return blockType != BlockType::Loop && signature != Void; }
+
+        BlockType blockType;
+        Type signature;
+        // Height of the value stack when the block starts, which is where branches out of it leave their values.
+        uint32_t stackHeight { 0 };
+        uint32_t loopPC { 0 };
+        uint32_t loopSideTableIndex { 0 };
+        uint32_t ifSideTableIndex { 0 };
+        // Entries of branches to the end of this block, which we only know once we get there.
+        Vector<uint32_t> pendingBranches;
+    };
+
+    typedef String ErrorType;
+    typedef Unexpected<ErrorType> UnexpectedResult;
+    typedef Expected<void, ErrorType> Result;
+    // We only need to know the height of the value stack, not what is on it.
+    typedef bool ExpressionType;
+    typedef ControlData ControlType;
+    typedef Vector<ExpressionType, 1> ExpressionList;
+    typedef FunctionParser<InterpreterGenerator>::ControlEntry ControlEntry;
+
+    static const ExpressionType emptyExpression = false;
+
+    template <typename ...Args>
+    NEVER_INLINE UnexpectedResult WARN_UNUSED_RETURN fail(Args... args) const
+    {
+        using namespace FailureHelper; // See ADL comment in WasmParser.h.
+        return UnexpectedResult(makeString("WebAssembly.Module failed compiling: "_s, makeString(args)...));
+    }
+
+    InterpreterGenerator(InterpreterFunction& function, const uint8_t* functionStart, size_t functionLength)
+        : m_function(function)
+    {
+        m_function.m_codeStartPC = codeStartPC(functionStart, functionLength);
+    }
+
+    Result WARN_UNUSED_RETURN addArguments(const Signature& signature) { return addLocal(Void, signature.argumentCount()); }
+    Result WARN_UNUSED_RETURN addLocal(Type, uint32_t count)
+    {
+        if (UNLIKELY(count > maxFunctionLocals - m_function.m_numberOfLocals))
+            return fail("can't interpret a function with more than ", maxFunctionLocals, " locals");
+        m_function.m_numberOfLocals += count;
+        return { };
+    }
+    ExpressionType addConstant(Type, uint64_t)
+    {
+        didPush();
+        return true;
+    }
+
+    // Locals
+    Result WARN_UNUSED_RETURN getLocal(uint32_t, ExpressionType& result) { return push(result); }
+    Result WARN_UNUSED_RETURN setLocal(uint32_t, ExpressionType) { return { }; }
+
+    // Globals
+    Result WARN_UNUSED_RETURN getGlobal(uint32_t, ExpressionType& result) { return push(result); }
+    Result WARN_UNUSED_RETURN setGlobal(uint32_t, ExpressionType) { return { }; }
+
+    // Memory
+    Result WARN_UNUSED_RETURN load(LoadOpType, ExpressionType, ExpressionType& result, uint32_t) { return push(result); }
+    Result WARN_UNUSED_RETURN store(StoreOpType, ExpressionType, ExpressionType, uint32_t) { return { }; }
+
+    // Basic operators
+    template<OpType>
+    Result WARN_UNUSED_RETURN addOp(ExpressionType, ExpressionType& result) { return push(result); }
+    template<OpType>
+    Result WARN_UNUSED_RETURN addOp(ExpressionType, ExpressionType, ExpressionType& result) { return push(result); }
+    Result WARN_UNUSED_RETURN addSelect(ExpressionType, ExpressionType, ExpressionType, ExpressionType& result) { return push(result); }
+
+    // Control flow
+    ControlData WARN_UNUSED_RETURN addTopLevel(Type signature);
+    ControlData WARN_UNUSED_RETURN addBlock(Type signature);
+    ControlData WARN_UNUSED_RETURN addLoop(Type signature, const ExpressionList& enclosingStack, uint32_t loopIndex);
+    Result WARN_UNUSED_RETURN addIf(ExpressionType condition, Type signature, ControlData& result);
+    Result WARN_UNUSED_RETURN addElse(ControlData&, const ExpressionList&);
+    Result WARN_UNUSED_RETURN addElseToUnreachable(ControlData&);
+
+    Result WARN_UNUSED_RETURN addReturn(ControlData&, const ExpressionList&) { return { }; }
+    Result WARN_UNUSED_RETURN addBranch(ControlData&, ExpressionType condition, const ExpressionList& expressionStack);
+    Result WARN_UNUSED_RETURN addSwitch(ExpressionType condition, const Vector<ControlData*>& targets, ControlData& defaultTarget, const ExpressionList& expressionStack);
+    Result WARN_UNUSED_RETURN endBlock(ControlEntry&, ExpressionList& expressionStack);
+    Result WARN_UNUSED_RETURN addEndToUnreachable(ControlEntry&);
+    Result WARN_UNUSED_RETURN addGrowMemory(ExpressionType, ExpressionType& result) { return push(result); }
+    Result WARN_UNUSED_RETURN addCurrentMemory(ExpressionType& result) { return push(result); }
+    Result WARN_UNUSED_RETURN addMemoryCopy(ExpressionType, ExpressionType, ExpressionType) { return { }; }
+    Result WARN_UNUSED_RETURN addMemoryFill(ExpressionType, ExpressionType, ExpressionType) { return { }; }
+
+    Result WARN_UNUSED_RETURN addUnreachable() { return { }; }
+
+    // Calls
+    Result WARN_UNUSED_RETURN addCall(unsigned calleeIndex, const Signature&, const Vector<ExpressionType>& args, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addCallIndirect(const Signature&, const Vector<ExpressionType>& args, ExpressionType& result);
+
+    void dump(const Vector<ControlEntry>&, const ExpressionList*);
+    void setParser(FunctionParser<InterpreterGenerator>* parser) { m_parser = parser; }
+
+private:
+    uint32_t stackHeight() const
+    {
+        return m_parser->controlStack().last().controlData.stackHeight + m_parser->expressionStack().size();
+    }
+
+    void didPush()
+    {
+        m_function.m_maxStackHeight = std::max<uint32_t>(m_function.m_maxStackHeight, stackHeight() + 1);
+    }
+
+    Result WARN_UNUSED_RETURN push(ExpressionType& result)
+    {
+        didPush();
+        result = true;
+        return { };
+    }
+
+    uint32_t appendSideTableEntry()
+    {
+        m_function.m_sideTable.append(InterpreterSideTableEntry { });
+        return m_function.m_sideTable.size() - 1;
+    }
+
+    void appendBranch(ControlData&);
+    Result WARN_UNUSED_RETURN addCallSignature(const Signature&, ExpressionType& result);
+
+    FunctionParser<InterpreterGenerator>* m_parser { nullptr };
+    InterpreterFunction& m_function;
+};
+
+auto InterpreterGenerator::addTopLevel(Type signature) -> ControlData
+{
+    return ControlData(BlockType::TopLevel, signature, 0);
+}
+
+auto InterpreterGenerator::addBlock(Type signature) -> ControlData
+{
+    return ControlData(BlockType::Block, signature, stackHeight());
+}
+
+auto InterpreterGenerator::addLoop(Type signature, const ExpressionList& enclosingStack, uint32_t loopIndex) -> ControlData
+{
+    ControlData loop(BlockType::Loop, signature, m_parser->controlStack().last().controlData.stackHeight + enclosingStack.size());
+    // Back edges go to the loop instruction itself, so that it counts down towards tiering up each iteration.
+    loop.loopPC = m_parser->currentOpcodeStartingOffset();
+    loop.loopSideTableIndex = appendSideTableEntry();
+    m_function.m_sideTable[loop.loopSideTableIndex] = { loop.loopPC, loop.loopSideTableIndex, loop.stackHeight, 0, loopIndex };
+    return loop;
+}
+
+auto InterpreterGenerator::addIf(ExpressionType, Type signature, ControlData& result) -> Result
+{
+    result = ControlData(BlockType::If, signature, stackHeight());
+    result.ifSideTableIndex = appendSideTableEntry();
+    return { };
+}
+
+auto InterpreterGenerator::addElse(ControlData& data, const ExpressionList&) -> Result
+{
+    // Falling off the end of the then branch skips the else branch.
+    appendBranch(data);
+    return addElseToUnreachable(data);
+}
+
+auto InterpreterGenerator::addElseToUnreachable(ControlData& data) -> Result
+{
+    ASSERT(data.blockType == BlockType::If);
+    InterpreterSideTableEntry& entry = m_function.m_sideTable[data.ifSideTableIndex];
+    entry.targetPC = m_parser->currentOpcodeStartingOffset() + 1;
+    entry.targetSideTableIndex = m_function.m_sideTable.size();
+    entry.targetStackHeight = data.stackHeight;
+    entry.arity = 0;
+    data.blockType = BlockType::Block;
+    return { };
+}
+
+void InterpreterGenerator::appendBranch(ControlData& target)
+{
+    uint32_t index = appendSideTableEntry();
+    InterpreterSideTableEntry& entry = m_function.m_sideTable[index];
+    entry.targetStackHeight = target.stackHeight;
+    entry.arity = target.branchArity();
+    if (target.blockType == BlockType::Loop) {
+        entry.targetPC = target.loopPC;
+        entry.targetSideTableIndex = target.loopSideTableIndex;
+        return;
+    }
+    target.pendingBranches.append(index);
+}
+
+auto InterpreterGenerator::addBranch(ControlData& target, ExpressionType, const ExpressionList&) -> Result
+{
+    appendBranch(target);
+    return { };
+}
+
+auto InterpreterGenerator::addSwitch(ExpressionType, const Vector<ControlData*>& targets, ControlData& defaultTarget, const ExpressionList&) -> Result
+{
+    for (ControlData* target : targets)
+        appendBranch(*target);
+    appendBranch(defaultTarget);
+    return { };
+}
+
+auto InterpreterGenerator::endBlock(ControlEntry& entry, ExpressionList&) -> Result
+{
+    return addEndToUnreachable(entry);
+}
+
+auto InterpreterGenerator::addEndToUnreachable(ControlEntry& entry) -> Result
+{
+    ControlData& data = entry.controlData;
+    uint32_t endPC = m_parser->currentOpcodeStartingOffset();
+    uint32_t nextSideTableIndex = m_function.m_sideTable.size();
+
+    // Without an else, the if's entry goes straight to the end.
+    if (data.blockType == BlockType::If) {
+        InterpreterSideTableEntry& ifEntry = m_function.m_sideTable[data.ifSideTableIndex];
+        ifEntry.targetPC = endPC;
+        ifEntry.targetSideTableIndex = nextSideTableIndex;
+        ifEntry.targetStackHeight = data.stackHeight;
+        ifEntry.arity = 0;
+    }
+
+    for (uint32_t index : data.pendingBranches) {
+        m_function.m_sideTable[index].targetPC = endPC;
+        m_function.m_sideTable[index].targetSideTableIndex = nextSideTableIndex;
+    }
+
+    if (data.blockType == BlockType::TopLevel)
+        m_function.m_returnPC = endPC;
+
+    if (data.signature != Void)
+        entry.enclosedExpressionStack.append(true);
+    return { };
+}
+
+auto InterpreterGenerator::addCallSignature(const Signature& signature, ExpressionType& result) -> Result
+{
+    SignatureIndex signatureIndex = SignatureInformation::get(signature);
+    if (!m_function.m_callSignatures.contains(signatureIndex))
+        m_function.m_callSignatures.append(signatureIndex);
+    if (signature.returnType() != Void)
+        return push(result);
+    return { };
+}
+
+auto InterpreterGenerator::addCall(unsigned, const Signature& signature, const Vector<ExpressionType>&, ExpressionType& result) -> Result
+{
+    return addCallSignature(signature, result);
+}
+
+auto InterpreterGenerator::addCallIndirect(const Signature& signature, const Vector<ExpressionType>&, ExpressionType& result) -> Result
+{
+    return addCallSignature(signature, result);
+}
+
+void InterpreterGenerator::dump(const Vector<ControlEntry>& controlStack, const ExpressionList* expressionStack)
+{
+    for (size_t i = controlStack.size(); i--;) {
+        dataLogLn("  ", controlStack[i].controlData, " with ", expressionStack->size(), " values");
+        expressionStack = &controlStack[i].enclosedExpressionStack;
+    }
+    dataLogLn("  side table size: ", m_function.m_sideTable.size());
+}
+
+static void loadMemoryRegisters(CCallHelpers& jit, GPRReg instanceGPR)
+{
+    // Like the wasm to wasm import stub, load the size registers whatever our memory mode is, since a callee in
+    // another instance may need them.
+    const PinnedRegisterInfo& pinnedRegs = PinnedRegisterInfo::get();
+    const auto& sizeRegs = pinnedRegs.sizeRegisters;
+    ASSERT(!sizeRegs[0].sizeOffset);
+    jit.loadPtr(CCallHelpers::Address(instanceGPR, Instance::offsetOfCachedMemorySize()), sizeRegs[0].sizeRegister);
+    for (unsigned i = 1; i < sizeRegs.size(); ++i)
+        jit.add64(CCallHelpers::TrustedImm32(-sizeRegs[i].sizeOffset), sizeRegs[0].sizeRegister, sizeRegs[i].sizeRegister);
+    jit.loadPtr(CCallHelpers::Address(instanceGPR, Instance::offsetOfCachedMemory()), pinnedRegs.baseMemoryPointer);
+}
+
+// The trampoline keeps the InterpreterFrame, the locals and the value stack in its own stack frame and calls
+// runInterpreter() in a loop, doing whatever it asks for in between: returning, throwing, calling another
+// function with the wasm calling convention, or jumping to an OSR entry.
+static void emitTrampoline(CCallHelpers& jit, InternalFunction& result, const Signature& signature, InterpreterFunction& function, MemoryMode mode)
+{
+    AllowMacroScratchRegisterUsage allowScratch(jit);
+
+    const WasmCallingConvention& callingConvention = wasmCallingConvention();
+    const PinnedRegisterInfo& pinnedRegs = PinnedRegisterInfo::get();
+    GPRReg scratchGPR = GPRInfo::nonPreservedNonArgumentGPR0;
+    GPRReg otherScratchGPR = GPRInfo::nonPreservedNonArgumentGPR1;
+
+    // We only clobber callee saves by loading the memory registers. In signaling mode our callers expect
+    // the size registers to survive.
+    RegisterSet toSave;
+    if (mode == MemoryMode::Signaling) {
+        for (const PinnedSizeRegisterInfo& regInfo : pinnedRegs.sizeRegisters)
+            toSave.set(regInfo.sizeRegister);
+    }
+    RegisterAtOffsetList calleeSaveRegisters(toSave, RegisterAtOffsetList::OffsetBaseType::FramePointerBased);
+    result.entrypoint.calleeSaveRegisters = calleeSaveRegisters;
+
+    auto stackArgumentCount = [&] (const Signature& signature) {
+        unsigned gpArgumentCount = 0;
+        unsigned fpArgumentCount = 0;
+        for (unsigned i = 0; i < signature.argumentCount(); ++i) {
+            if (signature.argument(i) == F32 || signature.argument(i) == F64)
+                ++fpArgumentCount;
+            else
+                ++gpArgumentCount;
+        }
+        return (gpArgumentCount - std::min<unsigned>(gpArgumentCount, callingConvention.m_gprArgs.size()))
+            + (fpArgumentCount - std::min<unsigned>(fpArgumentCount, callingConvention.m_fprArgs.size()));
+    };
+
+    unsigned maxArgumentCount = 0;
+    unsigned maxStackArgumentCount = 0;
+    for (SignatureIndex signatureIndex : function.callSignatures()) {
+        const Signature& callSignature = SignatureInformation::get(signatureIndex);
+        maxArgumentCount = std::max<unsigned>(maxArgumentCount, callSignature.argumentCount());
+        maxStackArgumentCount = std::max(maxStackArgumentCount, stackArgumentCount(callSignature));
+    }
+
+    const int32_t stateOffset = -static_cast<int32_t>(calleeSaveRegisters.size() * sizeof(CPURegister) + sizeof(InterpreterFrame) + (function.numberOfLocals() + function.maxStackHeight()) * sizeof(uint64_t));
+    const unsigned outgoingArgumentAreaSize = WasmCallingConvention::headerSizeInBytes() - sizeof(CallerFrameAndPC) + maxStackArgumentCount * sizeof(uint64_t);
+    const unsigned frameSize = WTF::roundUpToMultipleOf(stackAlignmentBytes(), -stateOffset + outgoingArgumentAreaSize);
+    auto stateAddress = [&] (ptrdiff_t offset) {
+        return CCallHelpers::Address(GPRInfo::callFrameRegister, stateOffset + offset);
+    };
+
+    jit.emitFunctionPrologue();
+
+    // FIXME Stop using 0 as codeBlocks. https://bugs.webkit.org/show_bug.cgi?id=165321
+    jit.store64(CCallHelpers::TrustedImm64(0), CCallHelpers::Address(GPRInfo::callFrameRegister, CallFrameSlot::codeBlock * static_cast<int>(sizeof(Register))));
+    MacroAssembler::DataLabelPtr calleeMoveLocation = jit.moveWithPatch(MacroAssembler::TrustedImmPtr(nullptr), scratchGPR);
+    jit.storePtr(scratchGPR, CCallHelpers::Address(GPRInfo::callFrameRegister, CallFrameSlot::callee * static_cast<int>(sizeof(Register))));
+    CodeLocationDataLabelPtr<WasmEntryPtrTag>* linkedCalleeMove = &result.calleeMoveLocation;
+    jit.addLinkTask([=] (LinkBuffer& linkBuffer) {
+        *linkedCalleeMove = linkBuffer.locationOf<WasmEntryPtrTag>(calleeMoveLocation);
+    });
+
+    {
+        // Like B3 code that makes calls, also check for the frames of leaf callees and wasm to embedder stubs.
+        const unsigned minimumParentCheckSize = WTF::roundUpToMultipleOf(stackAlignmentBytes(), 1024);
+        const unsigned extraFrameSize = WTF::roundUpToMultipleOf(stackAlignmentBytes(), std::max<uint32_t>(minimumParentCheckSize, maxArgumentCount * sizeof(Register) + jscCallingConvention().headerSizeInBytes()));
+        const int32_t checkSize = frameSize + extraFrameSize;
+
+        jit.loadWasmContextInstance(otherScratchGPR);
+        jit.loadPtr(CCallHelpers::Address(otherScratchGPR, Instance::offsetOfCachedStackLimit()), otherScratchGPR);
+        jit.addPtr(CCallHelpers::TrustedImm32(-checkSize), GPRInfo::callFrameRegister, scratchGPR);
+        MacroAssembler::JumpList overflow;
+        if (UNLIKELY(static_cast<unsigned>(checkSize) > Options::reservedZoneSize()))
+            overflow.append(jit.branchPtr(CCallHelpers::Above, scratchGPR, GPRInfo::callFrameRegister));
+        overflow.append(jit.branchPtr(CCallHelpers::Below, scratchGPR, otherScratchGPR));
+        jit.addLinkTask([overflow] (LinkBuffer& linkBuffer) {
+            linkBuffer.link(overflow, CodeLocationLabel<JITThunkPtrTag>(Thunks::singleton().stub(throwStackOverflowFromWasmThunkGenerator).code()));
+        });
+    }
+
+    jit.addPtr(CCallHelpers::TrustedImm32(-static_cast<int32_t>(frameSize)), GPRInfo::callFrameRegister, MacroAssembler::stackPointerRegister);
+    jit.emitSave(calleeSaveRegisters);
+
+    // Arguments become the first locals.
+    {
+        size_t gpArgumentCount = 0;
+        size_t fpArgumentCount = 0;
+        size_t stackArgumentIndex = 0;
+        for (unsigned i = 0; i < signature.argumentCount(); ++i) {
+            CCallHelpers::Address local = stateAddress(sizeof(InterpreterFrame) + i * sizeof(uint64_t));
+            Type type = signature.argument(i);
+            bool isFP = type == F32 || type == F64;
+            if (!isFP && gpArgumentCount < callingConvention.m_gprArgs.size())
+                jit.store64(callingConvention.m_gprArgs[gpArgumentCount++].gpr(), local);
+            else if (isFP && fpArgumentCount < callingConvention.m_fprArgs.size()) {
+                FPRReg argumentFPR = callingConvention.m_fprArgs[fpArgumentCount++].fpr();
+                if (type == F32)
+                    jit.storeFloat(argumentFPR, local);
+                else
+                    jit.storeDouble(argumentFPR, local);
+            } else {
+                jit.load64(CCallHelpers::Address(GPRInfo::callFrameRegister, WasmCallingConvention::headerSizeInBytes() + stackArgumentIndex++ * sizeof(uint64_t)), scratchGPR);
+                jit.store64(scratchGPR, local);
+            }
+        }
+    }
+
+    jit.loadWasmContextInstance(scratchGPR);
+    jit.storePtr(scratchGPR, stateAddress(InterpreterFrame::offsetOfInstance()));
+    jit.move(CCallHelpers::TrustedImmPtr(&function), scratchGPR);
+    jit.storePtr(scratchGPR, stateAddress(InterpreterFrame::offsetOfFunction()));
+    jit.storePtr(GPRInfo::callFrameRegister, stateAddress(InterpreterFrame::offsetOfCallFrame()));
+    jit.store32(CCallHelpers::TrustedImm32(0), stateAddress(InterpreterFrame::offsetOfPC()));
+    jit.store32(CCallHelpers::TrustedImm32(0), stateAddress(InterpreterFrame::offsetOfResultPending()));
+
+    CCallHelpers::Label interpret = jit.label();
+    jit.addPtr(CCallHelpers::TrustedImm32(stateOffset), GPRInfo::callFrameRegister, GPRInfo::argumentGPR0);
+    jit.move(CCallHelpers::TrustedImmPtr(tagCFunctionPtr<OperationPtrTag>(runInterpreter)), scratchGPR);
+    jit.call(scratchGPR, OperationPtrTag);
+
+    CCallHelpers::Jump isTrap = jit.branch32(CCallHelpers::Equal, GPRInfo::returnValueGPR, CCallHelpers::TrustedImm32(static_cast<uint32_t>(InterpreterExit::Trap)));
+    CCallHelpers::Jump isOSREntry = jit.branch32(CCallHelpers::Equal, GPRInfo::returnValueGPR, CCallHelpers::TrustedImm32(static_cast<uint32_t>(InterpreterExit::OSREntry)));
+    CCallHelpers::JumpList calls;
+    for (uint32_t slot = 0; slot < function.callSignatures().size(); ++slot)
+        calls.append(jit.branch32(CCallHelpers::Equal, GPRInfo::returnValueGPR, CCallHelpers::TrustedImm32(static_cast<uint32_t>(InterpreterExit::Call) + slot)));
+
+    // Return.
+    jit.loadPtr(stateAddress(InterpreterFrame::offsetOfInstance()), scratchGPR);
+    loadMemoryRegisters(jit, scratchGPR);
+    switch (signature.returnType()) {
+    case I32:
+        jit.load32(stateAddress(InterpreterFrame::offsetOfResult()), GPRInfo::returnValueGPR);
+        break;
+    case I64:
+        jit.load64(stateAddress(InterpreterFrame::offsetOfResult()), GPRInfo::returnValueGPR);
+        break;
+    case F32:
+        jit.loadFloat(stateAddress(InterpreterFrame::offsetOfResult()), FPRInfo::returnValueFPR);
+        break;
+    case F64:
+        jit.loadDouble(stateAddress(InterpreterFrame::offsetOfResult()), FPRInfo::returnValueFPR);
+        break;
+    case Void:
+        break;
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+    jit.emitRestore(calleeSaveRegisters);
+    jit.emitFunctionEpilogue();
+    jit.ret();
+
+    isTrap.link(&jit);
+    jit.load32(stateAddress(InterpreterFrame::offsetOfExceptionType()), GPRInfo::argumentGPR1);
+    CCallHelpers::Jump jumpToExceptionStub = jit.jump();
+    jit.addLinkTask([jumpToExceptionStub] (LinkBuffer& linkBuffer) {
+        linkBuffer.link(jumpToExceptionStub, CodeLocationLabel<JITThunkPtrTag>(Thunks::singleton().stub(throwExceptionFromWasmThunkGenerator).code()));
+    });
+
+    // Tear down our frame as if we were returning, like BBQ code does. The OSR entry builds its own frame in
+    // its place and returns to our caller.
+    isOSREntry.link(&jit);
+    jit.loadPtr(stateAddress(InterpreterFrame::offsetOfInstance()), scratchGPR);
+    loadMemoryRegisters(jit, scratchGPR);
+    jit.loadPtr(stateAddress(InterpreterFrame::offsetOfExitBuffer()), GPRInfo::argumentGPR0);
+    jit.loadPtr(stateAddress(InterpreterFrame::offsetOfExitTarget()), GPRInfo::argumentGPR1);
+    jit.emitRestore(calleeSaveRegisters);
+    jit.emitFunctionEpilogue();
+    jit.jump(GPRInfo::argumentGPR1, WasmEntryPtrTag);
+
+    for (uint32_t slot = 0; slot < function.callSignatures().size(); ++slot) {
+        const Signature& callSignature = SignatureInformation::get(function.callSignatures()[slot]);
+        calls.jumps()[slot].link(&jit);
+
+        // Switch to the callee's instance, like the wasm to wasm import stub does.
+        jit.loadPtr(stateAddress(InterpreterFrame::offsetOfExitTargetInstance()), otherScratchGPR);
+        jit.loadPtr(stateAddress(InterpreterFrame::offsetOfInstance()), scratchGPR);
+        jit.loadPtr(CCallHelpers::Address(scratchGPR, Instance::offsetOfCachedStackLimit()), scratchGPR);
+        jit.storePtr(scratchGPR, CCallHelpers::Address(otherScratchGPR, Instance::offsetOfCachedStackLimit()));
+        jit.storeWasmContextInstance(otherScratchGPR);
+        loadMemoryRegisters(jit, otherScratchGPR);
+
+        jit.loadPtr(stateAddress(InterpreterFrame::offsetOfExitBuffer()), scratchGPR);
+        size_t gpArgumentCount = 0;
+        size_t fpArgumentCount = 0;
+        size_t stackArgumentIndex = 0;
+        for (unsigned i = 0; i < callSignature.argumentCount(); ++i) {
+            CCallHelpers::Address value(scratchGPR, i * sizeof(uint64_t));
+            Type type = callSignature.argument(i);
+            bool isFP = type == F32 || type == F64;
+            if (!isFP && gpArgumentCount < callingConvention.m_gprArgs.size())
+                jit.load64(value, callingConvention.m_gprArgs[gpArgumentCount++].gpr());
+            else if (isFP && fpArgumentCount < callingConvention.m_fprArgs.size()) {
+                FPRReg argumentFPR = callingConvention.m_fprArgs[fpArgumentCount++].fpr();
+                if (type == F32)
+                    jit.loadFloat(value, argumentFPR);
+                else
+                    jit.loadDouble(value, argumentFPR);
+            } else {
+                jit.load64(value, otherScratchGPR);
+                jit.store64(otherScratchGPR, CCallHelpers::Address(MacroAssembler::stackPointerRegister, WasmCallingConvention::headerSizeInBytes() - sizeof(CallerFrameAndPC) + stackArgumentIndex++ * sizeof(uint64_t)));
+            }
+        }
+
+        jit.loadPtr(stateAddress(InterpreterFrame::offsetOfExitTarget()), scratchGPR);
+        jit.call(scratchGPR, WasmEntryPtrTag);
+
+        switch (callSignature.returnType()) {
+        case I32:
+        case I64:
+            jit.store64(GPRInfo::returnValueGPR, stateAddress(InterpreterFrame::offsetOfResult()));
+            break;
+        case F32:
+            jit.storeFloat(FPRInfo::returnValueFPR, stateAddress(InterpreterFrame::offsetOfResult()));
+            break;
+        case F64:
+            jit.storeDouble(FPRInfo::returnValueFPR, stateAddress(InterpreterFrame::offsetOfResult()));
+            break;
+        case Void:
+            break;
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+
+        // The callee may have left its own instance as the context's, and its stack limit as the cached one.
+        jit.loadPtr(stateAddress(InterpreterFrame::offsetOfInstance()), scratchGPR);
+        jit.storeWasmContextInstance(scratchGPR);
+        jit.loadPtr(CCallHelpers::Address(scratchGPR, Instance::offsetOfPointerToActualStackLimit()), otherScratchGPR);
+        jit.loadPtr(CCallHelpers::Address(otherScratchGPR), otherScratchGPR);
+        jit.storePtr(otherScratchGPR, CCallHelpers::Address(scratchGPR, Instance::offsetOfCachedStackLimit()));
+        jit.jump().linkTo(interpret, &jit);
+    }
+}
+
+Expected<std::unique_ptr<InternalFunction>, String> generateInterpreterFunction(CompilationContext& compilationContext, const uint8_t* functionStart, size_t functionLength, const Signature& signature, const ModuleInformation& info, MemoryMode mode, InterpreterFunction& function, ThrowWasmException throwWasmException)
+{
+    auto result = std::make_unique<InternalFunction>();
+
+    compilationContext.embedderEntrypointJIT = std::make_unique<CCallHelpers>();
+    compilationContext.wasmEntrypointJIT = std::make_unique<CCallHelpers>();
+
+    if (throwWasmException)
+        Thunks::singleton().setThrowWasmException(throwWasmException);
+
+    InterpreterGenerator generator(function, functionStart, functionLength);
+    FunctionParser<InterpreterGenerator> parser(generator, functionStart, functionLength, signature, info);
+    WASM_FAIL_IF_HELPER_FAILS(parser.parse());
+
+    emitTrampoline(*compilationContext.wasmEntrypointJIT, *result, signature, function, mode);
+    return WTFMove(result);
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
@@ -29,6 +29,7 @@
 #if ENABLE(WEBASSEMBLY)
 
 #include "WasmBBQPlanInlines.h"
+#include "WasmModuleCache.h"
 #include "WasmModuleInformation.h"
 #include "WasmWorklist.h"
 
@@ -62,15 +63,45 @@ static Plan::CompletionTask makeValidationCallback(Module::AsyncValidationCallba
     });
 }
 
+static void addToModuleCache(const CString& cacheKey, size_t sourceSize, const Module::ValidationResult& result)
+{
+    if (cacheKey.isNull() || !result.has_value())
+        return;
+    ModuleCache::singleton().add(cacheKey, sourceSize, *result.value());
+}
+
 Module::ValidationResult Module::validateSync(Context* context, Vector<uint8_t>&& source)
 {
+    CString cacheKey;
+    size_t sourceSize = source.size();
+    if (Options::useWebAssemblyModuleCache()) {
+        cacheKey = ModuleCache::keyFor(source);
+        if (RefPtr<Module> module = ModuleCache::singleton().find(cacheKey))
+            return Module::ValidationResult(WTFMove(module));
+    }
+
     Ref<BBQPlan> plan = adoptRef(*new BBQPlan(context, WTFMove(source), BBQPlan::Validation, Plan::dontFinalize(), nullptr, nullptr));
     plan->parseAndValidateModule();
-    return makeValidationResult(plan.get());
+    auto result = makeValidationResult(plan.get());
+    addToModuleCache(cacheKey, sourceSize, result);
+    return result;
 }
 
 void Module::validateAsync(Context* context, Vector<uint8_t>&& source, Module::AsyncValidationCallback&& callback)
 {
+    if (Options::useWebAssemblyModuleCache()) {
+        CString cacheKey = ModuleCache::keyFor(source);
+        if (RefPtr<Module> module = ModuleCache::singleton().find(cacheKey)) {
+            callback->run(Module::ValidationResult(WTFMove(module)));
+            return;
+        }
+        size_t sourceSize = source.size();
+        callback = createSharedTask<CallbackType>([cacheKey = WTFMove(cacheKey), sourceSize, callback = WTFMove(callback)] (ValidationResult&& result) {
+            addToModuleCache(cacheKey, sourceSize, result);
+            callback->run(WTFMove(result));
+        });
+    }
+
     Ref<Plan> plan = adoptRef(*new BBQPlan(context, WTFMove(source), BBQPlan::Validation, makeValidationCallback(WTFMove(callback)), nullptr, nullptr));
     Wasm::ensureWorklist().enqueue(WTFMove(plan));
 }
@@ -57,6 +57,14 @@ public:
         return adoptRef(*new Module(WTFMove(moduleInformation)));
     }
 
+    // Streaming compilation has already compiled a CodeBlock by the time the module exists.
+    static Ref<Module> create(Ref<ModuleInformation>&& moduleInformation, Ref<CodeBlock>&& codeBlock)
+    {
+        Ref<Module> module = create(WTFMove(moduleInformation));
+        module->m_codeBlocks[static_cast<uint8_t>(codeBlock->mode())] = WTFMove(codeBlock);
+        return module;
+    }
+
     Wasm::SignatureIndex signatureIndexFromFunctionIndexSpace(unsigned functionIndexSpace) const;
     const Wasm::ModuleInformation& moduleInformation() const { return m_moduleInformation.get(); }
 
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmModuleCache.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "Options.h"
+#include "WasmModule.h"
+#include <mutex>
+#include <wtf/DataLog.h>
+#include <wtf/SHA1.h>
+
+namespace JSC { namespace Wasm {
+
+ModuleCache& ModuleCache::singleton()
+{
+    static ModuleCache* cache;
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] {
+        cache = new ModuleCache;
+    });
+    return *cache;
+}
+
+CString ModuleCache::keyFor(const Vector<uint8_t>& source)
+{
+    SHA1 hasher;
+    hasher.addBytes(source.data(), source.size());
+    return hasher.computeHexDigest();
+}
+
+RefPtr<Module> ModuleCache::find(const CString& key)
+{
+    auto locker = holdLock(m_lock);
+    auto iter = m_entries.find(key);
+    if (iter == m_entries.end()) {
+        ++m_misses;
+        if (Options::dumpWebAssemblyModuleCacheStatistics())
+            dataLogLn("WebAssembly module cache miss for ", key, " (", m_hits, " hits, ", m_misses, " misses).");
+        return nullptr;
+    }
+
+    ++m_hits;
+    if (Options::dumpWebAssemblyModuleCacheStatistics())
+        dataLogLn("WebAssembly module cache hit for ", key, " (", m_hits, " hits, ", m_misses, " misses).");
+    m_recentlyUsed.appendOrMoveToLast(key);
+    return iter->value.module;
+}
+
+void ModuleCache::add(const CString& key, size_t sourceSize, Module& module)
+{
+    auto locker = holdLock(m_lock);
+    if (sourceSize > Options::webAssemblyModuleCacheSize())
+        return;
+
+    if (m_entries.contains(key)) {
+        // Two compilations of the same bytes raced. Keep the module we already handed out.
+        m_recentlyUsed.appendOrMoveToLast(key);
+        return;
+    }
+
+    // CString's buffer is not thread safe ref counted, so the cache keeps its own copy, only ever touched with m_lock held.
+    CString ownedKey(key.data(), key.length());
+    m_entries.add(ownedKey, Entry { &module, sourceSize });
+    m_recentlyUsed.appendOrMoveToLast(ownedKey);
+    m_totalSourceSize += sourceSize;
+    evictIfNecessary(locker);
+}
+
+void ModuleCache::evictIfNecessary(const AbstractLocker&)
+{
+    while (m_totalSourceSize > Options::webAssemblyModuleCacheSize()) {
+        CString victim = m_recentlyUsed.takeFirst();
+        auto iter = m_entries.find(victim);
+        ASSERT(iter != m_entries.end());
+        m_totalSourceSize -= iter->value.sourceSize;
+        m_entries.remove(iter);
+    }
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
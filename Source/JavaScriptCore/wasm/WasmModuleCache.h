@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/Lock.h>
+#include <wtf/Vector.h>
+#include <wtf/text/CString.h>
+
+namespace JSC { namespace Wasm {
+
+class Module;
+
+// Process-wide cache of compiled modules, keyed by a hash of the module's bytes. Wasm::Module is
+// not tied to a VM, so a hit hands back the same Module and with it every CodeBlock (one per
+// MemoryMode) and every OMG callee it already has, instead of parsing and compiling the bytes again.
+// The cache is bounded by Options::webAssemblyModuleCacheSize bytes of module source, least
+// recently used modules being evicted first.
+class ModuleCache {
+    WTF_MAKE_NONCOPYABLE(ModuleCache);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    JS_EXPORT_PRIVATE static ModuleCache& singleton();
+
+    static CString keyFor(const Vector<uint8_t>& source);
+
+    RefPtr<Module> find(const CString& key);
+    void add(const CString& key, size_t sourceSize, Module&);
+
+    unsigned hits()
+    {
+        auto locker = holdLock(m_lock);
+        return m_hits;
+    }
+
+    unsigned misses()
+    {
+        auto locker = holdLock(m_lock);
+        return m_misses;
+    }
+
+private:
+    ModuleCache() = default;
+
+    void evictIfNecessary(const AbstractLocker&);
+
+    struct Entry {
+        RefPtr<Module> module;
+        size_t sourceSize { 0 };
+    };
+
+    Lock m_lock;
+    HashMap<CString, Entry> m_entries;
+    ListHashSet<CString> m_recentlyUsed;
+    size_t m_totalSourceSize { 0 };
+    unsigned m_hits { 0 };
+    unsigned m_misses { 0 };
+};
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
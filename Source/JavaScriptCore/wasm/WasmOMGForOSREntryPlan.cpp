@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmOMGForOSREntryPlan.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "B3Compilation.h"
+#include "B3OpaqueByproducts.h"
+#include "JSCInlines.h"
+#include "LinkBuffer.h"
+#include "ProbeContext.h"
+#include "WasmB3IRGenerator.h"
+#include "WasmCallee.h"
+#include "WasmContext.h"
+#include "WasmInstance.h"
+#include "WasmMachineThreads.h"
+#include "WasmMemory.h"
+#include "WasmNameSection.h"
+#include "WasmOMGPlan.h"
+#include "WasmOSREntryData.h"
+#include "WasmSignatureInlines.h"
+#include "WasmValidate.h"
+#include "WasmWorklist.h"
+#include <wtf/DataLog.h>
+#include <wtf/Locker.h>
+#include <wtf/StdLibExtras.h>
+
+namespace JSC { namespace Wasm {
+
+namespace WasmOMGForOSREntryPlanInternal {
+static const bool verbose = false;
+}
+
+OMGForOSREntryPlan::OMGForOSREntryPlan(Context* context, Ref<Module>&& module, uint32_t functionIndex, uint32_t loopIndex, MemoryMode mode, CompletionTask&& task)
+    : Base(context, makeRef(const_cast<ModuleInformation&>(module->moduleInformation())), WTFMove(task))
+    , m_module(WTFMove(module))
+    , m_codeBlock(*m_module->codeBlockFor(mode))
+    , m_functionIndex(functionIndex)
+    , m_loopIndex(loopIndex)
+{
+    setMode(mode);
+    ASSERT(m_codeBlock->runnable());
+    ASSERT(m_codeBlock.ptr() == m_module->codeBlockFor(m_mode));
+    dataLogLnIf(WasmOMGForOSREntryPlanInternal::verbose, "Starting OMG OSR entry plan for loop ", loopIndex, " of ", functionIndex, " of module: ", RawPointer(&m_module.get()));
+}
+
+void OMGForOSREntryPlan::work(CompilationEffort)
+{
+    ASSERT(m_codeBlock->runnable());
+    ASSERT(m_codeBlock.ptr() == m_module->codeBlockFor(mode()));
+    const FunctionData& function = m_moduleInformation->functions[m_functionIndex];
+
+    const uint32_t functionIndexSpace = m_functionIndex + m_module->moduleInformation().importFunctionCount();
+    ASSERT(functionIndexSpace < m_module->moduleInformation().functionIndexSpaceSize());
+
+    SignatureIndex signatureIndex = m_moduleInformation->internalFunctionSignatureIndices[m_functionIndex];
+    const Signature& signature = SignatureInformation::get(signatureIndex);
+    ASSERT(validateFunction(function.data.data(), function.data.size(), signature, m_moduleInformation.get()));
+
+    Vector<UnlinkedWasmToWasmCall> unlinkedCalls;
+    CompilationContext context;
+    auto parseAndCompileResult = parseAndCompile(context, function.data.data(), function.data.size(), signature, unlinkedCalls, m_moduleInformation.get(), m_mode, CompilationMode::OMGForOSREntryMode, m_functionIndex, m_loopIndex);
+
+    if (UNLIKELY(!parseAndCompileResult)) {
+        fail(holdLock(m_lock), makeString(parseAndCompileResult.error(), "when trying to compile an OSR entry for ", String::number(m_functionIndex)));
+        return;
+    }
+
+    Entrypoint omgEntrypoint;
+    LinkBuffer linkBuffer(*context.wasmEntrypointJIT, nullptr, JITCompilationCanFail);
+    if (UNLIKELY(linkBuffer.didFailToAllocate())) {
+        Base::fail(holdLock(m_lock), makeString("Out of executable memory while compiling an OSR entry for function at index ", String::number(m_functionIndex)));
+        return;
+    }
+
+    omgEntrypoint.compilation = std::make_unique<B3::Compilation>(
+        FINALIZE_CODE(linkBuffer, B3CompilationPtrTag, "WebAssembly OMGForOSREntry function[%i] loop[%i] %s", m_functionIndex, m_loopIndex, signature.toString().ascii().data()),
+        WTFMove(context.wasmEntrypointByproducts));
+
+    omgEntrypoint.calleeSaveRegisters = WTFMove(parseAndCompileResult.value()->entrypoint.calleeSaveRegisters);
+
+    Ref<Callee> callee = Callee::create(WTFMove(omgEntrypoint), functionIndexSpace, m_moduleInformation->nameSection->get(functionIndexSpace));
+    MacroAssembler::repatchPointer(parseAndCompileResult.value()->calleeMoveLocation, CalleeBits::boxWasm(callee.ptr()));
+
+    {
+        LockHolder holder(m_codeBlock->m_lock);
+        for (auto& call : unlinkedCalls) {
+            MacroAssemblerCodePtr<WasmEntryPtrTag> entrypoint;
+            if (call.functionIndexSpace < m_module->moduleInformation().importFunctionCount())
+                entrypoint = m_codeBlock->m_wasmToWasmExitStubs[call.functionIndexSpace].code();
+            else
+                entrypoint = m_codeBlock->wasmEntrypointCalleeFromFunctionIndexSpace(call.functionIndexSpace).entrypoint().retagged<WasmEntryPtrTag>();
+
+            MacroAssembler::repatchNearCall(call.callLocation, CodeLocationLabel<WasmEntryPtrTag>(entrypoint));
+        }
+    }
+
+    // Nothing can run this code before it is published below, but the BBQ frame that triggered us might be
+    // on another CPU.
+    resetInstructionCacheOnAllThreads();
+    WTF::storeStoreFence();
+
+    {
+        LockHolder holder(m_codeBlock->m_lock);
+        ASSERT(!m_codeBlock->m_osrEntryCallees[m_functionIndex]);
+        m_codeBlock->m_osrEntryCallees[m_functionIndex] = WTFMove(callee);
+
+        // Let later tier ups of our callees repatch our calls too. If this function itself finishes tiering up
+        // after this, OMGPlan drops these, which only means we keep calling the code we linked above.
+        m_codeBlock->m_wasmToWasmCallsites[m_functionIndex].appendVector(unlinkedCalls);
+    }
+
+    dataLogLnIf(WasmOMGForOSREntryPlanInternal::verbose, "Finished OMG OSR entry for loop ", m_loopIndex, " of ", m_functionIndex);
+    complete(holdLock(m_lock));
+}
+
+static uint64_t valueFromProbeContext(Probe::Context& context, const B3::ValueRep& valueRep)
+{
+    switch (valueRep.kind()) {
+    case B3::ValueRep::Register:
+        if (valueRep.isGPR())
+            return context.gpr(valueRep.gpr());
+        return bitwise_cast<uint64_t>(context.fpr(valueRep.fpr()));
+    case B3::ValueRep::Stack:
+        return *bitwise_cast<uint64_t*>(context.fp<uint8_t*>() + valueRep.offsetFromFP());
+    case B3::ValueRep::Constant:
+        return valueRep.value();
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+        return 0;
+    }
+}
+
+Callee* OMGForOSREntryPlan::osrEntryCalleeForLoop(Instance* instance, uint32_t functionIndex, uint32_t loopIndex)
+{
+    CodeBlock& codeBlock = *instance->codeBlock();
+    ASSERT(instance->memory()->mode() == codeBlock.mode());
+    TierUpCount& tierUp = codeBlock.tierUpCount(functionIndex);
+
+    if (tierUp.shouldStartOSREntryCompilation(loopIndex)) {
+        Ref<Plan> plan = adoptRef(*new OMGForOSREntryPlan(instance->context(), Ref<Wasm::Module>(instance->module()), functionIndex, loopIndex, codeBlock.mode(), Plan::dontFinalize()));
+        ensureWorklist().enqueue(plan.copyRef());
+        if (UNLIKELY(!Options::useConcurrentJIT()))
+            plan->waitForCompletion();
+    }
+
+    // Other loops of this function stay in BBQ code. Their countdown has wrapped around, so they stop asking.
+    if (tierUp.osrEntryLoopIndex() != loopIndex)
+        return nullptr;
+
+    Callee* osrEntryCallee = codeBlock.osrEntryCallee(functionIndex);
+    if (!osrEntryCallee) {
+        // Still compiling, or the compilation failed. Check again after a while.
+        tierUp.optimizeAfterWarmUp();
+        return nullptr;
+    }
+    return osrEntryCallee;
+}
+
+void OMGForOSREntryPlan::triggerOSREntryNow(Probe::Context& context)
+{
+    const OSREntryData& osrEntryData = *context.arg<OSREntryData*>();
+    uint32_t functionIndex = osrEntryData.functionIndex();
+    uint32_t loopIndex = osrEntryData.loopIndex();
+
+    // Unless we find an OSR entry for this loop, the BBQ code just keeps running it.
+    context.gpr(GPRInfo::argumentGPR0) = 0;
+
+    Instance* instance = bitwise_cast<Instance*>(valueFromProbeContext(context, osrEntryData.instance()));
+
+    // A hot loop is also a good reason for later calls to start in OMG code.
+    OMGPlan::runForIndex(instance, functionIndex);
+
+    Callee* osrEntryCallee = osrEntryCalleeForLoop(instance, functionIndex, loopIndex);
+    if (!osrEntryCallee)
+        return;
+
+    dataLogLnIf(WasmOMGForOSREntryPlanInternal::verbose, "OSR entering loop ", loopIndex, " of ", functionIndex);
+
+    const StackMap& values = osrEntryData.values();
+    uint64_t* buffer = instance->osrEntryScratchBuffer(values.size());
+    for (unsigned i = 0; i < values.size(); ++i)
+        buffer[i] = valueFromProbeContext(context, values[i]);
+
+    context.gpr(GPRInfo::argumentGPR0) = bitwise_cast<UCPURegister>(buffer);
+    context.gpr(GPRInfo::argumentGPR1) = bitwise_cast<UCPURegister>(osrEntryCallee->entrypoint().executableAddress());
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmContext.h"
+#include "WasmModule.h"
+#include "WasmPlan.h"
+
+namespace JSC {
+
+namespace Probe {
+class Context;
+}
+
+namespace Wasm {
+
+// Compiles an OMG version of a function that is entered in the middle of one of its loops, from the
+// BBQ code running that loop. Only the BBQ frame that triggered the compilation and later ones hitting
+// the same loop use this code; calls to the function still go through the regular OMGPlan.
+class OMGForOSREntryPlan final : public Plan {
+public:
+    using Base = Plan;
+
+    bool hasWork() const override { return !m_completed; }
+    void work(CompilationEffort) override;
+    bool multiThreaded() const override { return false; }
+
+    // Called through a probe from a BBQ loop header whose tier up countdown tripped. Sets argumentGPR0 to
+    // the scratch buffer and argumentGPR1 to the entrypoint if the loop should OSR enter now, and clears
+    // argumentGPR0 otherwise.
+    static void triggerOSREntryNow(Probe::Context&);
+
+    // Starts compiling for the loop if no other loop of the function got there first, and returns the
+    // OSR entry callee if it is ready for this loop. The interpreter also uses this for its loops.
+    static Callee* osrEntryCalleeForLoop(Instance*, uint32_t functionIndex, uint32_t loopIndex);
+
+private:
+    // For some reason friendship doesn't extend to parent classes...
+    using Base::m_lock;
+
+    // Note: CompletionTask should not hold a reference to the Plan otherwise there will be a reference cycle.
+    OMGForOSREntryPlan(Context*, Ref<Module>&&, uint32_t functionIndex, uint32_t loopIndex, MemoryMode, CompletionTask&&);
+
+    bool isComplete() const override { return m_completed; }
+    void complete(const AbstractLocker& locker) override
+    {
+        m_completed = true;
+        runCompletionTasks(locker);
+    }
+
+    Ref<Module> m_module;
+    Ref<CodeBlock> m_codeBlock;
+    bool m_completed { false };
+    uint32_t m_functionIndex;
+    uint32_t m_loopIndex;
+};
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
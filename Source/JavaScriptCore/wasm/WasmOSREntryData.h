@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "B3Type.h"
+#include "B3ValueRep.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace JSC { namespace Wasm {
+
+// Where a BBQ loop header keeps one of the values that an OMG entry into that loop needs,
+// along with the B3 type of the value. Every value is transferred as one 64-bit slot.
+class OSREntryValue : public B3::ValueRep {
+public:
+    OSREntryValue(const B3::ValueRep& valueRep, B3::Type type)
+        : B3::ValueRep(valueRep)
+        , m_type(type)
+    {
+    }
+
+    B3::Type type() const { return m_type; }
+
+private:
+    B3::Type m_type;
+};
+
+using StackMap = Vector<OSREntryValue>;
+
+// Describes the live state at a BBQ loop header: all locals (arguments included) in order,
+// followed by the enclosed expression stacks of the enclosing blocks, outermost first.
+// The OSR entry OMG compilation loads its buffer in the same order.
+class OSREntryData {
+    WTF_MAKE_NONCOPYABLE(OSREntryData);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    OSREntryData(uint32_t functionIndex, uint32_t loopIndex, B3::ValueRep instance, StackMap&& values)
+        : m_functionIndex(functionIndex)
+        , m_loopIndex(loopIndex)
+        , m_instance(instance)
+        , m_values(WTFMove(values))
+    {
+    }
+
+    uint32_t functionIndex() const { return m_functionIndex; }
+    uint32_t loopIndex() const { return m_loopIndex; }
+    const B3::ValueRep& instance() const { return m_instance; }
+    const StackMap& values() const { return m_values; }
+
+private:
+    uint32_t m_functionIndex;
+    uint32_t m_loopIndex;
+    B3::ValueRep m_instance;
+    StackMap m_values;
+};
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
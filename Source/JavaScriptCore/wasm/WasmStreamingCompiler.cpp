@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmStreamingCompiler.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmBBQPlan.h"
+#include "WasmStreamingParser.h"
+#include "WasmStreamingPlan.h"
+#include "WasmWorklist.h"
+
+namespace JSC { namespace Wasm {
+
+namespace WasmStreamingCompilerInternal {
+static const bool verbose = false;
+}
+
+class StreamingCompiler::ParserClient final : public StreamingParserClient {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    ParserClient(StreamingCompiler& compiler)
+        : m_compiler(compiler)
+    {
+    }
+
+    bool didReceiveFunctionData(unsigned functionIndex, const FunctionData&) override { return m_compiler.didReceiveFunctionData(functionIndex); }
+    // A module without any functions still needs a CodeBlock.
+    void didFinishParsing() override { m_compiler.startCompilationIfNecessary(); }
+
+private:
+    StreamingCompiler& m_compiler;
+};
+
+Ref<StreamingCompiler> StreamingCompiler::create(Context* context, Module::AsyncValidationCallback&& callback, CreateEmbedderWrapper&& createEmbedderWrapper, ThrowWasmException throwWasmException)
+{
+    return adoptRef(*new StreamingCompiler(context, WTFMove(callback), WTFMove(createEmbedderWrapper), throwWasmException));
+}
+
+StreamingCompiler::StreamingCompiler(Context* context, Module::AsyncValidationCallback&& callback, CreateEmbedderWrapper&& createEmbedderWrapper, ThrowWasmException throwWasmException)
+    : m_context(context)
+    , m_callback(WTFMove(callback))
+    , m_createEmbedderWrapper(WTFMove(createEmbedderWrapper))
+    , m_throwWasmException(throwWasmException)
+    , m_info(ModuleInformation::create())
+    , m_parserClient(std::make_unique<ParserClient>(*this))
+    , m_parser(std::make_unique<StreamingParser>(m_info.get(), *m_parserClient))
+{
+}
+
+StreamingCompiler::~StreamingCompiler()
+{
+    // Our StreamingPlans keep us alive, so nothing is compiling anymore. If nobody finalized us, make sure the plan
+    // still lets go of its CodeBlock.
+    if (m_plan)
+        m_plan->completeStreaming("WebAssembly streaming compilation was abandoned"_s);
+}
+
+void StreamingCompiler::addBytes(const uint8_t* bytes, size_t length)
+{
+    m_parser->addBytes(bytes, length);
+}
+
+static MemoryMode expectedMemoryMode(const ModuleInformation& info)
+{
+    // A module that defines its own memory gets a fast one whenever it can, see Memory::tryCreate(). We can't know
+    // what an imported memory will be, but bounds checking code is safe to run with either kind.
+    if (info.memory && !info.memory.isImport() && Options::useWebAssemblyFastMemory())
+        return MemoryMode::Signaling;
+    return MemoryMode::BoundsChecking;
+}
+
+void StreamingCompiler::startCompilationIfNecessary()
+{
+    if (m_plan)
+        return;
+
+    // Every section that prepare() needs comes before the code section, so we know everything but the function
+    // bodies by now.
+    MemoryMode mode = expectedMemoryMode(m_info.get());
+    dataLogLnIf(WasmStreamingCompilerInternal::verbose, "Starting streaming compilation of ", m_info->functions.size(), " functions in mode ", makeString(mode));
+    m_codeBlock = CodeBlock::createForStreaming(m_context, mode, m_info.get(), WTFMove(m_createEmbedderWrapper), m_throwWasmException);
+    m_plan = m_codeBlock->m_plan;
+    // If this fails, the plan has already completed and compileStreamedFunction() won't do anything.
+    m_plan->prepare();
+}
+
+bool StreamingCompiler::didReceiveFunctionData(uint32_t functionIndex)
+{
+    startCompilationIfNecessary();
+
+    {
+        auto locker = holdLock(m_lock);
+        ++m_pendingCompilationCount;
+    }
+
+    Ref<Plan> plan = adoptRef(*new StreamingPlan(m_context, m_info.copyRef(), makeRef(*m_plan), functionIndex, createSharedTask<Plan::CallbackType>([compiler = makeRef(*this)] (Plan&) {
+        compiler->didCompileFunction();
+    })));
+    ensureWorklist().enqueue(WTFMove(plan));
+    return true;
+}
+
+void StreamingCompiler::didCompileFunction()
+{
+    auto locker = holdLock(m_lock);
+    ASSERT(m_pendingCompilationCount);
+    --m_pendingCompilationCount;
+    completeIfNecessary(locker);
+}
+
+void StreamingCompiler::finalize()
+{
+    StreamingParser::State state = m_parser->finalize();
+
+    auto locker = holdLock(m_lock);
+    if (m_didFinalize)
+        return;
+    m_didFinalize = true;
+    if (state != StreamingParser::State::Finished)
+        m_errorMessage = m_parser->errorMessage().isolatedCopy();
+    completeIfNecessary(locker);
+}
+
+void StreamingCompiler::cancel()
+{
+    auto locker = holdLock(m_lock);
+    m_callback = nullptr;
+    if (m_didFinalize)
+        return;
+    m_didFinalize = true;
+    m_errorMessage = "WebAssembly streaming compilation was cancelled"_s;
+    completeIfNecessary(locker);
+}
+
+void StreamingCompiler::completeIfNecessary(const AbstractLocker&)
+{
+    if (!m_didFinalize || m_pendingCompilationCount || m_didComplete)
+        return;
+    m_didComplete = true;
+
+    Module::AsyncValidationCallback callback = WTFMove(m_callback);
+    if (!m_plan) {
+        // We failed before getting to the code section.
+        ASSERT(!m_errorMessage.isNull());
+        if (callback)
+            callback->run(Unexpected<String>(WTFMove(m_errorMessage)));
+        return;
+    }
+
+    // This runs the CodeBlock's completion task, so the CodeBlock is finished once it returns.
+    m_plan->completeStreaming(WTFMove(m_errorMessage));
+    ASSERT(m_codeBlock->compilationFinished());
+    if (!callback)
+        return;
+
+    if (!m_codeBlock->runnable()) {
+        callback->run(Unexpected<String>(m_codeBlock->errorMessage()));
+        return;
+    }
+    callback->run(Module::ValidationResult(Module::create(m_info.copyRef(), m_codeBlock.releaseNonNull())));
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmModule.h"
+#include <wtf/Lock.h>
+#include <wtf/ThreadSafeRefCounted.h>
+
+namespace JSC { namespace Wasm {
+
+class BBQPlan;
+class StreamingParser;
+struct ModuleInformation;
+
+// Compiles a module while its bytes are still arriving, e.g. from a network response. Each function goes to the
+// worklist as soon as its body has been parsed, so downloading and compiling overlap. Once everything is in, the
+// callback gets the module along with a CodeBlock compiled for the memory mode it will most likely be instantiated
+// with.
+class StreamingCompiler final : public ThreadSafeRefCounted<StreamingCompiler> {
+public:
+    static Ref<StreamingCompiler> create(Context*, Module::AsyncValidationCallback&&, CreateEmbedderWrapper&&, ThrowWasmException);
+    JS_EXPORT_PRIVATE ~StreamingCompiler();
+
+    JS_EXPORT_PRIVATE void addBytes(const uint8_t*, size_t);
+    // Called once there are no more bytes to add. The callback runs when the last function is done compiling.
+    JS_EXPORT_PRIVATE void finalize();
+    // Stops compiling without running the callback, e.g. because the download failed.
+    JS_EXPORT_PRIVATE void cancel();
+
+private:
+    class ParserClient;
+    friend class ParserClient;
+
+    StreamingCompiler(Context*, Module::AsyncValidationCallback&&, CreateEmbedderWrapper&&, ThrowWasmException);
+
+    void startCompilationIfNecessary();
+    bool didReceiveFunctionData(uint32_t functionIndex);
+    void didCompileFunction();
+    void completeIfNecessary(const AbstractLocker&);
+
+    Context* m_context;
+    Module::AsyncValidationCallback m_callback;
+    CreateEmbedderWrapper m_createEmbedderWrapper;
+    ThrowWasmException m_throwWasmException;
+    Ref<ModuleInformation> m_info;
+    std::unique_ptr<ParserClient> m_parserClient;
+    std::unique_ptr<StreamingParser> m_parser;
+    RefPtr<CodeBlock> m_codeBlock;
+    RefPtr<BBQPlan> m_plan;
+    String m_errorMessage;
+    unsigned m_pendingCompilationCount { 0 };
+    bool m_didFinalize { false };
+    bool m_didComplete { false };
+    Lock m_lock;
+};
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
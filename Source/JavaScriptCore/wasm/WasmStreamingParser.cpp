@@ -66,8 +66,9 @@ NEVER_INLINE auto WARN_UNUSED_RETURN StreamingParser::fail(Args... args) -> Stat
     return State::FatalError;
 }
 
-StreamingParser::StreamingParser(ModuleInformation& info)
+StreamingParser::StreamingParser(ModuleInformation& info, StreamingParserClient& client)
     : m_info(info)
+    , m_client(client)
 {
     dataLogLnIf(WasmStreamingParserInternal::verbose, "starting validation");
 }
@@ -137,6 +138,7 @@ auto StreamingParser::parseFunctionPayload(Vector<uint8_t>&& data) -> State
     function.end = m_offset + m_functionSize;
     function.data = WTFMove(data);
     dataLogLnIf(WasmStreamingParserInternal::verbose, "Processing function starting at: ", function.start, " and ending at: ", function.end);
+    WASM_PARSER_FAIL_IF(!m_client.didReceiveFunctionData(m_functionIndex, function), "can't compile function at index ", m_functionIndex);
     ++m_functionIndex;
     if (m_functionIndex == m_functionCount) {
         WASM_PARSER_FAIL_IF((m_codeOffset + m_sectionLength) != (m_offset + m_functionSize), "parsing ended before the end of ", m_section, " section");
@@ -380,6 +382,7 @@ auto StreamingParser::finalize() -> State
             if (UNLIKELY(Options::useEagerWebAssemblyModuleHashing()))
                 m_info->nameSection->setHash(m_hasher.computeHexDigest());
             m_state = State::Finished;
+            m_client.didFinishParsing();
         } else
             m_state = failOnState(State::SectionID);
         break;
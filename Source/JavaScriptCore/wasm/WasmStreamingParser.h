@@ -39,6 +39,14 @@
 namespace JSC { namespace Wasm {
 
 class StreamingParserClient {
+public:
+    virtual ~StreamingParserClient() = default;
+
+    // Called as soon as each function's payload has arrived, so clients can start compiling it before the rest
+    // of the module shows up. Returning false stops parsing.
+    virtual bool didReceiveFunctionData(unsigned, const FunctionData&) { return true; }
+    // Called once finalize() has successfully parsed the whole module.
+    virtual void didFinishParsing() { }
 };
 
 class StreamingParser {
@@ -69,7 +77,7 @@ public:
 
     enum class IsEndOfStream { Yes, No };
 
-    StreamingParser(ModuleInformation&);
+    StreamingParser(ModuleInformation&, StreamingParserClient&);
 
     State addBytes(const uint8_t* bytes, size_t length) { return addBytes(bytes, length, IsEndOfStream::No); }
     State finalize();
@@ -99,6 +107,7 @@ private:
     State failOnState(State);
 
     Ref<ModuleInformation> m_info;
+    StreamingParserClient& m_client;
     Vector<uint8_t> m_remaining;
     String m_errorMessage;
 
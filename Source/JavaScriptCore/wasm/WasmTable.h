@@ -50,6 +50,18 @@ public:
     void clearFunction(uint32_t);
     void setFunction(uint32_t, WasmToWasmImportableFunction, Instance*);
 
+    // Callers check the index against length() first, like call_indirect does.
+    const WasmToWasmImportableFunction& function(uint32_t index) const
+    {
+        ASSERT(index < m_length);
+        return m_importableFunctions.get()[index];
+    }
+    Instance* instance(uint32_t index) const
+    {
+        ASSERT(index < m_length);
+        return m_instances.get()[index];
+    }
+
     static ptrdiff_t offsetOfFunctions() { return OBJECT_OFFSETOF(Table, m_importableFunctions); }
     static ptrdiff_t offsetOfInstances() { return OBJECT_OFFSETOF(Table, m_instances); }
     static ptrdiff_t offsetOfLength() { return OBJECT_OFFSETOF(Table, m_length); }
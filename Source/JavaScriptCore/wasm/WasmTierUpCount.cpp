@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmTierUpCount.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmOSREntryData.h"
+
+namespace JSC { namespace Wasm {
+
+TierUpCount::TierUpCount()
+    : m_count(Options::webAssemblyOMGTierUpCount())
+    , m_tierUpStarted(false)
+    , m_osrEntryCompilationStarted(false)
+{
+}
+
+TierUpCount::TierUpCount(TierUpCount&& other)
+    : m_osrEntryData(WTFMove(other.m_osrEntryData))
+{
+    ASSERT(other.m_count == Options::webAssemblyOMGTierUpCount());
+    m_count = other.m_count;
+}
+
+TierUpCount::~TierUpCount() = default;
+
+OSREntryData& TierUpCount::addOSREntryData(uint32_t functionIndex, uint32_t loopIndex, const B3::ValueRep& instance, StackMap&& values)
+{
+    m_osrEntryData.append(std::make_unique<OSREntryData>(functionIndex, loopIndex, instance, WTFMove(values)));
+    return *m_osrEntryData.last();
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
@@ -30,28 +30,33 @@
 #include "Options.h"
 #include <wtf/Atomics.h>
 #include <wtf/StdLibExtras.h>
+#include <wtf/Vector.h>
 
-namespace JSC { namespace Wasm {
+namespace JSC {
+
+namespace B3 {
+class ValueRep;
+}
+
+namespace Wasm {
+
+class OSREntryData;
+class OSREntryValue;
 
 // This class manages the tier up counts for Wasm binaries. The main interesting thing about
 // wasm tiering up counts is that the least significant bit indicates if the tier up has already
 // started. Also, wasm code does not atomically update this count. This is because we
 // don't care too much if the countdown is slightly off. The tier up trigger is atomic, however,
 // so tier up will be triggered exactly once.
+//
+// Loop headers in BBQ code also record where they keep their live values, so that a long running
+// loop can OSR enter OMG code compiled for that loop. Only one loop per function gets such an entry.
 class TierUpCount {
     WTF_MAKE_NONCOPYABLE(TierUpCount);
 public:
-    TierUpCount()
-        : m_count(Options::webAssemblyOMGTierUpCount())
-        , m_tierUpStarted(false)
-    {
-    }
-
-    TierUpCount(TierUpCount&& other)
-    {
-        ASSERT(other.m_count == Options::webAssemblyOMGTierUpCount());
-        m_count = other.m_count;
-    }
+    TierUpCount();
+    TierUpCount(TierUpCount&&);
+    ~TierUpCount();
 
     static uint32_t loopDecrement() { return Options::webAssemblyLoopDecrement(); }
     static uint32_t functionEntryDecrement() { return Options::webAssemblyFunctionEntryDecrement(); }
@@ -63,9 +68,30 @@ public:
 
     int32_t count() { return bitwise_cast<int32_t>(m_count); }
 
+    // Lets the countdown trip again after another full warm up. Loops use this while their OSR
+    // entry is being compiled, so that they come back to check whether it is ready.
+    void optimizeAfterWarmUp() { m_count = Options::webAssemblyOMGTierUpCount(); }
+
+    // Called while generating BBQ code, before the code can run.
+    OSREntryData& addOSREntryData(uint32_t functionIndex, uint32_t loopIndex, const B3::ValueRep& instance, Vector<OSREntryValue>&&);
+
+    bool shouldStartOSREntryCompilation(uint32_t loopIndex)
+    {
+        if (m_osrEntryCompilationStarted.exchange(true))
+            return false;
+        m_osrEntryLoopIndex = loopIndex;
+        return true;
+    }
+
+    uint32_t osrEntryLoopIndex() const { return m_osrEntryLoopIndex; }
+
 private:
+    // BBQ code decrements this through the address of the TierUpCount, so it must come first.
     uint32_t m_count;
     Atomic<bool> m_tierUpStarted;
+    Atomic<bool> m_osrEntryCompilationStarted;
+    uint32_t m_osrEntryLoopIndex { UINT32_MAX };
+    Vector<std::unique_ptr<OSREntryData>> m_osrEntryData;
 };
     
 } } // namespace JSC::Wasm
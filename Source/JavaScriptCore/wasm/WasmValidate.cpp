@@ -122,7 +122,7 @@ public:
     // Control flow
     ControlData WARN_UNUSED_RETURN addTopLevel(Type signature);
     ControlData WARN_UNUSED_RETURN addBlock(Type signature);
-    ControlData WARN_UNUSED_RETURN addLoop(Type signature);
+    ControlData WARN_UNUSED_RETURN addLoop(Type signature, const ExpressionList& enclosingStack, uint32_t loopIndex);
     Result WARN_UNUSED_RETURN addIf(ExpressionType condition, Type signature, ControlData& result);
     Result WARN_UNUSED_RETURN addElse(ControlData&, const ExpressionList&);
     Result WARN_UNUSED_RETURN addElseToUnreachable(ControlData&);
@@ -134,6 +134,8 @@ public:
     Result WARN_UNUSED_RETURN addEndToUnreachable(ControlEntry&);
     Result WARN_UNUSED_RETURN addGrowMemory(ExpressionType delta, ExpressionType& result);
     Result WARN_UNUSED_RETURN addCurrentMemory(ExpressionType& result);
+    Result WARN_UNUSED_RETURN addMemoryCopy(ExpressionType destination, ExpressionType source, ExpressionType count);
+    Result WARN_UNUSED_RETURN addMemoryFill(ExpressionType destination, ExpressionType value, ExpressionType count);
 
     Result WARN_UNUSED_RETURN addUnreachable() { return { }; }
 
@@ -221,7 +223,7 @@ Validate::ControlType Validate::addBlock(Type signature)
     return ControlData(BlockType::Block, signature);
 }
 
-Validate::ControlType Validate::addLoop(Type signature)
+Validate::ControlType Validate::addLoop(Type signature, const ExpressionList&, uint32_t)
 {
     return ControlData(BlockType::Loop, signature);
 }
@@ -305,6 +307,22 @@ auto Validate::addCurrentMemory(ExpressionType& result) -> Result
     return { };
 }
 
+auto Validate::addMemoryCopy(ExpressionType destination, ExpressionType source, ExpressionType count) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(destination != I32, "memory.copy with non-i32 destination");
+    WASM_VALIDATOR_FAIL_IF(source != I32, "memory.copy with non-i32 source");
+    WASM_VALIDATOR_FAIL_IF(count != I32, "memory.copy with non-i32 count");
+    return { };
+}
+
+auto Validate::addMemoryFill(ExpressionType destination, ExpressionType value, ExpressionType count) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(destination != I32, "memory.fill with non-i32 destination");
+    WASM_VALIDATOR_FAIL_IF(value != I32, "memory.fill with non-i32 value");
+    WASM_VALIDATOR_FAIL_IF(count != I32, "memory.fill with non-i32 count");
+    return { };
+}
+
 auto Validate::endBlock(ControlEntry& entry, ExpressionList& stack) -> Result
 {
     WASM_FAIL_IF_HELPER_FAILS(unify(stack, entry.controlData));
@@ -236,6 +236,41 @@ enum class StoreOpType : uint8_t {
 
 #undef CREATE_ENUM_VALUE
 
+// Operations behind the Ext1 prefix are encoded as a varuint32 following the prefix byte.
+#define FOR_EACH_WASM_EXT1_OP(macro) \\
+    macro(MemoryCopy, 0x0a, "memory.copy") \\
+    macro(MemoryFill, 0x0b, "memory.fill")
+
+#define CREATE_ENUM_VALUE(name, id, wasmName) name = id,
+enum class Ext1OpType : uint8_t {
+    FOR_EACH_WASM_EXT1_OP(CREATE_ENUM_VALUE)
+};
+#undef CREATE_ENUM_VALUE
+
+template<typename Int>
+inline bool isValidExt1OpType(Int i)
+{
+    switch (i) {
+#define CREATE_CASE(name, id, wasmName) case id:
+    FOR_EACH_WASM_EXT1_OP(CREATE_CASE)
+#undef CREATE_CASE
+        return true;
+    default:
+        return false;
+    }
+}
+
+inline const char* makeString(Ext1OpType op)
+{
+    switch (op) {
+#define CREATE_CASE(name, id, wasmName) case Ext1OpType::name: return wasmName;
+    FOR_EACH_WASM_EXT1_OP(CREATE_CASE)
+#undef CREATE_CASE
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
 inline bool isControlOp(OpType op)
 {
     switch (op) {
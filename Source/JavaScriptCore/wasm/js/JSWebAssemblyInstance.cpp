@@ -137,6 +137,9 @@ void JSWebAssemblyInstance::finalizeCreation(VM& vm, ExecState* exec, Ref<Wasm::
         UNUSED_PARAM(startResult);
         RETURN_IF_EXCEPTION(scope, void());
     }
+
+    if (UNLIKELY(Options::reportStartupTimes()))
+        dataLog("Instantiated WebAssembly module in ", (MonotonicTime::now() - m_creationStartTime).milliseconds(), " ms.\n");
 }
 
 Identifier JSWebAssemblyInstance::createPrivateModuleKey()
@@ -146,6 +149,7 @@ Identifier JSWebAssemblyInstance::createPrivateModuleKey()
 
 JSWebAssemblyInstance* JSWebAssemblyInstance::create(VM& vm, ExecState* exec, const Identifier& moduleKey, JSWebAssemblyModule* jsModule, JSObject* importObject, Structure* instanceStructure, Ref<Wasm::Module>&& module, Wasm::CreationMode creationMode)
 {
+    MonotonicTime before = MonotonicTime::now();
     auto throwScope = DECLARE_THROW_SCOPE(vm);
     auto* globalObject = exec->lexicalGlobalObject();
 
@@ -177,6 +181,7 @@ JSWebAssemblyInstance* JSWebAssemblyInstance::create(VM& vm, ExecState* exec, co
         Wasm::Instance::create(&vm.wasmContext, WTFMove(module), &vm.topEntryFrame, vm.addressOfSoftStackLimit(), WTFMove(storeTopCallFrame)));
     jsInstance->finishCreation(vm, jsModule, moduleNamespace);
     RETURN_IF_EXCEPTION(throwScope, nullptr);
+    jsInstance->m_creationStartTime = before;
 
     // Let funcs, memories and tables be initially-empty lists of callable JavaScript objects, WebAssembly.Memory objects and WebAssembly.Table objects, respectively.
     // Let imports be an initially-empty list of external values.
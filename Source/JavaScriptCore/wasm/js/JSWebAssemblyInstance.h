@@ -35,6 +35,7 @@
 #include "JSWebAssemblyTable.h"
 #include "WasmCreationMode.h"
 #include "WasmInstance.h"
+#include <wtf/MonotonicTime.h>
 #include <wtf/Ref.h>
 
 namespace JSC {
@@ -81,6 +82,14 @@ public:
 
     JSWebAssemblyModule* module() const { return m_module.get(); }
 
+    // Startup time bookkeeping for Options::reportStartupTimes().
+    bool shouldReportFirstCall()
+    {
+        bool result = !m_hasReportedFirstCall;
+        m_hasReportedFirstCall = true;
+        return result;
+    }
+
     static size_t offsetOfPoisonedInstance() { return OBJECT_OFFSETOF(JSWebAssemblyInstance, m_instance); }
     static size_t offsetOfPoisonedCallee() { return OBJECT_OFFSETOF(JSWebAssemblyInstance, m_callee); }
 
@@ -102,6 +111,8 @@ private:
     PoisonedBarrier<JSWebAssemblyMemory> m_memory;
     PoisonedBarrier<JSWebAssemblyTable> m_table;
     PoisonedBarrier<WebAssemblyToJSCallee> m_callee;
+    MonotonicTime m_creationStartTime;
+    bool m_hasReportedFirstCall { false };
 };
 
 } // namespace JSC
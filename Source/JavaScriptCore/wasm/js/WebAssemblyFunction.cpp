@@ -128,7 +128,11 @@ static EncodedJSValue JSC_HOST_CALL callWebAssemblyFunction(ExecState* exec)
     vm.wasmContext.store(wasmInstance, vm.softStackLimit());
     ASSERT(wasmFunction->instance());
     ASSERT(&wasmFunction->instance()->instance() == vm.wasmContext.load());
+    bool reportFirstCall = UNLIKELY(Options::reportStartupTimes()) && instance->shouldReportFirstCall();
+    MonotonicTime before = reportFirstCall ? MonotonicTime::now() : MonotonicTime();
     EncodedJSValue rawResult = vmEntryToWasm(wasmFunction->jsEntrypoint(MustCheckArity).executableAddress(), &vm, &protoCallFrame);
+    if (reportFirstCall)
+        dataLog("First call into WebAssembly instance took ", (MonotonicTime::now() - before).milliseconds(), " ms.\n");
     // We need to make sure this is in a register or on the stack since it's stored in Vector<JSValue>.
     // This probably isn't strictly necessary, since the WebAssemblyFunction* should keep the instance
     // alive. But it's good hygiene.
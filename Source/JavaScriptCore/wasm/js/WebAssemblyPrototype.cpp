@@ -46,6 +46,7 @@
 #include "StrongInlines.h"
 #include "ThrowScope.h"
 #include "WasmBBQPlan.h"
+#include "WasmStreamingCompiler.h"
 #include "WasmToJS.h"
 #include "WasmWorklist.h"
 #include "WebAssemblyInstanceConstructor.h"
@@ -83,17 +84,9 @@ static void reject(ExecState* exec, CatchScope& catchScope, JSPromiseDeferred* p
     CLEAR_AND_RETURN_IF_EXCEPTION(catchScope, void());
 }
 
-static void webAssemblyModuleValidateAsyncInternal(ExecState* exec, JSPromiseDeferred* promise, Vector<uint8_t>&& source)
+static Wasm::Module::AsyncValidationCallback resolveWithModuleCallback(VM& vm, JSGlobalObject* globalObject, JSPromiseDeferred* promise)
 {
-    VM& vm = exec->vm();
-    auto* globalObject = exec->lexicalGlobalObject();
-
-    Vector<Strong<JSCell>> dependencies;
-    dependencies.append(Strong<JSCell>(vm, globalObject));
-
-    vm.promiseDeferredTimer->addPendingPromise(vm, promise, WTFMove(dependencies));
-
-    Wasm::Module::validateAsync(&vm.wasmContext, WTFMove(source), createSharedTask<Wasm::Module::CallbackType>([promise, globalObject, &vm] (Wasm::Module::ValidationResult&& result) mutable {
+    return createSharedTask<Wasm::Module::CallbackType>([promise, globalObject, &vm] (Wasm::Module::ValidationResult&& result) mutable {
         vm.promiseDeferredTimer->scheduleWorkSoon(promise, [promise, globalObject, result = WTFMove(result), &vm] () mutable {
             auto scope = DECLARE_CATCH_SCOPE(vm);
             ExecState* exec = globalObject->globalExec();
@@ -106,7 +99,20 @@ static void webAssemblyModuleValidateAsyncInternal(ExecState* exec, JSPromiseDef
             promise->resolve(exec, module);
             CLEAR_AND_RETURN_IF_EXCEPTION(scope, void());
         });
-    }));
+    });
+}
+
+static void webAssemblyModuleValidateAsyncInternal(ExecState* exec, JSPromiseDeferred* promise, Vector<uint8_t>&& source)
+{
+    VM& vm = exec->vm();
+    auto* globalObject = exec->lexicalGlobalObject();
+
+    Vector<Strong<JSCell>> dependencies;
+    dependencies.append(Strong<JSCell>(vm, globalObject));
+
+    vm.promiseDeferredTimer->addPendingPromise(vm, promise, WTFMove(dependencies));
+
+    Wasm::Module::validateAsync(&vm.wasmContext, WTFMove(source), resolveWithModuleCallback(vm, globalObject, promise));
 }
 
 static EncodedJSValue JSC_HOST_CALL webAssemblyCompileFunc(ExecState* exec)
@@ -223,17 +229,9 @@ JSValue WebAssemblyPrototype::instantiate(ExecState* exec, JSPromiseDeferred* pr
     return promise->promise();
 }
 
-static void webAssemblyModuleInstantinateAsyncInternal(ExecState* exec, JSPromiseDeferred* promise, Vector<uint8_t>&& source, JSObject* importObject)
+static Wasm::Module::AsyncValidationCallback instantiateCallback(VM& vm, JSGlobalObject* globalObject, JSPromiseDeferred* promise, JSObject* importObject)
 {
-    auto* globalObject = exec->lexicalGlobalObject();
-    VM& vm = exec->vm();
-
-    Vector<Strong<JSCell>> dependencies;
-    dependencies.append(Strong<JSCell>(vm, importObject));
-    dependencies.append(Strong<JSCell>(vm, globalObject));
-    vm.promiseDeferredTimer->addPendingPromise(vm, promise, WTFMove(dependencies));
-
-    Wasm::Module::validateAsync(&vm.wasmContext, WTFMove(source), createSharedTask<Wasm::Module::CallbackType>([promise, importObject, globalObject, &vm] (Wasm::Module::ValidationResult&& result) mutable {
+    return createSharedTask<Wasm::Module::CallbackType>([promise, importObject, globalObject, &vm] (Wasm::Module::ValidationResult&& result) mutable {
         vm.promiseDeferredTimer->scheduleWorkSoon(promise, [promise, importObject, globalObject, result = WTFMove(result), &vm] () mutable {
             auto scope = DECLARE_CATCH_SCOPE(vm);
             ExecState* exec = globalObject->globalExec();
@@ -244,7 +242,20 @@ static void webAssemblyModuleInstantinateAsyncInternal(ExecState* exec, JSPromis
             instantiate(vm, exec, promise, module, importObject, JSWebAssemblyInstance::createPrivateModuleKey(),  Resolve::WithModuleAndInstance, Wasm::CreationMode::FromJS);
             CLEAR_AND_RETURN_IF_EXCEPTION(scope, reject(exec, scope, promise));
         });
-    }));
+    });
+}
+
+static void webAssemblyModuleInstantinateAsyncInternal(ExecState* exec, JSPromiseDeferred* promise, Vector<uint8_t>&& source, JSObject* importObject)
+{
+    auto* globalObject = exec->lexicalGlobalObject();
+    VM& vm = exec->vm();
+
+    Vector<Strong<JSCell>> dependencies;
+    dependencies.append(Strong<JSCell>(vm, importObject));
+    dependencies.append(Strong<JSCell>(vm, globalObject));
+    vm.promiseDeferredTimer->addPendingPromise(vm, promise, WTFMove(dependencies));
+
+    Wasm::Module::validateAsync(&vm.wasmContext, WTFMove(source), instantiateCallback(vm, globalObject, promise, importObject));
 }
 
 void WebAssemblyPrototype::webAssemblyModuleInstantinateAsync(ExecState* exec, JSPromiseDeferred* promise, Vector<uint8_t>&& source, JSObject* importedObject)
@@ -255,6 +266,31 @@ void WebAssemblyPrototype::webAssemblyModuleInstantinateAsync(ExecState* exec, J
     CLEAR_AND_RETURN_IF_EXCEPTION(catchScope, void());
 }
 
+Ref<Wasm::StreamingCompiler> WebAssemblyPrototype::webAssemblyModuleCompileStreaming(ExecState* exec, JSPromiseDeferred* promise)
+{
+    VM& vm = exec->vm();
+    auto* globalObject = exec->lexicalGlobalObject();
+
+    Vector<Strong<JSCell>> dependencies;
+    dependencies.append(Strong<JSCell>(vm, globalObject));
+    vm.promiseDeferredTimer->addPendingPromise(vm, promise, WTFMove(dependencies));
+
+    return Wasm::StreamingCompiler::create(&vm.wasmContext, resolveWithModuleCallback(vm, globalObject, promise), &Wasm::createJSToWasmWrapper, &Wasm::wasmToJSException);
+}
+
+Ref<Wasm::StreamingCompiler> WebAssemblyPrototype::webAssemblyModuleInstantiateStreaming(ExecState* exec, JSPromiseDeferred* promise, JSObject* importObject)
+{
+    VM& vm = exec->vm();
+    auto* globalObject = exec->lexicalGlobalObject();
+
+    Vector<Strong<JSCell>> dependencies;
+    dependencies.append(Strong<JSCell>(vm, importObject));
+    dependencies.append(Strong<JSCell>(vm, globalObject));
+    vm.promiseDeferredTimer->addPendingPromise(vm, promise, WTFMove(dependencies));
+
+    return Wasm::StreamingCompiler::create(&vm.wasmContext, instantiateCallback(vm, globalObject, promise, importObject), &Wasm::createJSToWasmWrapper, &Wasm::wasmToJSException);
+}
+
 static EncodedJSValue JSC_HOST_CALL webAssemblyInstantiateFunc(ExecState* exec)
 {
     VM& vm = exec->vm();
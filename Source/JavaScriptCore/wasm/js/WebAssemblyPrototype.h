@@ -33,6 +33,12 @@
 
 namespace JSC {
 
+class JSPromiseDeferred;
+
+namespace Wasm {
+class StreamingCompiler;
+}
+
 class WebAssemblyPrototype final : public JSNonFinalObject {
 public:
     typedef JSNonFinalObject Base;
@@ -42,6 +48,10 @@ public:
     static Structure* createStructure(VM&, JSGlobalObject*, JSValue);
     JS_EXPORT_PRIVATE static void webAssemblyModuleValidateAsync(ExecState*, JSPromiseDeferred*, Vector<uint8_t>&&);
     JS_EXPORT_PRIVATE static void webAssemblyModuleInstantinateAsync(ExecState*, JSPromiseDeferred*, Vector<uint8_t>&&, JSObject*);
+    // For embedders that get the module's bytes in chunks. They add each chunk to the returned compiler as it arrives
+    // and finalize it at the end, and the promise settles once compilation is done.
+    JS_EXPORT_PRIVATE static Ref<Wasm::StreamingCompiler> webAssemblyModuleCompileStreaming(ExecState*, JSPromiseDeferred*);
+    JS_EXPORT_PRIVATE static Ref<Wasm::StreamingCompiler> webAssemblyModuleInstantiateStreaming(ExecState*, JSPromiseDeferred*, JSObject*);
 
     DECLARE_INFO;
 
@@ -41,6 +41,19 @@ using namespace WTF;
 
 namespace JSC { namespace Yarr {
 
+static inline size_t findCharacter(const LChar* characters, unsigned length, UChar character, unsigned index)
+{
+    if (character & ~0xFF || index >= length)
+        return notFound;
+    auto* found = static_cast<const LChar*>(memchr(characters + index, character, length - index));
+    return found ? found - characters : notFound;
+}
+
+static inline size_t findCharacter(const UChar* characters, unsigned length, UChar character, unsigned index)
+{
+    return find(characters, length, character, index);
+}
+
 template<typename CharType>
 class Interpreter {
 public:
@@ -300,6 +313,32 @@ public:
             return (((pos + offset) <= length) && ((pos + offset) >= pos));
         }
 
+        // Moves forwards to the first position from which the literal occurs offset characters
+        // on, returning false if there is no such position.
+        bool skipToLiteral(const Vector<UChar>& literal, unsigned offset)
+        {
+            ASSERT(!literal.isEmpty());
+            unsigned literalLength = literal.size();
+            if (length < literalLength || length - literalLength < offset)
+                return false;
+
+            const CharType* literalInput = input + offset;
+            unsigned candidateEnd = length - literalLength - offset + 1;
+            for (size_t candidate = pos; ; ++candidate) {
+                candidate = findCharacter(literalInput, candidateEnd, literal[0], candidate);
+                if (candidate == notFound)
+                    return false;
+
+                unsigned i = 1;
+                while (i < literalLength && literalInput[candidate + i] == literal[i])
+                    ++i;
+                if (i == literalLength) {
+                    pos = candidate;
+                    return true;
+                }
+            }
+        }
+
     private:
         const CharType* input;
         unsigned pos;
@@ -1278,6 +1317,11 @@ public:
             return JSRegExpMatch;
 
         case ByteTerm::TypeBodyAlternativeBegin:
+            if (!pattern->m_requiredLiteral.isEmpty()) {
+                if (!input.skipToLiteral(pattern->m_requiredLiteral, pattern->m_requiredLiteralOffset))
+                    return JSRegExpNoMatch;
+                context->matchBegin = input.getPos();
+            }
             MATCH_NEXT();
         case ByteTerm::TypeBodyAlternativeDisjunction:
         case ByteTerm::TypeBodyAlternativeEnd:
@@ -1486,6 +1530,9 @@ public:
 
             input.next();
 
+            if (!pattern->m_requiredLiteral.isEmpty() && !input.skipToLiteral(pattern->m_requiredLiteral, pattern->m_requiredLiteralOffset))
+                return JSRegExpNoMatch;
+
             context->matchBegin = input.getPos();
 
             if (currentTerm().alternative.onceThrough)
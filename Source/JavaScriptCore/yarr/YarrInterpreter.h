@@ -349,6 +349,8 @@ public:
         , m_flags(pattern.m_flags)
         , m_allocator(allocator)
         , m_lock(lock)
+        , m_requiredLiteral(pattern.m_requiredLiteral)
+        , m_requiredLiteralOffset(pattern.m_requiredLiteralOffset)
     {
         m_body->terms.shrinkToFit();
 
@@ -383,6 +385,9 @@ public:
     CharacterClass* newlineCharacterClass;
     CharacterClass* wordcharCharacterClass;
 
+    Vector<UChar> m_requiredLiteral;
+    unsigned m_requiredLiteralOffset;
+
 private:
     Vector<std::unique_ptr<ByteDisjunction>> m_allParenthesesInfo;
     Vector<std::unique_ptr<CharacterClass>> m_userCharacterClasses;
@@ -177,6 +177,9 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
         uint32_t begin;
         uint32_t matchAmount;
         uintptr_t returnAddress;
+        // Where the last iteration matched before this context was saved began, which
+        // backtracking into that iteration needs for its empty match checks.
+        uintptr_t lastIterationBegin;
         struct Subpatterns {
             unsigned start;
             unsigned end;
@@ -208,6 +211,11 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
             return offsetof(ParenContext, returnAddress);
         }
 
+        static ptrdiff_t lastIterationBeginOffset()
+        {
+            return offsetof(ParenContext, lastIterationBegin);
+        }
+
         static ptrdiff_t subpatternOffset(size_t subpattern)
         {
             return offsetof(ParenContext, subpatterns) + (subpattern - 1) * sizeof(Subpatterns);
@@ -269,6 +277,8 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
     void saveParenContext(RegisterID parenContextReg, RegisterID tempReg, unsigned firstSubpattern, unsigned lastSubpattern, unsigned subpatternBaseFrameLocation)
     {
         store32(index, Address(parenContextReg, ParenContext::beginOffset()));
+        loadFromFrame(subpatternBaseFrameLocation + BackTrackInfoParentheses::beginIndex(), tempReg);
+        storePtr(tempReg, Address(parenContextReg, ParenContext::lastIterationBeginOffset()));
         loadFromFrame(subpatternBaseFrameLocation + BackTrackInfoParentheses::matchAmountIndex(), tempReg);
         store32(tempReg, Address(parenContextReg, ParenContext::matchAmountOffset()));
         loadFromFrame(subpatternBaseFrameLocation + BackTrackInfoParentheses::returnAddressIndex(), tempReg);
@@ -290,7 +300,8 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
     void restoreParenContext(RegisterID parenContextReg, RegisterID tempReg, unsigned firstSubpattern, unsigned lastSubpattern, unsigned subpatternBaseFrameLocation)
     {
         load32(Address(parenContextReg, ParenContext::beginOffset()), index);
-        storeToFrame(index, subpatternBaseFrameLocation + BackTrackInfoParentheses::beginIndex());
+        loadPtr(Address(parenContextReg, ParenContext::lastIterationBeginOffset()), tempReg);
+        storeToFrame(tempReg, subpatternBaseFrameLocation + BackTrackInfoParentheses::beginIndex());
         load32(Address(parenContextReg, ParenContext::matchAmountOffset()), tempReg);
         storeToFrame(tempReg, subpatternBaseFrameLocation + BackTrackInfoParentheses::matchAmountIndex());
         loadPtr(Address(parenContextReg, ParenContext::returnAddressOffset()), tempReg);
@@ -590,7 +601,24 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
 
         return branch32(NotEqual, character, Imm32(ch));
     }
-    
+
+    // Branches to notCandidate unless the pattern's required literal may occur at its offset from
+    // the match start, where index has been advanced by the minimum size of the body alternative.
+    // Only the first and last characters of the literal are compared; matching checks the rest.
+    void jumpIfNotRequiredLiteralCandidate(unsigned minimumSize, JumpList& notCandidate)
+    {
+        const Vector<UChar>& literal = m_pattern.m_requiredLiteral;
+        unsigned firstCharacterOffset = minimumSize - m_pattern.m_requiredLiteralOffset;
+        const RegisterID character = regT0;
+
+        readCharacterDontDecodeSurrogates(firstCharacterOffset, character);
+        notCandidate.append(branch32(NotEqual, character, Imm32(literal[0])));
+        if (literal.size() > 1) {
+            readCharacterDontDecodeSurrogates(firstCharacterOffset - (literal.size() - 1), character);
+            notCandidate.append(branch32(NotEqual, character, Imm32(literal.last())));
+        }
+    }
+
     void storeToFrame(RegisterID reg, unsigned frameLocation)
     {
         poke(reg, frameLocation);
@@ -834,6 +862,10 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
         // characters but matched.
         Jump m_zeroLengthMatch;
 
+        // Used by OpParenthesesSubpatternEnd to mark where backtracking enters the
+        // last iteration of the subpattern.
+        Label m_backtrackReentry;
+
         // This flag is used to null out the second pattern character, when
         // two are fused to match a pair together.
         bool m_isDeadCode;
@@ -971,6 +1003,41 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
     // Generation methods:
     // ===================
 
+    // Advances the input position over start positions at which the required literal cannot
+    // occur, jumping to op.m_jumps if the end of the input is reached first.
+    void generateRequiredLiteralScan(YarrOp& op)
+    {
+        unsigned minimumSize = op.m_alternative->m_minimumSize;
+
+        JumpList notCandidate;
+        jumpIfNotRequiredLiteralCandidate(minimumSize, notCandidate);
+        Jump isCandidate = jump();
+
+        notCandidate.link(this);
+        Label scanLoop(this);
+        add32(TrustedImm32(1), index);
+        op.m_jumps.append(jumpIfNoAvailableInput());
+        JumpList stillNotCandidate;
+        jumpIfNotRequiredLiteralCandidate(minimumSize, stillNotCandidate);
+        stillNotCandidate.linkTo(scanLoop, this);
+
+        if (!m_pattern.m_body->m_hasFixedSize) {
+            move(index, regT0);
+            if (minimumSize)
+                sub32(Imm32(minimumSize), regT0);
+            setMatchStart(regT0);
+        }
+
+        isCandidate.link(this);
+    }
+
+    // Only parentheses matched exactly once have their minimum size checked up front, as part of
+    // the enclosing alternative; repeated generic parentheses check each iteration as they go.
+    static bool minimumSizeIsCheckedByEnclosingAlternative(PatternTerm* term)
+    {
+        return term->type != PatternTerm::TypeParentheticalAssertion && term->quantityType == QuantifierFixedCount && term->quantityMaxCount == 1;
+    }
+
     // This method provides a default implementation of backtracking common
     // to many terms; terms commonly jump out of the forwards  matching path
     // on any failed conditions, and add these jumps to the m_jumps list. If
@@ -1253,37 +1320,30 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
         }
 
         case QuantifierNonGreedy: {
-            JumpList incompleteMatches;
-
             matches.append(jump());
 
+            // Backtracking enters here to match one more copy of the subpattern. Failing to do so
+            // fails the whole term, which the backtracking code handles via op.m_jumps.
             op.m_reentry = label();
 
             load32(Address(output, (subpatternId << 1) * sizeof(int)), patternIndex);
             load32(Address(output, ((subpatternId << 1) + 1) * sizeof(int)), patternTemp);
 
-            // An empty match is successful without consuming characters
-            Jump zeroLengthMatch = branch32(Equal, TrustedImm32(-1), patternIndex);
-            Jump tryNonZeroMatch = branch32(NotEqual, patternIndex, patternTemp);
-            zeroLengthMatch.link(this);
-            storeToFrame(TrustedImm32(1), parenthesesFrameLocation + BackTrackInfoBackReference::matchAmountIndex());
-            matches.append(jump());
-            tryNonZeroMatch.link(this);
+            // Another copy of an empty match would not consume anything, which is rejected.
+            op.m_jumps.append(branch32(Equal, TrustedImm32(-1), patternIndex));
+            op.m_jumps.append(branch32(Equal, patternIndex, patternTemp));
 
             // Check if we have input remaining to match
             sub32(patternIndex, patternTemp);
             if (m_checkedOffset - term->inputPosition)
                 sub32(Imm32((m_checkedOffset - term->inputPosition).unsafeGet()), patternTemp);
-            matches.append(checkNotEnoughInput(patternTemp));
-
-            storeToFrame(index, parenthesesFrameLocation + BackTrackInfoBackReference::beginIndex());
-
-            matchBackreference(opIndex, incompleteMatches, characterOrTemp, patternIndex, patternTemp);
+            op.m_jumps.append(checkNotEnoughInput(patternTemp));
 
-            matches.append(jump());
+            matchBackreference(opIndex, op.m_jumps, characterOrTemp, patternIndex, patternTemp);
 
-            incompleteMatches.link(this);
-            loadFromFrame(parenthesesFrameLocation + BackTrackInfoBackReference::beginIndex(), index);
+            loadFromFrame(parenthesesFrameLocation + BackTrackInfoBackReference::matchAmountIndex(), characterOrTemp);
+            add32(TrustedImm32(1), characterOrTemp);
+            storeToFrame(characterOrTemp, parenthesesFrameLocation + BackTrackInfoBackReference::matchAmountIndex());
 
             matches.link(this);
             break;
@@ -1298,7 +1358,8 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
         unsigned subpatternId = term->backReferenceSubpatternId;
 
         m_backtrackingState.link(this);
-        op.m_jumps.link(this);
+        if (term->quantityType != QuantifierNonGreedy)
+            op.m_jumps.link(this);
 
         JumpList failures;
 
@@ -1330,12 +1391,15 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
         case QuantifierNonGreedy: {
             const RegisterID matchAmount = regT0;
 
-            loadFromFrame(parenthesesFrameLocation + BackTrackInfoBackReference::matchAmountIndex(), matchAmount);
-            if (term->quantityMaxCount != quantifyInfinite)
-                failures.append(branch32(AboveOrEqual, Imm32(term->quantityMaxCount.unsafeGet()), matchAmount));
-            add32(TrustedImm32(1), matchAmount);
-            storeToFrame(matchAmount, parenthesesFrameLocation + BackTrackInfoBackReference::matchAmountIndex());
+            if (term->quantityMaxCount != quantifyInfinite) {
+                loadFromFrame(parenthesesFrameLocation + BackTrackInfoBackReference::matchAmountIndex(), matchAmount);
+                op.m_jumps.append(branch32(AboveOrEqual, matchAmount, Imm32(term->quantityMaxCount.unsafeGet())));
+            }
             jump(op.m_reentry);
+
+            // No further copy could be matched, so restore the index from before the first one.
+            op.m_jumps.link(this);
+            loadFromFrame(parenthesesFrameLocation + BackTrackInfoBackReference::beginIndex(), index);
             break;
         }
         }
@@ -1874,6 +1938,8 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
             storeToFrame(countRegister, term->frameLocation + BackTrackInfoCharacterClass::matchAmountIndex());
 
             Label rematchLoop(this);
+            Jump doneRematching = branchTest32(Zero, countRegister);
+
             readCharacter(m_checkedOffset - term->inputPosition, character);
 
             sub32(TrustedImm32(1), countRegister);
@@ -1885,7 +1951,8 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
             isBMPChar.link(this);
 #endif
 
-            branchTest32(Zero, countRegister).linkTo(rematchLoop, this);
+            jump(rematchLoop);
+            doneRematching.link(this);
 
             loadFromFrame(term->frameLocation + BackTrackInfoCharacterClass::matchAmountIndex(), countRegister);
         }
@@ -2092,7 +2159,7 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
             break;
 
         case PatternTerm::TypeForwardReference:
-            m_failureReason = JITFailureReason::ForwardReference;
+            // A reference to a group that has not matched yet always matches the empty string.
             break;
 
         case PatternTerm::TypeParenthesesSubpattern:
@@ -2164,7 +2231,7 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
             break;
 
         case PatternTerm::TypeForwardReference:
-            m_failureReason = JITFailureReason::ForwardReference;
+            backtrackTermDefault(opIndex);
             break;
 
         case PatternTerm::TypeParenthesesSubpattern:
@@ -2234,6 +2301,15 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
                 // set as appropriate to this alternative.
                 op.m_reentry = label();
 
+                // The required literal is only found for expressions with a single looping
+                // alternative, so this is also where we loop back to after a failed match.
+                const Vector<UChar>& requiredLiteral = m_pattern.m_requiredLiteral;
+                if (!requiredLiteral.isEmpty()) {
+                    ASSERT(m_ops[op.m_nextOp].m_op == OpBodyAlternativeEnd);
+                    ASSERT(m_pattern.m_requiredLiteralOffset + requiredLiteral.size() <= alternative->m_minimumSize);
+                    generateRequiredLiteralScan(op);
+                }
+
                 m_checkedOffset += alternative->m_minimumSize;
                 break;
             }
@@ -2316,7 +2392,7 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
 
                 // Calculate how much input we need to check for, and if non-zero check.
                 op.m_checkAdjust = Checked<unsigned>(alternative->m_minimumSize);
-                if ((term->quantityType == QuantifierFixedCount) && (term->type != PatternTerm::TypeParentheticalAssertion))
+                if (minimumSizeIsCheckedByEnclosingAlternative(term))
                     op.m_checkAdjust -= disjunction->m_minimumSize;
                 if (op.m_checkAdjust)
                     op.m_jumps.append(jumpIfNoAvailableInput(op.m_checkAdjust.unsafeGet()));
@@ -2363,7 +2439,7 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
 
                 // Calculate how much input we need to check for, and if non-zero check.
                 op.m_checkAdjust = alternative->m_minimumSize;
-                if ((term->quantityType == QuantifierFixedCount) && (term->type != PatternTerm::TypeParentheticalAssertion))
+                if (minimumSizeIsCheckedByEnclosingAlternative(term))
                     op.m_checkAdjust -= disjunction->m_minimumSize;
                 if (op.m_checkAdjust)
                     op.m_jumps.append(jumpIfNoAvailableInput(op.m_checkAdjust.unsafeGet()));
@@ -2553,27 +2629,28 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
                 // to reenter the subpattern later, with a store to set 'begin' to current index
                 // on the second iteration.
                 //
+                // Fixed count parentheses are matched like Greedy ones that may not give up
+                // iterations below their minimum count.
+                //
                 // FIXME: for capturing parens, could use the index in the capture array?
-                if (term->quantityType == QuantifierGreedy || term->quantityType == QuantifierNonGreedy) {
-                    storeToFrame(TrustedImm32(0), parenthesesFrameLocation + BackTrackInfoParentheses::matchAmountIndex());
-                    storeToFrame(TrustedImmPtr(nullptr), parenthesesFrameLocation + BackTrackInfoParentheses::parenContextHeadIndex());
+                storeToFrame(TrustedImm32(0), parenthesesFrameLocation + BackTrackInfoParentheses::matchAmountIndex());
+                storeToFrame(TrustedImmPtr(nullptr), parenthesesFrameLocation + BackTrackInfoParentheses::parenContextHeadIndex());
 
-                    if (term->quantityType == QuantifierNonGreedy) {
-                        storeToFrame(TrustedImm32(-1), parenthesesFrameLocation + BackTrackInfoParentheses::beginIndex());
-                        op.m_jumps.append(jump());
-                    }
-                    
-                    op.m_reentry = label();
-                    RegisterID currParenContextReg = regT0;
-                    RegisterID newParenContextReg = regT1;
-
-                    loadFromFrame(parenthesesFrameLocation + BackTrackInfoParentheses::parenContextHeadIndex(), currParenContextReg);
-                    allocateParenContext(newParenContextReg);
-                    storePtr(currParenContextReg, newParenContextReg);
-                    storeToFrame(newParenContextReg, parenthesesFrameLocation + BackTrackInfoParentheses::parenContextHeadIndex());
-                    saveParenContext(newParenContextReg, regT2, term->parentheses.subpatternId, term->parentheses.lastSubpatternId, parenthesesFrameLocation);
-                    storeToFrame(index, parenthesesFrameLocation + BackTrackInfoParentheses::beginIndex());
+                if (term->quantityType == QuantifierNonGreedy) {
+                    storeToFrame(TrustedImm32(-1), parenthesesFrameLocation + BackTrackInfoParentheses::beginIndex());
+                    op.m_jumps.append(jump());
                 }
+                
+                op.m_reentry = label();
+                RegisterID currParenContextReg = regT0;
+                RegisterID newParenContextReg = regT1;
+
+                loadFromFrame(parenthesesFrameLocation + BackTrackInfoParentheses::parenContextHeadIndex(), currParenContextReg);
+                allocateParenContext(newParenContextReg);
+                storePtr(currParenContextReg, newParenContextReg);
+                storeToFrame(newParenContextReg, parenthesesFrameLocation + BackTrackInfoParentheses::parenContextHeadIndex());
+                saveParenContext(newParenContextReg, regT2, term->parentheses.subpatternId, term->parentheses.lastSubpatternId, parenthesesFrameLocation);
+                storeToFrame(index, parenthesesFrameLocation + BackTrackInfoParentheses::beginIndex());
 
                 // If the parenthese are capturing, store the starting index value to the
                 // captures array, offsetting as necessary.
@@ -2584,8 +2661,6 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
                 if (term->capture() && compileMode == IncludeSubpatterns) {
                     const RegisterID indexTemporary = regT0;
                     unsigned inputOffset = (m_checkedOffset - term->inputPosition).unsafeGet();
-                    if (term->quantityType == QuantifierFixedCount)
-                        inputOffset += term->parentheses.disjunction->m_minimumSize;
                     if (inputOffset) {
                         move(index, indexTemporary);
                         sub32(Imm32(inputOffset), indexTemporary);
@@ -2637,10 +2712,10 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
                         setSubpatternEnd(index, term->parentheses.subpatternId);
                 }
 
-                // If the parentheses are quantified Greedy then add a label to jump back
-                // to if we get a failed match from after the parentheses. For NonGreedy
-                // parentheses, link the jump from before the subpattern to here.
-                if (term->quantityType == QuantifierGreedy) {
+                // If the parentheses are quantified Greedy or with a fixed count then add a
+                // label to jump back to if we get a failed match from after the parentheses.
+                // For NonGreedy parentheses, link the jump from before the subpattern to here.
+                if (term->quantityType != QuantifierNonGreedy) {
                     if (term->quantityMaxCount != quantifyInfinite)
                         branch32(Below, countTemporary, Imm32(term->quantityMaxCount.unsafeGet())).linkTo(beginOp.m_reentry, this);
                     else
@@ -3208,31 +3283,43 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
 #if ENABLE(YARR_JIT_ALL_PARENS_EXPRESSIONS)
                 PatternTerm* term = op.m_term;
                 unsigned parenthesesFrameLocation = term->frameLocation;
+                unsigned minimumCount = term->quantityMinCount.unsafeGet();
 
-                if (term->quantityType != QuantifierFixedCount) {
-                    m_backtrackingState.link(this);
+                m_backtrackingState.link(this);
 
-                    RegisterID currParenContextReg = regT0;
-                    RegisterID newParenContextReg = regT1;
+                RegisterID currParenContextReg = regT0;
+                RegisterID newParenContextReg = regT1;
 
-                    loadFromFrame(parenthesesFrameLocation + BackTrackInfoParentheses::parenContextHeadIndex(), currParenContextReg);
-                    
-                    restoreParenContext(currParenContextReg, regT2, term->parentheses.subpatternId, term->parentheses.lastSubpatternId, parenthesesFrameLocation);
-                    
-                    freeParenContext(currParenContextReg, newParenContextReg);
-                    storeToFrame(newParenContextReg, parenthesesFrameLocation + BackTrackInfoParentheses::parenContextHeadIndex());
+                loadFromFrame(parenthesesFrameLocation + BackTrackInfoParentheses::parenContextHeadIndex(), currParenContextReg);
+
+                restoreParenContext(currParenContextReg, regT2, term->parentheses.subpatternId, term->parentheses.lastSubpatternId, parenthesesFrameLocation);
+
+                freeParenContext(currParenContextReg, newParenContextReg);
+                storeToFrame(newParenContextReg, parenthesesFrameLocation + BackTrackInfoParentheses::parenContextHeadIndex());
+
+                const RegisterID countTemporary = regT0;
+                loadFromFrame(parenthesesFrameLocation + BackTrackInfoParentheses::matchAmountIndex(), countTemporary);
+                Jump zeroLengthMatch = branchTest32(Zero, countTemporary);
 
-                    const RegisterID countTemporary = regT0;
-                    loadFromFrame(parenthesesFrameLocation + BackTrackInfoParentheses::matchAmountIndex(), countTemporary);
-                    Jump zeroLengthMatch = branchTest32(Zero, countTemporary);
+                sub32(TrustedImm32(1), countTemporary);
+                storeToFrame(countTemporary, parenthesesFrameLocation + BackTrackInfoParentheses::matchAmountIndex());
 
-                    sub32(TrustedImm32(1), countTemporary);
-                    storeToFrame(countTemporary, parenthesesFrameLocation + BackTrackInfoParentheses::matchAmountIndex());
+                if (term->quantityType == QuantifierNonGreedy) {
+                    // NonGreedy parentheses only tried another iteration after continuing
+                    // past the previous one failed, so backtrack into that iteration.
+                    jump(m_ops[op.m_nextOp].m_backtrackReentry);
+                } else {
+                    // Without the minimum number of iterations matched we can't continue after
+                    // the parentheses, so backtrack into the last iteration that did match.
+                    if (minimumCount > 1)
+                        branch32(Below, countTemporary, Imm32(minimumCount - 1)).linkTo(m_ops[op.m_nextOp].m_backtrackReentry, this);
 
                     jump(m_ops[op.m_nextOp].m_reentry);
+                }
 
-                    zeroLengthMatch.link(this);
+                zeroLengthMatch.link(this);
 
+                if (!minimumCount) {
                     // Clear the flag in the stackframe indicating we didn't run through the subpattern.
                     storeToFrame(TrustedImm32(-1), parenthesesFrameLocation + BackTrackInfoParentheses::beginIndex());
 
@@ -3245,9 +3332,9 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
                         // will jump back to here.
                         op.m_jumps.link(this);
                     }
-
-                    m_backtrackingState.fallthrough();
                 }
+
+                m_backtrackingState.fallthrough();
 #else // !YARR_JIT_ALL_PARENS_EXPRESSIONS
                 RELEASE_ASSERT_NOT_REACHED();
 #endif
@@ -3257,51 +3344,51 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
 #if ENABLE(YARR_JIT_ALL_PARENS_EXPRESSIONS)
                 PatternTerm* term = op.m_term;
 
-                if (term->quantityType != QuantifierFixedCount) {
-                    m_backtrackingState.link(this);
-
-                    unsigned parenthesesFrameLocation = term->frameLocation;
-
-                    if (term->quantityType == QuantifierGreedy) {
-                        // Check whether we should backtrack back into the parentheses, or if we
-                        // are currently in a state where we had skipped over the subpattern
-                        // (in which case the flag value on the stack will be -1).
-                        Jump hadSkipped = branch32(Equal, Address(stackPointerRegister, (parenthesesFrameLocation  + BackTrackInfoParentheses::beginIndex()) * sizeof(void*)), TrustedImm32(-1));
+                m_backtrackingState.link(this);
 
-                        // For Greedy parentheses, we skip after having already tried going
-                        // through the subpattern, so if we get here we're done.
-                        YarrOp& beginOp = m_ops[op.m_previousOp];
-                        beginOp.m_jumps.append(hadSkipped);
-                    } else {
-                        // For NonGreedy parentheses, we try skipping the subpattern first,
-                        // so if we get here we need to try running through the subpattern
-                        // next. Jump back to the start of the parentheses in the forwards
-                        // matching path.
-                        ASSERT(term->quantityType == QuantifierNonGreedy);
+                unsigned parenthesesFrameLocation = term->frameLocation;
 
-                        const RegisterID beginTemporary = regT0;
-                        const RegisterID countTemporary = regT1;
+                if (term->quantityType == QuantifierGreedy && !term->quantityMinCount) {
+                    // Check whether we should backtrack back into the parentheses, or if we
+                    // are currently in a state where we had skipped over the subpattern
+                    // (in which case the flag value on the stack will be -1).
+                    Jump hadSkipped = branch32(Equal, Address(stackPointerRegister, (parenthesesFrameLocation  + BackTrackInfoParentheses::beginIndex()) * sizeof(void*)), TrustedImm32(-1));
 
-                        YarrOp& beginOp = m_ops[op.m_previousOp];
+                    // For Greedy parentheses, we skip after having already tried going
+                    // through the subpattern, so if we get here we're done.
+                    YarrOp& beginOp = m_ops[op.m_previousOp];
+                    beginOp.m_jumps.append(hadSkipped);
+                } else if (term->quantityType == QuantifierNonGreedy) {
+                    // For NonGreedy parentheses, we try skipping the subpattern first,
+                    // so if we get here we need to try running through the subpattern
+                    // next. Jump back to the start of the parentheses in the forwards
+                    // matching path.
 
-                        loadFromFrame(parenthesesFrameLocation + BackTrackInfoParentheses::beginIndex(), beginTemporary);
-                        branch32(Equal, beginTemporary, TrustedImm32(-1)).linkTo(beginOp.m_reentry, this);
+                    const RegisterID beginTemporary = regT0;
+                    const RegisterID countTemporary = regT1;
 
-                        JumpList exceededMatchLimit;
+                    YarrOp& beginOp = m_ops[op.m_previousOp];
 
-                        if (term->quantityMaxCount != quantifyInfinite) {
-                            loadFromFrame(parenthesesFrameLocation + BackTrackInfoParentheses::matchAmountIndex(), countTemporary);
-                            exceededMatchLimit.append(branch32(AboveOrEqual, countTemporary, Imm32(term->quantityMaxCount.unsafeGet())));
-                        }
+                    loadFromFrame(parenthesesFrameLocation + BackTrackInfoParentheses::beginIndex(), beginTemporary);
+                    branch32(Equal, beginTemporary, TrustedImm32(-1)).linkTo(beginOp.m_reentry, this);
 
-                        branch32(Above, index, beginTemporary).linkTo(beginOp.m_reentry, this);
+                    JumpList exceededMatchLimit;
 
-                        exceededMatchLimit.link(this);
+                    if (term->quantityMaxCount != quantifyInfinite) {
+                        loadFromFrame(parenthesesFrameLocation + BackTrackInfoParentheses::matchAmountIndex(), countTemporary);
+                        exceededMatchLimit.append(branch32(AboveOrEqual, countTemporary, Imm32(term->quantityMaxCount.unsafeGet())));
                     }
 
-                    m_backtrackingState.fallthrough();
+                    branch32(Above, index, beginTemporary).linkTo(beginOp.m_reentry, this);
+
+                    exceededMatchLimit.link(this);
                 }
 
+                // Parentheses that have to match a minimum number of iterations were never
+                // skipped, so backtracking always continues into the last iteration.
+                op.m_backtrackReentry = label();
+                m_backtrackingState.fallthrough();
+
                 m_backtrackingState.append(op.m_jumps);
 #else // !YARR_JIT_ALL_PARENS_EXPRESSIONS
                 RELEASE_ASSERT_NOT_REACHED();
@@ -3370,7 +3457,7 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
     // the parentheses.
     // Supported types of parentheses are 'Once' (quantityMaxCount == 1),
     // 'Terminal' (non-capturing parentheses quantified as greedy
-    // and infinite), and 0 based greedy / non-greedy quantified parentheses.
+    // and infinite), fixed count and greedy / non-greedy quantified parentheses.
     // Alternatives will use the 'Simple' set of ops if either the
     // subpattern is terminal (in which case we will never need to
     // backtrack), or if the subpattern only contains one alternative.
@@ -3389,7 +3476,12 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
         // comes where the subpattern is capturing, in which case we would
         // need to restore the capture from the first subpattern upon a
         // failure in the second.
-        if (term->quantityMinCount && term->quantityMinCount != term->quantityMaxCount) {
+        // Once a pattern has copied subpatterns, further ranges are left
+        // unexpanded. The generic Greedy nodes handle those with a non-zero
+        // minimum, provided every iteration consumes input: the empty match
+        // check they make is only valid for iterations beyond the minimum.
+        if (term->quantityMinCount && term->quantityMinCount != term->quantityMaxCount
+            && (term->quantityType != QuantifierGreedy || !term->parentheses.disjunction->m_minimumSize)) {
             m_failureReason = JITFailureReason::VariableCountedParenthesisWithNonZeroMinimum;
             return;
         }
@@ -3411,13 +3503,6 @@ class YarrGenerator : public YarrJITInfo, private MacroAssembler {
             parenthesesEndOpCode = OpParenthesesSubpatternTerminalEnd;
         } else {
 #if ENABLE(YARR_JIT_ALL_PARENS_EXPRESSIONS)
-            // We only handle generic parenthesis with non-fixed counts.
-            if (term->quantityType == QuantifierFixedCount) {
-                // This subpattern is not supported by the JIT.
-                m_failureReason = JITFailureReason::FixedCountParenthesizedSubpattern;
-                return;
-            }
-
             m_containsNestedSubpatterns = true;
 
             // Select the 'Generic' nodes.
@@ -4184,18 +4269,12 @@ static void dumpCompileFailure(JITFailureReason failure)
     case JITFailureReason::BackReference:
         dataLog("Can't JIT some patterns containing back references\n");
         break;
-    case JITFailureReason::ForwardReference:
-        dataLog("Can't JIT a pattern containing forward references\n");
-        break;
     case JITFailureReason::VariableCountedParenthesisWithNonZeroMinimum:
         dataLog("Can't JIT a pattern containing a variable counted parenthesis with a non-zero minimum\n");
         break;
     case JITFailureReason::ParenthesizedSubpattern:
         dataLog("Can't JIT a pattern containing parenthesized subpatterns\n");
         break;
-    case JITFailureReason::FixedCountParenthesizedSubpattern:
-        dataLog("Can't JIT a pattern containing fixed count parenthesized subpatterns\n");
-        break;
     case JITFailureReason::ExecutableMemoryAllocationFailure:
         dataLog("Can't JIT because of failure of allocation of executable memory\n");
         break;
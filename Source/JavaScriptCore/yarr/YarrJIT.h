@@ -52,10 +52,8 @@ namespace Yarr {
 enum class JITFailureReason : uint8_t {
     DecodeSurrogatePair,
     BackReference,
-    ForwardReference,
     VariableCountedParenthesisWithNonZeroMinimum,
     ParenthesizedSubpattern,
-    FixedCountParenthesizedSubpattern,
     ExecutableMemoryAllocationFailure,
 };
 
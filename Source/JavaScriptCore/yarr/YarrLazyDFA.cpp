@@ -0,0 +1,761 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "YarrLazyDFA.h"
+
+#include "Options.h"
+#include "Yarr.h"
+#include <wtf/ASCIICType.h>
+#include <wtf/HashMap.h>
+#include <wtf/Vector.h>
+
+namespace JSC { namespace Yarr {
+
+// Large counted repetitions are unrolled, so bound the NFA and leave bigger patterns to the
+// backtracking engines.
+static const unsigned maximumNFASize = 4096;
+
+// Bounds the nesting of repetitions whose body can match the empty string, see BeginIteration.
+static const unsigned maximumIterationDepth = 7;
+
+enum class NFAOpcode : uint8_t {
+    Character,
+    CharacterClass,
+    AnyCharacter,
+    Split,
+    Jump,
+    AssertBOL,
+    AssertEOL,
+    AssertWordBoundary,
+    // Bracket the optional iterations of a group that can match the empty string. Such an iteration
+    // fails if it ends where it began, so the closure drops paths that pass from BeginIteration to
+    // the matching EndIteration without consuming anything.
+    BeginIteration,
+    EndIteration,
+    Match,
+};
+
+struct NFAInstruction {
+    NFAOpcode opcode;
+    bool invert { false };
+    UChar32 character { 0 };
+    UChar32 otherCaseCharacter { 0 };
+    const CharacterClass* characterClass { nullptr };
+    // Only used by BeginIteration and EndIteration, counting from 1 for the outermost iteration.
+    unsigned iterationDepth { 0 };
+    unsigned next { 0 };
+    // Only used by Split, which prefers next over alternate.
+    unsigned alternate { 0 };
+};
+
+// What the assertions need to know about the character on either side of a position.
+enum CharacterKind : uint8_t {
+    BoundaryKind, // Before the start or after the end of the subject string.
+    OtherCharacterKind,
+    WordCharacterKind,
+    LineTerminatorKind,
+};
+static const unsigned numberOfCharacterKinds = 4;
+
+static ALWAYS_INLINE CharacterKind characterKind(UChar32 character)
+{
+    if (isASCIIAlphanumeric(character) || character == '_')
+        return WordCharacterKind;
+    if (character == '\n' || character == '\r' || character == 0x2028 || character == 0x2029)
+        return LineTerminatorKind;
+    return OtherCharacterKind;
+}
+
+static bool characterClassMatches(const CharacterClass& characterClass, UChar32 character)
+{
+    if (characterClass.m_anyCharacter)
+        return true;
+
+    const Vector<UChar32>& matches = isASCII(character) ? characterClass.m_matches : characterClass.m_matchesUnicode;
+    if (std::binary_search(matches.begin(), matches.end(), character))
+        return true;
+
+    const Vector<CharacterRange>& ranges = isASCII(character) ? characterClass.m_ranges : characterClass.m_rangesUnicode;
+    auto range = std::upper_bound(ranges.begin(), ranges.end(), character, [] (UChar32 character, const CharacterRange& range) {
+        return character < range.begin;
+    });
+    return range != ranges.begin() && character <= (range - 1)->end;
+}
+
+static ALWAYS_INLINE bool instructionAccepts(const NFAInstruction& instruction, UChar32 character)
+{
+    switch (instruction.opcode) {
+    case NFAOpcode::Character:
+        return character == instruction.character || character == instruction.otherCaseCharacter;
+    case NFAOpcode::CharacterClass:
+        return characterClassMatches(*instruction.characterClass, character) != instruction.invert;
+    case NFAOpcode::AnyCharacter:
+        return true;
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+        return false;
+    }
+}
+
+struct LazyDFAState {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    bool isDead() const { return threads.isEmpty(); }
+
+    // The NFA instructions to resume from, highest priority first.
+    Vector<unsigned> threads;
+    // The kind of the character last consumed, which sits on the left of the current position in a
+    // forward scan and on its right in a reverse one.
+    CharacterKind kind;
+    // 0 while unknown, then 1 for no and 2 for yes. Indexed by the kind of character beyond the end.
+    uint8_t matchesAtEnd[numberOfCharacterKinds] { };
+    // Transitions are tagged with matchedBit when a match ends just before the consumed character.
+    std::unique_ptr<uintptr_t[]> asciiTransitions;
+    HashMap<UChar32, uintptr_t> otherTransitions;
+    LazyDFAState* nextInBucket { nullptr };
+};
+
+class LazyDFAAutomaton {
+    WTF_MAKE_FAST_ALLOCATED;
+    WTF_MAKE_NONCOPYABLE(LazyDFAAutomaton);
+public:
+    enum Direction { Forward, Reverse };
+
+    static std::unique_ptr<LazyDFAAutomaton> create(YarrPattern&, Direction);
+
+    LazyDFAAutomaton(Direction direction, bool multiline)
+        : m_reverse(direction == Reverse)
+        , m_multiline(multiline)
+    {
+    }
+
+    static const uintptr_t matchedBit = 1;
+    static LazyDFAState* stateForTransition(uintptr_t transition) { return bitwise_cast<LazyDFAState*>(transition & ~matchedBit); }
+
+    LazyDFAState* startState(CharacterKind);
+
+    ALWAYS_INLINE uintptr_t transition(LazyDFAState* state, UChar32 character)
+    {
+        if (isASCII(character)) {
+            if (state->asciiTransitions) {
+                if (uintptr_t transition = state->asciiTransitions[character])
+                    return transition;
+            }
+        } else {
+            auto iter = state->otherTransitions.find(character);
+            if (iter != state->otherTransitions.end())
+                return iter->value;
+        }
+        return computeTransition(state, character);
+    }
+
+    bool matchesAtEnd(LazyDFAState*, CharacterKind beyondEnd);
+
+    size_t estimatedSize() const;
+
+private:
+    friend class NFABuilder;
+
+    void finalizeProgram();
+    uintptr_t computeTransition(LazyDFAState*, UChar32 character);
+    bool step(const Vector<unsigned>& threads, CharacterKind previousKind, UChar32 character, CharacterKind nextKind);
+    LazyDFAState* findOrCreateState(const Vector<unsigned>& threads, CharacterKind);
+    void flush();
+
+    Vector<NFAInstruction> m_program;
+    Vector<std::unique_ptr<CharacterClass>> m_characterClasses;
+    bool m_reverse;
+    bool m_multiline;
+
+    Vector<std::unique_ptr<LazyDFAState>> m_states;
+    HashMap<unsigned, LazyDFAState*> m_stateTable;
+    LazyDFAState* m_startStates[numberOfCharacterKinds] { };
+    unsigned m_cacheGeneration { 0 };
+
+    unsigned m_maximumIterationDepth { 0 };
+
+    // Scratch space for step(). Closure entries pair a pc with the depth of the outermost iteration
+    // entered without consuming a character, or 0 if there is none.
+    Vector<std::pair<unsigned, unsigned>> m_stack;
+    Vector<unsigned> m_nextThreads;
+    Vector<unsigned> m_visited;
+    Vector<unsigned> m_queued;
+    unsigned m_visitStamp { 0 };
+};
+
+// Compiles a YarrPattern into a Thompson NFA. Alternatives and greedy quantifiers are Splits that
+// prefer the branch a backtracking engine would try first. The reverse NFA matches the mirror image
+// of the pattern and is only used to find the longest match, so priorities do not matter for it.
+class NFABuilder {
+public:
+    NFABuilder(YarrPattern& pattern, LazyDFAAutomaton& automaton)
+        : m_pattern(pattern)
+        , m_automaton(automaton)
+        , m_program(automaton.m_program)
+    {
+    }
+
+    bool compile()
+    {
+        if (!m_automaton.m_reverse && !m_pattern.sticky()) {
+            // Unanchored search, as if the pattern were /[^]*?(?:pattern)/: starting the pattern
+            // at an earlier position always takes priority over starting it later.
+            unsigned split = emit(NFAOpcode::Split);
+            unsigned any = emit(NFAOpcode::AnyCharacter);
+            m_program[any].next = split;
+            m_program[split].next = m_program.size();
+            m_program[split].alternate = any;
+        }
+
+        if (!compileDisjunction(m_pattern.m_body))
+            return false;
+        emit(NFAOpcode::Match);
+        return hasRoom();
+    }
+
+private:
+    bool hasRoom() const { return m_program.size() <= maximumNFASize; }
+
+    unsigned emit(NFAOpcode opcode)
+    {
+        NFAInstruction instruction;
+        instruction.opcode = opcode;
+        instruction.next = m_program.size() + 1;
+        m_program.append(instruction);
+        return m_program.size() - 1;
+    }
+
+    void setSplitTargets(unsigned split, unsigned body, unsigned exit, bool greedy)
+    {
+        m_program[split].next = greedy ? body : exit;
+        m_program[split].alternate = greedy ? exit : body;
+    }
+
+    const CharacterClass* characterClassFor(const CharacterClass* characterClass)
+    {
+        auto result = m_characterClasses.add(characterClass, nullptr);
+        if (result.isNewEntry) {
+            m_automaton.m_characterClasses.append(std::make_unique<CharacterClass>(*characterClass));
+            result.iterator->value = m_automaton.m_characterClasses.last().get();
+        }
+        return result.iterator->value;
+    }
+
+    bool compileDisjunction(PatternDisjunction* disjunction)
+    {
+        auto& alternatives = disjunction->m_alternatives;
+        if (alternatives.isEmpty())
+            return false;
+
+        Vector<unsigned> jumpsToEnd;
+        for (size_t i = 0; i < alternatives.size(); ++i) {
+            bool isLast = i == alternatives.size() - 1;
+            unsigned split = isLast ? 0 : emit(NFAOpcode::Split);
+            if (!compileAlternative(alternatives[i].get()) || !hasRoom())
+                return false;
+            if (!isLast) {
+                jumpsToEnd.append(emit(NFAOpcode::Jump));
+                setSplitTargets(split, split + 1, m_program.size(), true);
+            }
+        }
+        for (unsigned jump : jumpsToEnd)
+            m_program[jump].next = m_program.size();
+        return true;
+    }
+
+    bool compileAlternative(PatternAlternative* alternative)
+    {
+        auto& terms = alternative->m_terms;
+        for (size_t i = 0; i < terms.size(); ++i) {
+            if (!compileTerm(terms[m_automaton.m_reverse ? terms.size() - 1 - i : i]))
+                return false;
+        }
+        return true;
+    }
+
+    bool compileTerm(PatternTerm& term)
+    {
+        switch (term.type) {
+        case PatternTerm::TypeAssertionBOL:
+            emit(NFAOpcode::AssertBOL);
+            return true;
+        case PatternTerm::TypeAssertionEOL:
+            emit(NFAOpcode::AssertEOL);
+            return true;
+        case PatternTerm::TypeAssertionWordBoundary:
+            m_program[emit(NFAOpcode::AssertWordBoundary)].invert = term.invert();
+            return true;
+        case PatternTerm::TypeForwardReference:
+            // Refers to a group that has not matched yet, so it always matches the empty string.
+            return true;
+        case PatternTerm::TypePatternCharacter:
+        case PatternTerm::TypeCharacterClass:
+        case PatternTerm::TypeParenthesesSubpattern:
+            return compileQuantifiedAtom(term);
+        case PatternTerm::TypeBackReference:
+        case PatternTerm::TypeParentheticalAssertion:
+        case PatternTerm::TypeDotStarEnclosure:
+            return false;
+        }
+        RELEASE_ASSERT_NOT_REACHED();
+        return false;
+    }
+
+    bool compileQuantifiedAtom(PatternTerm& term)
+    {
+        unsigned minCount = term.quantityMinCount.unsafeGet();
+        unsigned maxCount = term.quantityMaxCount.unsafeGet();
+        bool greedy = term.quantityType != QuantifierNonGreedy;
+
+        for (unsigned i = 0; i < minCount; ++i) {
+            if (!compileAtom(term) || !hasRoom())
+                return false;
+        }
+
+        // Only the forward scan cares about priorities, which is all that empty iterations affect.
+        bool bracketIterations = !m_automaton.m_reverse && term.type == PatternTerm::TypeParenthesesSubpattern && canMatchEmpty(term.parentheses.disjunction);
+
+        if (maxCount == quantifyInfinite) {
+            unsigned loop = emit(NFAOpcode::Split);
+            if (!compileOptionalIteration(term, bracketIterations))
+                return false;
+            m_program[emit(NFAOpcode::Jump)].next = loop;
+            setSplitTargets(loop, loop + 1, m_program.size(), greedy);
+            return hasRoom();
+        }
+
+        Vector<unsigned> splits;
+        for (unsigned i = minCount; i < maxCount; ++i) {
+            splits.append(emit(NFAOpcode::Split));
+            if (!compileOptionalIteration(term, bracketIterations) || !hasRoom())
+                return false;
+        }
+        for (unsigned split : splits)
+            setSplitTargets(split, split + 1, m_program.size(), greedy);
+        return true;
+    }
+
+    bool compileOptionalIteration(PatternTerm& term, bool bracketIterations)
+    {
+        if (!bracketIterations)
+            return compileAtom(term);
+
+        if (++m_iterationDepth > maximumIterationDepth)
+            return false;
+        m_automaton.m_maximumIterationDepth = std::max(m_automaton.m_maximumIterationDepth, m_iterationDepth);
+        m_program[emit(NFAOpcode::BeginIteration)].iterationDepth = m_iterationDepth;
+        if (!compileAtom(term))
+            return false;
+        m_program[emit(NFAOpcode::EndIteration)].iterationDepth = m_iterationDepth;
+        --m_iterationDepth;
+        return true;
+    }
+
+    static bool canMatchEmpty(PatternDisjunction* disjunction)
+    {
+        for (auto& alternative : disjunction->m_alternatives) {
+            bool alternativeCanMatchEmpty = true;
+            for (auto& term : alternative->m_terms) {
+                if (!canMatchEmpty(term)) {
+                    alternativeCanMatchEmpty = false;
+                    break;
+                }
+            }
+            if (alternativeCanMatchEmpty)
+                return true;
+        }
+        return false;
+    }
+
+    static bool canMatchEmpty(PatternTerm& term)
+    {
+        switch (term.type) {
+        case PatternTerm::TypePatternCharacter:
+        case PatternTerm::TypeCharacterClass:
+            return !term.quantityMinCount;
+        case PatternTerm::TypeParenthesesSubpattern:
+            return !term.quantityMinCount || canMatchEmpty(term.parentheses.disjunction);
+        default:
+            return true;
+        }
+    }
+
+    bool compileAtom(PatternTerm& term)
+    {
+        switch (term.type) {
+        case PatternTerm::TypePatternCharacter: {
+            NFAInstruction& instruction = m_program[emit(NFAOpcode::Character)];
+            UChar32 character = term.patternCharacter;
+            instruction.character = character;
+            instruction.otherCaseCharacter = character;
+            // Non-unicode case-insensitive patterns turn every character with case variants into a
+            // character class, except ASCII ones, which may only match their ASCII counterpart.
+            if (m_pattern.ignoreCase() && isASCIIAlpha(character))
+                instruction.otherCaseCharacter = isASCIIUpper(character) ? toASCIILower(character) : toASCIIUpper(character);
+            return true;
+        }
+        case PatternTerm::TypeCharacterClass: {
+            const CharacterClass* characterClass = characterClassFor(term.characterClass);
+            NFAInstruction& instruction = m_program[emit(NFAOpcode::CharacterClass)];
+            instruction.characterClass = characterClass;
+            instruction.invert = term.invert();
+            return true;
+        }
+        case PatternTerm::TypeParenthesesSubpattern:
+            return compileDisjunction(term.parentheses.disjunction);
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+            return false;
+        }
+    }
+
+    YarrPattern& m_pattern;
+    LazyDFAAutomaton& m_automaton;
+    Vector<NFAInstruction>& m_program;
+    HashMap<const CharacterClass*, const CharacterClass*> m_characterClasses;
+    unsigned m_iterationDepth { 0 };
+};
+
+std::unique_ptr<LazyDFAAutomaton> LazyDFAAutomaton::create(YarrPattern& pattern, Direction direction)
+{
+    auto automaton = std::make_unique<LazyDFAAutomaton>(direction, pattern.multiline());
+    NFABuilder builder(pattern, *automaton);
+    if (!builder.compile())
+        return nullptr;
+    automaton->finalizeProgram();
+    return automaton;
+}
+
+void LazyDFAAutomaton::finalizeProgram()
+{
+    m_program.shrinkToFit();
+    m_visited.fill(0, m_program.size() * (m_maximumIterationDepth + 1));
+    m_queued.fill(0, m_program.size());
+}
+
+LazyDFAState* LazyDFAAutomaton::startState(CharacterKind kind)
+{
+    if (!m_startStates[kind]) {
+        Vector<unsigned> threads;
+        threads.append(0);
+        LazyDFAState* state = findOrCreateState(threads, kind);
+        m_startStates[kind] = state;
+    }
+    return m_startStates[kind];
+}
+
+// Follows every non-consuming instruction reachable from the threads at the current position, in
+// priority order, and collects the threads that survive consuming the given character into
+// m_nextThreads. A negative character stands for the end of the scan. Returns whether a match ends
+// at the current position.
+bool LazyDFAAutomaton::step(const Vector<unsigned>& threads, CharacterKind previousKind, UChar32 character, CharacterKind nextKind)
+{
+    CharacterKind leftKind = m_reverse ? nextKind : previousKind;
+    CharacterKind rightKind = m_reverse ? previousKind : nextKind;
+
+    if (!++m_visitStamp) {
+        m_visited.fill(0);
+        m_queued.fill(0);
+        m_visitStamp = 1;
+    }
+
+    m_nextThreads.shrink(0);
+    m_stack.shrink(0);
+    for (size_t i = threads.size(); i--;)
+        m_stack.append({ threads[i], 0 });
+
+    bool matched = false;
+    while (!m_stack.isEmpty()) {
+        unsigned pc;
+        unsigned freshDepth;
+        std::tie(pc, freshDepth) = m_stack.takeLast();
+        unsigned& visited = m_visited[pc * (m_maximumIterationDepth + 1) + freshDepth];
+        if (visited == m_visitStamp)
+            continue;
+        visited = m_visitStamp;
+
+        const NFAInstruction& instruction = m_program[pc];
+        switch (instruction.opcode) {
+        case NFAOpcode::Jump:
+            m_stack.append({ instruction.next, freshDepth });
+            break;
+        case NFAOpcode::Split:
+            m_stack.append({ instruction.alternate, freshDepth });
+            m_stack.append({ instruction.next, freshDepth });
+            break;
+        case NFAOpcode::AssertBOL:
+            if (leftKind == BoundaryKind || (m_multiline && leftKind == LineTerminatorKind))
+                m_stack.append({ instruction.next, freshDepth });
+            break;
+        case NFAOpcode::AssertEOL:
+            if (rightKind == BoundaryKind || (m_multiline && rightKind == LineTerminatorKind))
+                m_stack.append({ instruction.next, freshDepth });
+            break;
+        case NFAOpcode::AssertWordBoundary:
+            if (((leftKind == WordCharacterKind) != (rightKind == WordCharacterKind)) != instruction.invert)
+                m_stack.append({ instruction.next, freshDepth });
+            break;
+        case NFAOpcode::BeginIteration:
+            m_stack.append({ instruction.next, freshDepth ? freshDepth : instruction.iterationDepth });
+            break;
+        case NFAOpcode::EndIteration:
+            // Every iteration nested inside the outermost fresh one was entered after it, so this
+            // one is fresh too when it is at least as deep.
+            if (!freshDepth || instruction.iterationDepth < freshDepth)
+                m_stack.append({ instruction.next, freshDepth });
+            break;
+        case NFAOpcode::Match:
+            matched = true;
+            // A backtracking engine would have stopped at this match, so threads it would only have
+            // tried afterwards can never produce the result. The reverse scan wants the longest match
+            // instead and keeps them.
+            if (!m_reverse)
+                m_stack.shrink(0);
+            break;
+        case NFAOpcode::Character:
+        case NFAOpcode::CharacterClass:
+        case NFAOpcode::AnyCharacter:
+            // Consuming a character ends every fresh iteration, so the thread resumes with none.
+            if (character >= 0 && instructionAccepts(instruction, character) && m_queued[instruction.next] != m_visitStamp) {
+                m_queued[instruction.next] = m_visitStamp;
+                m_nextThreads.append(instruction.next);
+            }
+            break;
+        }
+    }
+    return matched;
+}
+
+uintptr_t LazyDFAAutomaton::computeTransition(LazyDFAState* state, UChar32 character)
+{
+    unsigned generation = m_cacheGeneration;
+    CharacterKind kind = characterKind(character);
+    bool matched = step(state->threads, state->kind, character, kind);
+    uintptr_t transition = bitwise_cast<uintptr_t>(findOrCreateState(m_nextThreads, kind)) | (matched ? matchedBit : 0);
+
+    // If creating the next state flushed the cache, the current state is gone.
+    if (generation != m_cacheGeneration)
+        return transition;
+
+    if (isASCII(character)) {
+        if (!state->asciiTransitions) {
+            state->asciiTransitions = std::make_unique<uintptr_t[]>(128);
+            std::fill(state->asciiTransitions.get(), state->asciiTransitions.get() + 128, 0);
+        }
+        state->asciiTransitions[character] = transition;
+    } else
+        state->otherTransitions.add(character, transition);
+    return transition;
+}
+
+bool LazyDFAAutomaton::matchesAtEnd(LazyDFAState* state, CharacterKind beyondEnd)
+{
+    uint8_t& cached = state->matchesAtEnd[beyondEnd];
+    if (!cached)
+        cached = step(state->threads, state->kind, -1, beyondEnd) ? 2 : 1;
+    return cached == 2;
+}
+
+LazyDFAState* LazyDFAAutomaton::findOrCreateState(const Vector<unsigned>& threads, CharacterKind kind)
+{
+    // Every dead state behaves the same.
+    if (threads.isEmpty())
+        kind = BoundaryKind;
+
+    unsigned hash = kind;
+    for (unsigned thread : threads)
+        hash = WTF::pairIntHash(hash, thread);
+    // Keep clear of the empty and deleted values of the hash table.
+    hash = hash % 0x7ffffffe + 1;
+
+    auto iter = m_stateTable.find(hash);
+    if (iter != m_stateTable.end()) {
+        for (LazyDFAState* state = iter->value; state; state = state->nextInBucket) {
+            if (state->kind == kind && state->threads == threads)
+                return state;
+        }
+    }
+
+    if (m_states.size() >= Options::maximumRegExpLazyDFAStates())
+        flush();
+
+    auto state = std::make_unique<LazyDFAState>();
+    state->threads = threads;
+    state->kind = kind;
+    auto result = m_stateTable.add(hash, state.get());
+    if (!result.isNewEntry) {
+        state->nextInBucket = result.iterator->value;
+        result.iterator->value = state.get();
+    }
+    m_states.append(WTFMove(state));
+    return m_states.last().get();
+}
+
+void LazyDFAAutomaton::flush()
+{
+    m_stateTable.clear();
+    m_states.clear();
+    for (auto& startState : m_startStates)
+        startState = nullptr;
+    ++m_cacheGeneration;
+}
+
+size_t LazyDFAAutomaton::estimatedSize() const
+{
+    size_t size = m_program.capacity() * sizeof(NFAInstruction) + m_characterClasses.size() * sizeof(CharacterClass);
+    for (auto& state : m_states) {
+        size += sizeof(LazyDFAState) + state->threads.capacity() * sizeof(unsigned);
+        if (state->asciiTransitions)
+            size += 128 * sizeof(uintptr_t);
+        size += state->otherTransitions.capacity() * sizeof(KeyValuePair<UChar32, uintptr_t>);
+    }
+    return size;
+}
+
+static bool containsRepetitionOrAlternation(PatternDisjunction* disjunction)
+{
+    if (disjunction->m_alternatives.size() > 1)
+        return true;
+    for (auto& alternative : disjunction->m_alternatives) {
+        for (PatternTerm& term : alternative->m_terms) {
+            if (term.quantityMaxCount.unsafeGet() > 1)
+                return true;
+            if (term.type == PatternTerm::TypeParenthesesSubpattern && containsRepetitionOrAlternation(term.parentheses.disjunction))
+                return true;
+        }
+    }
+    return false;
+}
+
+static bool containsQuantifiedGroupWithRepetitionOrAlternation(PatternDisjunction* disjunction)
+{
+    for (auto& alternative : disjunction->m_alternatives) {
+        for (PatternTerm& term : alternative->m_terms) {
+            if (term.type != PatternTerm::TypeParenthesesSubpattern)
+                continue;
+            if (term.quantityMaxCount.unsafeGet() > 1 && containsRepetitionOrAlternation(term.parentheses.disjunction))
+                return true;
+            if (containsQuantifiedGroupWithRepetitionOrAlternation(term.parentheses.disjunction))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool YarrLazyDFA::isBacktrackingProne(YarrPattern& pattern)
+{
+    return containsQuantifiedGroupWithRepetitionOrAlternation(pattern.m_body);
+}
+
+std::unique_ptr<YarrLazyDFA> YarrLazyDFA::create(YarrPattern& pattern)
+{
+    // In unicode mode a character may be a surrogate pair, which the automaton does not model.
+    if (pattern.unicode() || pattern.m_containsBackreferences)
+        return nullptr;
+
+    auto forward = LazyDFAAutomaton::create(pattern, LazyDFAAutomaton::Forward);
+    if (!forward)
+        return nullptr;
+    auto reverse = LazyDFAAutomaton::create(pattern, LazyDFAAutomaton::Reverse);
+    if (!reverse)
+        return nullptr;
+    return std::make_unique<YarrLazyDFA>(WTFMove(forward), WTFMove(reverse));
+}
+
+YarrLazyDFA::YarrLazyDFA(std::unique_ptr<LazyDFAAutomaton> forward, std::unique_ptr<LazyDFAAutomaton> reverse)
+    : m_forward(WTFMove(forward))
+    , m_reverse(WTFMove(reverse))
+{
+}
+
+YarrLazyDFA::~YarrLazyDFA()
+{
+}
+
+template<typename CharType>
+bool YarrLazyDFA::matchImpl(const CharType* characters, unsigned length, unsigned startOffset, MatchResult& result)
+{
+    // Find where the match a backtracking engine would pick ends.
+    unsigned matchEnd = offsetNoMatch;
+    LazyDFAState* state = m_forward->startState(startOffset ? characterKind(characters[startOffset - 1]) : BoundaryKind);
+    unsigned position = startOffset;
+    for (; position < length; ++position) {
+        uintptr_t transition = m_forward->transition(state, characters[position]);
+        if (transition & LazyDFAAutomaton::matchedBit)
+            matchEnd = position;
+        state = LazyDFAAutomaton::stateForTransition(transition);
+        if (state->isDead())
+            break;
+    }
+    if (position == length && m_forward->matchesAtEnd(state, BoundaryKind))
+        matchEnd = length;
+
+    if (matchEnd == offsetNoMatch) {
+        result = MatchResult::failed();
+        return true;
+    }
+
+    // No match starts before the one that ends at matchEnd, so its start is the furthest point back
+    // from which the pattern still matches up to matchEnd.
+    unsigned matchStart = offsetNoMatch;
+    state = m_reverse->startState(matchEnd < length ? characterKind(characters[matchEnd]) : BoundaryKind);
+    position = matchEnd;
+    for (; position > startOffset; --position) {
+        uintptr_t transition = m_reverse->transition(state, characters[position - 1]);
+        if (transition & LazyDFAAutomaton::matchedBit)
+            matchStart = position;
+        state = LazyDFAAutomaton::stateForTransition(transition);
+        if (state->isDead())
+            break;
+    }
+    if (position == startOffset && m_reverse->matchesAtEnd(state, startOffset ? characterKind(characters[startOffset - 1]) : BoundaryKind))
+        matchStart = startOffset;
+
+    ASSERT(matchStart != offsetNoMatch);
+    if (matchStart == offsetNoMatch)
+        return false;
+
+    result = MatchResult(matchStart, matchEnd);
+    return true;
+}
+
+bool YarrLazyDFA::match(const String& input, unsigned startOffset, MatchResult& result)
+{
+    if (startOffset > input.length()) {
+        result = MatchResult::failed();
+        return true;
+    }
+    if (input.is8Bit())
+        return matchImpl(input.characters8(), input.length(), startOffset, result);
+    return matchImpl(input.characters16(), input.length(), startOffset, result);
+}
+
+size_t YarrLazyDFA::estimatedSize() const
+{
+    return m_forward->estimatedSize() + m_reverse->estimatedSize();
+}
+
+} } // namespace JSC::Yarr
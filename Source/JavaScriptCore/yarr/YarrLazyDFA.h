@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "MatchResult.h"
+#include "YarrPattern.h"
+#include <wtf/Noncopyable.h>
+
+namespace JSC { namespace Yarr {
+
+class LazyDFAAutomaton;
+
+// A linear-time matcher for the patterns that a finite automaton can express: no backreferences, no
+// lookahead assertions and no unicode mode. The pattern is compiled into an NFA, and DFA states are
+// built lazily, one transition at a time, as the subject string is scanned. States live in a bounded
+// cache that is flushed when it fills up, so each character costs at most one NFA step and matching
+// never backtracks.
+//
+// A forward scan that gives threads the same priority a backtracking engine would finds where the
+// leftmost match ends, then a scan of the reversed pattern from that point finds where it starts.
+// Capture groups are not tracked; callers that need them re-run a backtracking engine from the
+// start that the DFA found.
+class YarrLazyDFA {
+    WTF_MAKE_FAST_ALLOCATED;
+    WTF_MAKE_NONCOPYABLE(YarrLazyDFA);
+public:
+    // Returns nullptr if the pattern uses a feature the DFA cannot express, or is too large.
+    static std::unique_ptr<YarrLazyDFA> create(YarrPattern&);
+
+    // Whether the pattern quantifies a group that itself contains quantifiers or alternatives, the
+    // shape that makes backtracking take exponential time on input that almost matches.
+    static bool isBacktrackingProne(YarrPattern&);
+
+    YarrLazyDFA(std::unique_ptr<LazyDFAAutomaton> forward, std::unique_ptr<LazyDFAAutomaton> reverse);
+    ~YarrLazyDFA();
+
+    // Returns false if the DFA could not decide, in which case the caller should use another engine.
+    bool match(const String&, unsigned startOffset, MatchResult&);
+
+    size_t estimatedSize() const;
+
+private:
+    template<typename CharType>
+    bool matchImpl(const CharType*, unsigned length, unsigned startOffset, MatchResult&);
+
+    std::unique_ptr<LazyDFAAutomaton> m_forward;
+    std::unique_ptr<LazyDFAAutomaton> m_reverse;
+};
+
+} } // namespace JSC::Yarr
@@ -1088,7 +1088,146 @@ public:
         }
     }
 
+    // This optimization finds the longest run of literal characters that every match contains
+    // at a fixed offset from its start, e.g. "foo" in /foo\d+/ or "=" in /\w\w=\d*/. The
+    // matchers then only try start positions at which that run occurs. We only consider
+    // looping expressions with a single alternative, and stop at the first term whose width
+    // is not known up front.
+    void setupRequiredLiteral()
+    {
+        if (!Options::useRegExpRequiredLiteralScan() || m_pattern.sticky())
+            return;
+
+        Vector<std::unique_ptr<PatternAlternative>>& alternatives = m_pattern.m_body->m_alternatives;
+        if (alternatives.size() != 1 || alternatives[0]->onceThrough())
+            return;
+
+        RequiredLiteralState state;
+        findRequiredLiteral(alternatives[0].get(), state);
+        state.endRun();
+
+        m_pattern.m_requiredLiteral = WTFMove(state.best);
+        m_pattern.m_requiredLiteralOffset = state.bestOffset;
+    }
+
 private:
+    struct RequiredLiteralState {
+        void endRun()
+        {
+            if (current.size() > best.size()) {
+                best = current;
+                bestOffset = currentOffset;
+            }
+            current.clear();
+        }
+
+        unsigned width { 0 };
+        Vector<UChar> current;
+        unsigned currentOffset { 0 };
+        Vector<UChar> best;
+        unsigned bestOffset { 0 };
+    };
+
+    static const unsigned maximumRequiredLiteralLength = 64;
+
+    bool isRequiredLiteralCharacter(UChar32 ch)
+    {
+        // Case-insensitive ASCII letters are matched as either case; other characters are
+        // only left as pattern characters if they have no other case.
+        if (!U_IS_BMP(ch) || U16_IS_SURROGATE(ch))
+            return false;
+        return !m_pattern.ignoreCase() || !isASCIIAlpha(ch);
+    }
+
+    // Returns false once a term of unknown width is reached.
+    bool findRequiredLiteral(PatternAlternative* alternative, RequiredLiteralState& state)
+    {
+        if (UNLIKELY(!isSafeToRecurse()))
+            return false;
+
+        for (PatternTerm& term : alternative->m_terms) {
+            switch (term.type) {
+            case PatternTerm::TypeAssertionBOL:
+            case PatternTerm::TypeAssertionEOL:
+            case PatternTerm::TypeAssertionWordBoundary:
+            case PatternTerm::TypeForwardReference:
+            case PatternTerm::TypeParentheticalAssertion:
+                // These do not consume input, so the run of literal characters may continue.
+                break;
+
+            case PatternTerm::TypePatternCharacter: {
+                unsigned count = term.quantityMinCount.unsafeGet();
+                if (isRequiredLiteralCharacter(term.patternCharacter)) {
+                    if (state.current.isEmpty())
+                        state.currentOffset = state.width;
+                    for (unsigned i = 0; i < count && state.current.size() < maximumRequiredLiteralLength; ++i)
+                        state.current.append(term.patternCharacter);
+                } else
+                    state.endRun();
+
+                Checked<unsigned, RecordOverflow> width = state.width;
+                width += Checked<unsigned, RecordOverflow>(count) * U16_LENGTH(term.patternCharacter);
+                if (width.hasOverflowed())
+                    return false;
+                state.width = width.unsafeGet();
+
+                if (term.quantityType != QuantifierFixedCount) {
+                    state.endRun();
+                    return false;
+                }
+                break;
+            }
+
+            case PatternTerm::TypeCharacterClass: {
+                state.endRun();
+                if (term.quantityType != QuantifierFixedCount)
+                    return false;
+                // Unicode patterns may match a character class against a surrogate pair.
+                if (m_pattern.unicode() && (term.invert() || term.characterClass->m_hasNonBMPCharacters))
+                    return false;
+                Checked<unsigned, RecordOverflow> width = state.width;
+                width += term.quantityMaxCount;
+                if (width.hasOverflowed())
+                    return false;
+                state.width = width.unsafeGet();
+                break;
+            }
+
+            case PatternTerm::TypeParenthesesSubpattern: {
+                if (term.quantityType != QuantifierFixedCount || term.quantityMaxCount != 1 || term.parentheses.isCopy)
+                    return false;
+                auto& nestedAlternatives = term.parentheses.disjunction->m_alternatives;
+                if (nestedAlternatives.size() == 1) {
+                    if (!findRequiredLiteral(nestedAlternatives[0].get(), state))
+                        return false;
+                    break;
+                }
+
+                // Several alternatives may still be skipped over if they all match the same number
+                // of characters, e.g. (a|b).
+                state.endRun();
+                unsigned size = nestedAlternatives[0]->m_minimumSize;
+                for (auto& nestedAlternative : nestedAlternatives) {
+                    if (!nestedAlternative->m_hasFixedSize || nestedAlternative->m_minimumSize != size)
+                        return false;
+                }
+                Checked<unsigned, RecordOverflow> width = state.width;
+                width += size;
+                if (width.hasOverflowed())
+                    return false;
+                state.width = width.unsafeGet();
+                break;
+            }
+
+            case PatternTerm::TypeBackReference:
+            case PatternTerm::TypeDotStarEnclosure:
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     bool isSafeToRecurse() const
     {
         if (!m_stackLimit)
@@ -1148,6 +1287,8 @@ ErrorCode YarrPattern::compile(const String& patternString, void* stackLimit)
             return error;
     }
 
+    constructor.setupRequiredLiteral();
+
     if (Options::dumpCompiledRegExpPatterns())
         dumpPattern(patternString);
 
@@ -1458,6 +1599,14 @@ void YarrPattern::dumpPattern(PrintStream& out, const String& patternString)
     out.print(":\n");
     if (m_body->m_callFrameSize)
         out.print("    callframe size: ", m_body->m_callFrameSize, "\n");
+    if (!m_requiredLiteral.isEmpty()) {
+        out.print("    required literal at offset ", m_requiredLiteralOffset, ":");
+        for (UChar ch : m_requiredLiteral) {
+            out.print(" ");
+            dumpUChar32(out, ch);
+        }
+        out.print("\n");
+    }
     m_body->dump(out, this);
 }
 
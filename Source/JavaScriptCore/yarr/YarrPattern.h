@@ -382,6 +382,8 @@ struct YarrPattern {
         m_userCharacterClasses.clear();
         m_captureGroupNames.shrink(0);
         m_namedForwardReferences.shrink(0);
+        m_requiredLiteral.clear();
+        m_requiredLiteralOffset = 0;
     }
 
     bool containsIllegalBackReference()
@@ -530,6 +532,11 @@ struct YarrPattern {
     Vector<String> m_namedForwardReferences;
     HashMap<String, unsigned> m_namedGroupToParenIndex;
 
+    // Characters that every match contains m_requiredLiteralOffset code units after its start,
+    // used by the matchers to skip start positions that cannot match. Empty if there are none.
+    Vector<UChar> m_requiredLiteral;
+    unsigned m_requiredLiteralOffset { 0 };
+
 private:
     ErrorCode compile(const String& patternString, void* stackLimit);
 
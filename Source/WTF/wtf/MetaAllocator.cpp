@@ -204,6 +204,9 @@ MetaAllocator::Statistics MetaAllocator::currentStatistics()
     result.bytesAllocated = m_bytesAllocated;
     result.bytesReserved = m_bytesReserved;
     result.bytesCommitted = m_bytesCommitted;
+    result.numberOfFreeChunks = m_freeSpaceStartAddressMap.size();
+    FreeSpaceNode* largestFreeChunk = m_freeSpaceSizeMap.last();
+    result.largestFreeChunkSize = largestFreeChunk ? largestFreeChunk->sizeInBytes() : 0;
     return result;
 }
 
@@ -85,6 +85,11 @@ public:
         size_t bytesAllocated;
         size_t bytesReserved;
         size_t bytesCommitted;
+
+        // The free space is split into this many chunks. Allocations larger than the
+        // largest one fail even when bytesReserved - bytesAllocated says there is room.
+        size_t numberOfFreeChunks;
+        size_t largestFreeChunkSize;
     };
     WTF_EXPORT_PRIVATE Statistics currentStatistics();
 
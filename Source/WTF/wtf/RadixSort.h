@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <string.h>
+#include <type_traits>
+#include <wtf/ParallelJobs.h>
+
+namespace WTF {
+
+namespace RadixSortInternal {
+
+static constexpr unsigned bitsPerPass = 8;
+static constexpr size_t numberOfBuckets = 1 << bitsPerPass;
+
+template<typename T, typename KeyFunction>
+struct Job {
+    const T* source;
+    T* destination;
+    size_t begin;
+    size_t end;
+    unsigned shift;
+    bool scatter;
+    const KeyFunction* keyOf;
+    size_t buckets[numberOfBuckets];
+};
+
+template<typename T, typename KeyFunction>
+void runJob(Job<T, KeyFunction>* job)
+{
+    const KeyFunction& keyOf = *job->keyOf;
+    unsigned shift = job->shift;
+    if (!job->scatter) {
+        std::fill(job->buckets, job->buckets + numberOfBuckets, 0);
+        for (size_t i = job->begin; i < job->end; ++i)
+            job->buckets[(keyOf(job->source[i]) >> shift) & (numberOfBuckets - 1)]++;
+        return;
+    }
+    for (size_t i = job->begin; i < job->end; ++i) {
+        const T& value = job->source[i];
+        job->destination[job->buckets[(keyOf(value) >> shift) & (numberOfBuckets - 1)]++] = value;
+    }
+}
+
+template<typename T, typename KeyFunction>
+bool parallelRadixSort(T* data, T* scratch, size_t size, const KeyFunction& keyOf, unsigned numberOfJobs)
+{
+    using Key = std::decay_t<decltype(keyOf(*data))>;
+
+    ParallelJobs<Job<T, KeyFunction>> parallelJobs(&runJob<T, KeyFunction>, numberOfJobs);
+    size_t jobs = parallelJobs.numberOfJobs();
+    if (jobs <= 1)
+        return false;
+
+    T* source = data;
+    T* destination = scratch;
+    for (unsigned shift = 0; shift < sizeof(Key) * 8; shift += bitsPerPass) {
+        for (size_t i = 0; i < jobs; ++i) {
+            auto& job = parallelJobs.parameter(i);
+            job.source = source;
+            job.destination = destination;
+            job.begin = size * i / jobs;
+            job.end = size * (i + 1) / jobs;
+            job.shift = shift;
+            job.scatter = false;
+            job.keyOf = &keyOf;
+        }
+        parallelJobs.execute();
+
+        // Turn the per-job counts into the offset at which each job writes its first element
+        // of each bucket, ordering buckets first and jobs second so that the pass stays stable.
+        size_t offset = 0;
+        bool allInOneBucket = false;
+        for (size_t bucket = 0; bucket < numberOfBuckets; ++bucket) {
+            size_t bucketBegin = offset;
+            for (size_t i = 0; i < jobs; ++i) {
+                auto& job = parallelJobs.parameter(i);
+                size_t count = job.buckets[bucket];
+                job.buckets[bucket] = offset;
+                offset += count;
+            }
+            if (offset - bucketBegin == size)
+                allInOneBucket = true;
+        }
+        if (allInOneBucket)
+            continue;
+
+        for (size_t i = 0; i < jobs; ++i)
+            parallelJobs.parameter(i).scatter = true;
+        parallelJobs.execute();
+        std::swap(source, destination);
+    }
+
+    if (source != data)
+        memcpy(data, source, size * sizeof(T));
+    return true;
+}
+
+} // namespace RadixSortInternal
+
+// Least-significant-digit radix sort. The elements are ordered by the unsigned integer key that
+// keyOf() returns for each of them, one byte of the key at a time, so sorting takes a fixed
+// number of linear passes instead of n log n comparisons. The sort is stable. {scratch} must have
+// room for {size} elements; the result always ends up in {data}.
+//
+// When numberOfJobs is greater than one, every pass is split between that many ParallelJobs: each
+// job counts the keys of its own slice, and then scatters that slice into the disjoint ranges of
+// the output that the counts reserve for it.
+template<typename T, typename KeyFunction>
+void radixSort(T* data, T* scratch, size_t size, const KeyFunction& keyOf, unsigned numberOfJobs = 1)
+{
+    using Key = std::decay_t<decltype(keyOf(*data))>;
+    static_assert(std::is_unsigned<Key>::value, "radix sort keys must be unsigned integers");
+    static_assert(std::is_trivially_copyable<T>::value, "radix sort moves elements with memcpy");
+    using namespace RadixSortInternal;
+
+    constexpr unsigned numberOfPasses = (sizeof(Key) * 8 + bitsPerPass - 1) / bitsPerPass;
+
+    if (!size)
+        return;
+
+    if (numberOfJobs > 1 && parallelRadixSort(data, scratch, size, keyOf, numberOfJobs))
+        return;
+
+    // Count every pass up front: where an element lands does not change which bucket its other
+    // bytes belong to, so one read of the input is enough.
+    size_t counts[numberOfPasses][numberOfBuckets] = { };
+    for (size_t i = 0; i < size; ++i) {
+        Key key = keyOf(data[i]);
+        for (unsigned pass = 0; pass < numberOfPasses; ++pass)
+            counts[pass][(key >> (pass * bitsPerPass)) & (numberOfBuckets - 1)]++;
+    }
+
+    T* source = data;
+    T* destination = scratch;
+    for (unsigned pass = 0; pass < numberOfPasses; ++pass) {
+        size_t* buckets = counts[pass];
+        unsigned shift = pass * bitsPerPass;
+
+        // A pass where every key has the same byte would just copy the elements.
+        if (buckets[(keyOf(data[0]) >> shift) & (numberOfBuckets - 1)] == size)
+            continue;
+
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < numberOfBuckets; ++bucket) {
+            size_t count = buckets[bucket];
+            buckets[bucket] = offset;
+            offset += count;
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+            const T& value = source[i];
+            destination[buckets[(keyOf(value) >> shift) & (numberOfBuckets - 1)]++] = value;
+        }
+        std::swap(source, destination);
+    }
+
+    if (source != data)
+        memcpy(data, source, size * sizeof(T));
+}
+
+} // namespace WTF
+
+using WTF::radixSort;
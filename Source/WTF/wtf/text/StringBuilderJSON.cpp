@@ -12,6 +12,7 @@
 #include "config.h"
 #include <wtf/text/StringBuilder.h>
 
+#include <wtf/UnalignedAccess.h>
 #include <wtf/text/WTFString.h>
 
 namespace WTF {
@@ -52,10 +53,45 @@ static const constexpr LChar escapedFormsForJSON[0x100] = {
     0,   0,   0,   0,   0,   0,   0,   0,
 };
 
+// Returns true if any character packed into the word is a control character, '"', '\\' or (for UChar) a
+// surrogate, i.e. anything escapedFormsForJSON or the surrogate handling below would not copy verbatim.
+template<typename CharacterType>
+ALWAYS_INLINE static bool wordMayNeedJSONEscaping(uint64_t word)
+{
+    constexpr uint64_t ones = std::numeric_limits<uint64_t>::max() / std::numeric_limits<CharacterType>::max();
+    constexpr uint64_t highBits = ones << (8 * sizeof(CharacterType) - 1);
+    auto hasLaneLessThan = [&] (uint64_t word, CharacterType value) {
+        return (word - ones * value) & ~word & highBits;
+    };
+    auto hasLaneEqualTo = [&] (uint64_t word, CharacterType value) {
+        return hasLaneLessThan(word ^ (ones * value), 1);
+    };
+
+    uint64_t result = hasLaneLessThan(word, ' ') | hasLaneEqualTo(word, '"') | hasLaneEqualTo(word, '\\');
+    if (sizeof(CharacterType) == 2)
+        result |= hasLaneEqualTo(word & (ones * 0xF800), 0xD800);
+    return result;
+}
+
 template<typename OutputCharacterType, typename InputCharacterType>
 ALWAYS_INLINE static void appendQuotedJSONStringInternal(OutputCharacterType*& output, const InputCharacterType* input, unsigned length)
 {
     for (auto* end = input + length; input != end; ++input) {
+        if (sizeof(OutputCharacterType) == sizeof(InputCharacterType)) {
+            // Copy runs that need no escaping a word at a time.
+            constexpr unsigned charactersPerWord = sizeof(uint64_t) / sizeof(InputCharacterType);
+            while (static_cast<size_t>(end - input) >= charactersPerWord) {
+                uint64_t word = unalignedLoad<uint64_t>(input);
+                if (wordMayNeedJSONEscaping<InputCharacterType>(word))
+                    break;
+                unalignedStore<uint64_t>(output, word);
+                input += charactersPerWord;
+                output += charactersPerWord;
+            }
+            if (input == end)
+                break;
+        }
+
         auto character = *input;
         if (LIKELY(character <= 0xFF)) {
             auto escaped = escapedFormsForJSON[character];
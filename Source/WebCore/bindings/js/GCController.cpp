@@ -152,19 +152,17 @@ void GCController::dumpHeap()
 
     sanitizeStackForVM(&vm);
 
-    String jsonData;
     {
         DeferGCForAWhile deferGC(vm.heap); // Prevent concurrent GC from interfering with the full GC that the snapshot does.
 
         HeapSnapshotBuilder snapshotBuilder(vm.ensureHeapProfiler(), HeapSnapshotBuilder::SnapshotType::GCDebuggingSnapshot);
         snapshotBuilder.buildSnapshot();
 
-        jsonData = snapshotBuilder.json();
+        snapshotBuilder.writeJSON([&] (const CString& chunk) {
+            FileSystem::writeToFile(fileHandle, chunk.data(), chunk.length());
+        });
     }
 
-    CString utf8String = jsonData.utf8();
-
-    FileSystem::writeToFile(fileHandle, utf8String.data(), utf8String.length());
     FileSystem::closeFile(fileHandle);
     
     WTFLogAlways("Dumped GC heap to %s", tempFilePath.utf8().data());
@@ -53,6 +53,7 @@
 #include <JavaScriptCore/Microtask.h>
 #include <JavaScriptCore/PromiseDeferredTimer.h>
 #include <JavaScriptCore/StrongInlines.h>
+#include <JavaScriptCore/WasmStreamingCompiler.h>
 #include <JavaScriptCore/WebAssemblyPrototype.h>
 #include <wtf/Language.h>
 #include <wtf/MainThread.h>
@@ -351,20 +352,6 @@ JSC::JSObject* JSDOMWindowBase::moduleLoaderCreateImportMetaProperties(JSC::JSGl
 }
 
 #if ENABLE(WEBASSEMBLY)
-static Optional<Vector<uint8_t>> tryAllocate(JSC::ExecState* exec, JSC::JSPromiseDeferred* promise, const char* data, size_t byteSize)
-{
-    Vector<uint8_t> arrayBuffer;
-    if (!arrayBuffer.tryReserveCapacity(byteSize)) {
-        promise->reject(exec, createOutOfMemoryError(exec));
-        return WTF::nullopt;
-    }
-
-    arrayBuffer.grow(byteSize);
-    memcpy(arrayBuffer.data(), data, byteSize);
-
-    return arrayBuffer;
-}
-
 static bool isResponseCorrect(JSC::ExecState* exec, FetchResponse* inputResponse, JSC::JSPromiseDeferred* promise)
 {
     bool isResponseCorsSameOrigin = inputResponse->type() == ResourceResponse::Type::Basic || inputResponse->type() == ResourceResponse::Type::Cors || inputResponse->type() == ResourceResponse::Type::Default;
@@ -388,47 +375,52 @@ static bool isResponseCorrect(JSC::ExecState* exec, FetchResponse* inputResponse
     return true;
 }
 
-static void handleResponseOnStreamingAction(JSC::JSGlobalObject* globalObject, JSC::ExecState* exec, FetchResponse* inputResponse, JSC::JSPromiseDeferred* promise, Function<void(JSC::ExecState* exec, const char* data, size_t byteSize)>&& actionCallback)
+static void handleResponseOnStreamingAction(JSC::JSGlobalObject* globalObject, JSC::ExecState* exec, FetchResponse* inputResponse, JSC::JSPromiseDeferred* promise, Function<Ref<JSC::Wasm::StreamingCompiler>(JSC::ExecState*)>&& createCompiler)
 {
     if (!isResponseCorrect(exec, inputResponse, promise))
         return;
 
     if (inputResponse->isBodyReceivedByChunk()) {
-        inputResponse->consumeBodyReceivedByChunk([promise, callback = WTFMove(actionCallback), globalObject, data = SharedBuffer::create()] (auto&& result) mutable {
+        // Hand each chunk to the compiler as it arrives, so that we compile the module while it is still downloading.
+        inputResponse->consumeBodyReceivedByChunk([promise, globalObject, compiler = createCompiler(exec)] (auto&& result) mutable {
             ExecState* exec = globalObject->globalExec();
             if (result.hasException()) {
+                compiler->cancel();
                 promise->reject(exec, createTypeError(exec, result.exception().message()));
                 return;
             }
 
             if (auto chunk = result.returnValue())
-                data->append(reinterpret_cast<const char*>(chunk->data), chunk->size);
+                compiler->addBytes(chunk->data, chunk->size);
             else {
                 VM& vm = exec->vm();
                 JSLockHolder lock(vm);
 
-                callback(exec, data->data(), data->size());
+                compiler->finalize();
             }
         });
         return;
     }
 
+    auto compileBuffer = [&] (SharedBuffer& buffer) {
+        VM& vm = exec->vm();
+        JSLockHolder lock(vm);
+
+        auto compiler = createCompiler(exec);
+        compiler->addBytes(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size());
+        compiler->finalize();
+    };
+
     auto body = inputResponse->consumeBody();
     WTF::switchOn(body, [&] (Ref<FormData>& formData) {
         if (auto buffer = formData->asSharedBuffer()) {
-            VM& vm = exec->vm();
-            JSLockHolder lock(vm);
-
-            actionCallback(exec, buffer->data(), buffer->size());
+            compileBuffer(*buffer);
             return;
         }
         // FIXME: http://webkit.org/b/184886> Implement loading for the Blob type
         promise->reject(exec, createTypeError(exec, "Unexpected Response's Content-type"_s));
     }, [&] (Ref<SharedBuffer>& buffer) {
-        VM& vm = exec->vm();
-        JSLockHolder lock(vm);
-
-        actionCallback(exec, buffer->data(), buffer->size());
+        compileBuffer(buffer);
     }, [&] (std::nullptr_t&) {
         promise->reject(exec, createTypeError(exec, "Unexpected Response's Content-type"_s));
     });
@@ -444,9 +436,8 @@ void JSDOMWindowBase::compileStreaming(JSC::JSGlobalObject* globalObject, JSC::E
     ASSERT(vm.promiseDeferredTimer->hasDependancyInPendingPromise(promise, globalObject));
 
     if (auto inputResponse = JSFetchResponse::toWrapped(vm, source)) {
-        handleResponseOnStreamingAction(globalObject, exec, inputResponse, promise, [promise] (JSC::ExecState* exec, const char* data, size_t byteSize) mutable {
-            if (auto arrayBuffer = tryAllocate(exec, promise, data, byteSize))
-                JSC::WebAssemblyPrototype::webAssemblyModuleValidateAsync(exec, promise, WTFMove(*arrayBuffer));
+        handleResponseOnStreamingAction(globalObject, exec, inputResponse, promise, [promise] (JSC::ExecState* exec) {
+            return JSC::WebAssemblyPrototype::webAssemblyModuleCompileStreaming(exec, promise);
         });
     } else
         promise->reject(exec, createTypeError(exec, "first argument must be an Response or Promise for Response"_s));
@@ -463,9 +454,8 @@ void JSDOMWindowBase::instantiateStreaming(JSC::JSGlobalObject* globalObject, JS
     ASSERT(vm.promiseDeferredTimer->hasDependancyInPendingPromise(promise, importedObject));
 
     if (auto inputResponse = JSFetchResponse::toWrapped(vm, source)) {
-        handleResponseOnStreamingAction(globalObject, exec, inputResponse, promise, [promise, importedObject] (JSC::ExecState* exec, const char* data, size_t byteSize) mutable {
-            if (auto arrayBuffer = tryAllocate(exec, promise, data, byteSize))
-                JSC::WebAssemblyPrototype::webAssemblyModuleInstantinateAsync(exec, promise, WTFMove(*arrayBuffer), importedObject);
+        handleResponseOnStreamingAction(globalObject, exec, inputResponse, promise, [promise, importedObject] (JSC::ExecState* exec) {
+            return JSC::WebAssemblyPrototype::webAssemblyModuleInstantiateStreaming(exec, promise, importedObject);
         });
     } else
         promise->reject(exec, createTypeError(exec, "first argument must be an Response or Promise for Response"_s));
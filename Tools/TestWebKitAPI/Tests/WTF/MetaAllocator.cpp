@@ -954,6 +954,33 @@ TEST_F(MetaAllocatorTest, DemandAllocDontCoalescePageThenDoubleHeap)
     testDemandAllocDontCoalesce(pageSize(), defaultPagesInHeap, defaultPagesInHeap * pageSize());
 }
 
+TEST_F(MetaAllocatorTest, FragmentationStatistics)
+{
+    MetaAllocator::Statistics statistics = allocator->currentStatistics();
+    EXPECT_EQ(statistics.numberOfFreeChunks, 1u);
+    EXPECT_EQ(statistics.largestFreeChunkSize, defaultPagesInHeap * pageSize());
+
+    MetaAllocatorHandle* first = allocate(64);
+    MetaAllocatorHandle* second = allocate(64);
+    MetaAllocatorHandle* third = allocate(64);
+
+    // Freeing the middle allocation leaves a hole that cannot be coalesced.
+    free(second);
+    statistics = allocator->currentStatistics();
+    EXPECT_EQ(statistics.numberOfFreeChunks, 2u);
+    EXPECT_EQ(statistics.largestFreeChunkSize, defaultPagesInHeap * pageSize() - 3 * 64);
+
+    free(first);
+    statistics = allocator->currentStatistics();
+    EXPECT_EQ(statistics.numberOfFreeChunks, 2u);
+    EXPECT_EQ(statistics.largestFreeChunkSize, defaultPagesInHeap * pageSize() - 3 * 64);
+
+    free(third);
+    statistics = allocator->currentStatistics();
+    EXPECT_EQ(statistics.numberOfFreeChunks, 1u);
+    EXPECT_EQ(statistics.largestFreeChunkSize, defaultPagesInHeap * pageSize());
+}
+
 } // namespace TestWebKitAPI
 
 #if USE(POINTER_PROFILING)